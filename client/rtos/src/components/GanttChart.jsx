@@ -1,9 +1,123 @@
-import React from 'react'
+import React, { useMemo } from 'react'
+
+export const IDLE_TASK = -1
+export const CONTEXT_SWITCH_TASK = -2
+// Cycles extrapolated by steady-state detection: drawn as a fixed-width
+// break, since the CPU was busy there but no segments were recorded
+export const SKIPPED_TASK = -3
+
+// Decodes the RTGB binary Gantt written by exportGanttBinary().  The
+// three columns are Int32Array views over the response buffer, so
+// nothing is copied however long the schedule is.
+export const decodeGantt = (buffer) => {
+  const view = new DataView(buffer)
+  const magic = String.fromCharCode(
+    view.getUint8(0), view.getUint8(1), view.getUint8(2), view.getUint8(3),
+  )
+  if (magic !== 'RTGB') throw new Error('not an RTGB Gantt')
+  const version = view.getUint32(4, true)
+  if (version !== 1) throw new Error(`unsupported RTGB version ${version}`)
+
+  const count = view.getUint32(8, true)
+  const labelCount = view.getUint32(12, true)
+  const task = new Int32Array(buffer, 16, count)
+  const start = new Int32Array(buffer, 16 + 4 * count, count)
+  const end = new Int32Array(buffer, 16 + 8 * count, count)
+
+  const labels = new Map()
+  const utf8 = new TextDecoder()
+  let offset = 16 + 12 * count
+  for (let i = 0; i < labelCount; i++) {
+    const id = view.getInt32(offset, true)
+    const length = view.getUint32(offset + 4, true)
+    labels.set(id, utf8.decode(new Uint8Array(buffer, offset + 8, length)))
+    offset += 8 + Math.ceil(length / 4) * 4
+  }
+  return { task, start, end, labels }
+}
+
+// JSON results carry the same columns as plain arrays
+const fromJson = ({ task, start, end, labels }) => ({
+  task,
+  start,
+  end,
+  labels: new Map(Object.entries(labels ?? {}).map(([id, name]) => [Number(id), name])),
+})
+
+const labelOf = (gantt, id) => {
+  if (id === IDLE_TASK) return 'IDLE'
+  if (id === CONTEXT_SWITCH_TASK) return 'CS'
+  if (id === SKIPPED_TASK) return 'SKIP'
+  return gantt.labels.get(id) ?? String(id)
+}
+
+const colorOf = (id) => {
+  if (id === IDLE_TASK) return 'bg-gray-200 text-gray-500'
+  if (id === CONTEXT_SWITCH_TASK) return 'bg-gray-400 text-white'
+  if (id === SKIPPED_TASK) return 'border-x-2 border-dashed border-gray-400 bg-white text-gray-500'
+  const palette = [
+    'bg-sky-500', 'bg-emerald-500', 'bg-amber-500', 'bg-rose-500',
+    'bg-violet-500', 'bg-teal-500', 'bg-orange-500', 'bg-indigo-500',
+  ]
+  return `${palette[Math.abs(id) % palette.length]} text-white`
+}
+
+// `data` is either the ArrayBuffer from simulateGantt() or the
+// `gantt` object of a JSON result.
+const GanttChart = ({ data }) => {
+  const gantt = useMemo(() => {
+    if (!data) return null
+    return data instanceof ArrayBuffer ? decodeGantt(data) : fromJson(data)
+  }, [data])
+
+  if (!gantt || gantt.task.length === 0) {
+    return <div className="text-sm text-gray-500">No schedule yet</div>
+  }
+
+  const count = gantt.task.length
+  const origin = gantt.start[0]
+
+  // Segments are laid out end to end; a skipped stretch gets a fixed
+  // share of the bar instead of its length
+  let simulated = 0
+  for (let i = 0; i < count; i++) {
+    if (gantt.task[i] !== SKIPPED_TASK) simulated += gantt.end[i] - gantt.start[i]
+  }
+  const breakWidth = Math.max(1, simulated * 0.05)
+  const lengthOf = (i) =>
+    gantt.task[i] === SKIPPED_TASK ? breakWidth : gantt.end[i] - gantt.start[i]
+  let span = 0
+  for (let i = 0; i < count; i++) span += lengthOf(i)
+  span = Math.max(1, span)
+
+  const bars = []
+  let offset = 0
+  for (let i = 0; i < count; i++) {
+    const id = gantt.task[i]
+    const left = (offset / span) * 100
+    const width = (lengthOf(i) / span) * 100
+    offset += lengthOf(i)
+    bars.push(
+      <div
+        key={i}
+        className={`absolute inset-y-0 flex items-center justify-center overflow-hidden border-r border-white text-xs ${colorOf(id)}`}
+        style={{ left: `${left}%`, width: `${width}%` }}
+        title={`${labelOf(gantt, id)}: ${gantt.start[i]} - ${gantt.end[i]}`}
+      >
+        {width > 2 ? labelOf(gantt, id) : null}
+      </div>,
+    )
+  }
 
-const GanttChart = () => {
   return (
-    <div>GanttChart</div>
+    <div className="w-full">
+      <div className="relative h-10 w-full rounded bg-gray-100">{bars}</div>
+      <div className="mt-1 flex justify-between text-xs text-gray-500">
+        <span>{origin}</span>
+        <span>{gantt.end[count - 1]}</span>
+      </div>
+    </div>
   )
 }
 
-export default GanttChart
\ No newline at end of file
+export default GanttChart
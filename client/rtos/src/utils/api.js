@@ -0,0 +1,23 @@
+import axios from 'axios'
+
+const api = axios.create({
+  baseURL: import.meta.env.VITE_API_URL ?? 'http://localhost:5000/api',
+})
+
+// Full result: { policy, gantt, tasks, summary } (see JsonExporter.h)
+export const simulate = async (request) => {
+  const { data } = await api.post('/simulate', { ...request, format: 'json' })
+  return data
+}
+
+// Gantt only, as the compact RTGB binary; decode with decodeGantt()
+export const simulateGantt = async (request) => {
+  const { data } = await api.post(
+    '/simulate',
+    { ...request, format: 'binary' },
+    { responseType: 'arraybuffer' },
+  )
+  return data
+}
+
+export default api
@@ -0,0 +1,55 @@
+import { runCpp, TimeoutError } from '../utils/runCpp.js';
+
+const POLICIES = new Set([
+  'fcfs', 'rr', 'sjf', 'srtf', 'priority', 'priority-preemptive', 'mlq', 'rm', 'edf',
+]);
+const TRACE_LEVELS = new Set(['off', 'summary', 'event', 'tick']);
+const FORMATS      = new Set(['text', 'json', 'binary']);
+
+// Numeric options and the smallest value the scheduler accepts; a zero
+// quantum or a negative switch cost would never finish.
+const MINIMUMS = { quantum: 1, csPenalty: 0, aging: 0, horizon: 0 };
+
+// POST /api/simulate
+//   { policy, tasks: [{ id, name, arrivalTime, burstTime, priority, period, deadline }],
+//     quantum?, csPenalty?, aging?, feedback?, horizon?, trace?, gantt?, format?,
+//     session? }
+//
+// `session` (or an X-Session-Id header) pins a client's requests to
+// one scheduler worker, so editing a task re-simulates incrementally.
+//
+// format 'text' (default) answers { policy, output }; 'json' passes the
+// exporter's document through untouched and 'binary' the RTGB Gantt.
+export async function simulate(req, res) {
+  const { policy, tasks, session: bodySession, ...options } = req.body ?? {};
+  const session = bodySession ?? req.get('X-Session-Id');
+
+  if (!POLICIES.has(policy))
+    return res.status(400).json({ error: `unknown policy '${policy}'` });
+  if (!Array.isArray(tasks))
+    return res.status(400).json({ error: 'tasks must be an array' });
+  if (options.trace != null && !TRACE_LEVELS.has(options.trace))
+    return res.status(400).json({ error: `unknown trace level '${options.trace}'` });
+  if (session != null && (typeof session !== 'string' || session.length > 256))
+    return res.status(400).json({ error: 'session must be a string of at most 256 characters' });
+  if (options.format != null && !FORMATS.has(options.format))
+    return res.status(400).json({ error: `unknown format '${options.format}'` });
+  for (const [key, min] of Object.entries(MINIMUMS)) {
+    if (options[key] == null) continue;
+    const n = Number(options[key]);
+    if (!Number.isFinite(n) || Math.trunc(n) < min)
+      return res.status(400).json({ error: `${key} must be an integer >= ${min}` });
+  }
+
+  try {
+    const body = await runCpp({ policy, options, tasks, session });
+    switch (options.format) {
+      case 'json':   res.type('application/json').send(body); break;
+      case 'binary': res.type('application/octet-stream').send(body); break;
+      default:       res.json({ policy, output: body.toString('utf8') });
+    }
+  } catch (err) {
+    if (err instanceof TimeoutError) return res.status(504).json({ error: err.message });
+    res.status(422).json({ error: err.message });
+  }
+}
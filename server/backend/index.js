@@ -0,0 +1,19 @@
+import express from 'express';
+import cors from 'cors';
+import simulateRouter from './routes/simulate.js';
+import { getPool } from './utils/runCpp.js';
+
+const PORT = Number(process.env.PORT) || 5000;
+
+const app = express();
+app.use(cors());
+app.use(express.json({ limit: '10mb' }));
+
+app.use('/api/simulate', simulateRouter);
+
+// Start the scheduler workers now rather than on the first request
+getPool();
+
+app.listen(PORT, () => {
+  console.log(`RTOS simulator API listening on port ${PORT}`);
+});
@@ -0,0 +1,8 @@
+import { Router } from 'express';
+import { simulate } from '../controllers/schedulerController.js';
+
+const router = Router();
+
+router.post('/', simulate);
+
+export default router;
@@ -0,0 +1,178 @@
+import { spawn } from 'node:child_process';
+import os from 'node:os';
+import path from 'node:path';
+import { fileURLToPath } from 'node:url';
+
+// Pool of long-lived `scheduler --serve` workers.
+//
+// Each request and response is one frame: a little-endian uint32
+// payload length followed by the payload.  A worker answers its
+// requests in order, so each one keeps a FIFO of pending promises.
+// A request with a session key always goes to the same worker, whose
+// Session keeps the previous run for incremental edits and windows;
+// anything else goes to the least-loaded worker.  A request that
+// outlives its timeout kills its worker, which is respawned.
+
+const here = path.dirname(fileURLToPath(import.meta.url));
+
+const DEFAULT_BIN  = process.env.SCHEDULER_BIN ?? path.resolve(here, '../../build/scheduler');
+const DEFAULT_SIZE = Number(process.env.SCHEDULER_WORKERS) || Math.min(os.cpus().length, 4);
+const DEFAULT_TIMEOUT_MS = Number(process.env.SCHEDULER_TIMEOUT_MS) || 10_000;
+
+export class TimeoutError extends Error {}
+
+// FNV-1a over the UTF-16 code units: a stable worker for each key
+const hashKey = (key) => {
+  let h = 0x811c9dc5;
+  for (let i = 0; i < key.length; i++) {
+    h ^= key.charCodeAt(i);
+    h = Math.imul(h, 0x01000193);
+  }
+  return h >>> 0;
+};
+
+class Worker {
+  constructor(bin, timeoutMs, onExit) {
+    this.timeoutMs = timeoutMs;
+    this.pending = [];
+    this.buffer  = Buffer.alloc(0);
+    this.alive   = true;
+
+    this.proc = spawn(bin, ['--serve'], { stdio: ['pipe', 'pipe', 'inherit'] });
+    this.proc.stdout.on('data', (chunk) => this.onData(chunk));
+    // A write to a worker that just died fails with EPIPE; reject what
+    // is pending and let the exit handler respawn it
+    this.proc.stdin.on('error', (err) => this.fail(err));
+    this.proc.on('error', (err) => this.fail(err));
+    this.proc.on('exit', (code, signal) => {
+      this.fail(new Error(`scheduler worker exited (${signal ?? code})`));
+      onExit(this);
+    });
+  }
+
+  get load() {
+    return this.pending.length;
+  }
+
+  send(payload) {
+    return new Promise((resolve, reject) => {
+      if (!this.alive) return reject(new Error('scheduler worker is not running'));
+      const body   = Buffer.from(payload, 'utf8');
+      const header = Buffer.allocUnsafe(4);
+      header.writeUInt32LE(body.length, 0);
+      const entry = { resolve, reject };
+      entry.timer = setTimeout(() => this.expire(entry), this.timeoutMs);
+      this.pending.push(entry);
+      this.proc.stdin.write(Buffer.concat([header, body]));
+    });
+  }
+
+  onData(chunk) {
+    this.buffer = this.buffer.length ? Buffer.concat([this.buffer, chunk]) : chunk;
+    while (this.buffer.length >= 4) {
+      const len = this.buffer.readUInt32LE(0);
+      if (this.buffer.length < 4 + len) break;
+      const frame = this.buffer.subarray(4, 4 + len);
+      this.buffer = this.buffer.subarray(4 + len);
+      const p = this.pending.shift();
+      if (!p) continue;
+      clearTimeout(p.timer);
+      p.resolve(frame);
+    }
+  }
+
+  // The worker is stuck on (or behind) this request: fail it and
+  // kill the process; the exit handler rejects the rest and respawns.
+  expire(entry) {
+    const i = this.pending.indexOf(entry);
+    if (i === -1) return;
+    this.pending.splice(i, 1);
+    entry.reject(new TimeoutError(`scheduler timed out after ${this.timeoutMs} ms`));
+    this.kill();
+  }
+
+  fail(err) {
+    this.alive = false;
+    for (const p of this.pending.splice(0)) {
+      clearTimeout(p.timer);
+      p.reject(err);
+    }
+  }
+
+  kill() {
+    this.alive = false;
+    this.proc.kill();
+  }
+}
+
+export class WorkerPool {
+  constructor({ bin = DEFAULT_BIN, size = DEFAULT_SIZE, timeoutMs = DEFAULT_TIMEOUT_MS } = {}) {
+    this.bin       = bin;
+    this.timeoutMs = timeoutMs;
+    this.closed  = false;
+    this.workers = Array.from({ length: size }, () => this.spawnWorker());
+  }
+
+  spawnWorker() {
+    return new Worker(this.bin, this.timeoutMs, (dead) => {
+      // Replace crashed workers; in-flight requests were rejected
+      if (this.closed) return;
+      const i = this.workers.indexOf(dead);
+      if (i !== -1) this.workers[i] = this.spawnWorker();
+    });
+  }
+
+  run(payload, key) {
+    if (key != null) return this.workers[hashKey(String(key)) % this.workers.length].send(payload);
+    let best = this.workers[0];
+    for (const w of this.workers) if (w.load < best.load) best = w;
+    return best.send(payload);
+  }
+
+  close() {
+    this.closed = true;
+    for (const w of this.workers) w.kill();
+  }
+}
+
+let pool = null;
+
+export function getPool() {
+  pool ??= new WorkerPool();
+  return pool;
+}
+
+const int = (v) => Math.trunc(Number(v) || 0);
+
+// { policy, options, tasks } -> request payload for the worker
+export function buildRequest({ policy, options = {}, tasks = [] }) {
+  const args = [policy, '--trace', options.trace ?? 'off'];
+  if (options.quantum   != null) args.push('--quantum', int(options.quantum));
+  if (options.csPenalty != null) args.push('--cs', int(options.csPenalty));
+  if (options.aging     != null) args.push('--aging', int(options.aging));
+  if (options.horizon   != null) args.push('--horizon', int(options.horizon));
+  if (options.feedback)          args.push('--feedback');
+  if (options.gantt === false)   args.push('--no-gantt');
+  if (options.format)            args.push('--format', options.format);
+
+  const lines = [args.join(' ')];
+  for (const t of tasks) {
+    const name = String(t.name ?? `T${int(t.id)}`).replace(/[\s#]+/g, '_') || '_';
+    lines.push([int(t.id), name, int(t.arrivalTime), int(t.burstTime),
+                int(t.priority), int(t.period), int(t.deadline)].join(' '));
+  }
+  return lines.join('\n') + '\n';
+}
+
+// Runs one simulation and resolves to the response body as a Buffer:
+// the text report, a JSON document or a binary Gantt, depending on
+// `options.format`.  Requests sharing `request.session` run on one
+// worker, so an edit can reuse the run before it.
+export async function runCpp(request) {
+  const response = await getPool().run(buildRequest(request), request.session);
+  const nl     = response.indexOf(0x0a);
+  const status = response.toString('utf8', 0, nl === -1 ? response.length : nl);
+  const body   = nl === -1 ? Buffer.alloc(0) : response.subarray(nl + 1);
+  if (status !== 'ok') throw new Error(body.toString('utf8').trim() || 'scheduler failed');
+  return body;
+}
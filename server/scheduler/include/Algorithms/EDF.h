@@ -1,7 +1,20 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
 #include <iostream>
 #include <vector>
+#include <utility>
 #include <queue>
 #include <iomanip>
+#include <unordered_map>
+#include "Task.h"
+#include "TCB.h"
+#include "Clock.h"
+#include "Instrument.h"
+#include "ReleaseCalendar.h"
+#include "Scheduler.h"
+#include "SegmentTrace.h"
+#include "Trace.h"
 using namespace std;
 
 /*
@@ -9,114 +22,497 @@ using namespace std;
     Earliest Deadline First (EDF) Scheduler Simulation
 */
 
-struct Task {
-    int id;
-    int period;             // Task period
-    int execution_time;     // WCET (Worst Case Execution Time)
-    int relative_deadline;  // Deadline relative to release time
-};
+/*
+    Tasks are periodic and released synchronously at t = 0:
+        period            -> Task period
+        burstTime         -> WCET (Worst Case Execution Time)
+        relativeDeadline  -> Deadline relative to release time
+    Each release becomes a TCB (job) in the ready queue.
 
-struct Job {
-    int task_id;
-    int release_time;
-    int absolute_deadline;
-    int remaining_time;
-    int job_number;
+    Steady state (enableSteadyState): at every hyperperiod boundary
+    all tasks release together, so the calendar is the same at each
+    one and the pending backlog alone decides the rest of the run.
+    The backlog, with times taken relative to the boundary, and the
+    task that ran last are hashed; when a boundary repeats an
+    earlier one, the schedule between them repeats until the
+    horizon.  Misses, busy time, context switches and job
+    statistics are then added once per remaining cycle, the
+    clock jumps ahead by whole cycles, and only the last partial
+    cycle is simulated.  A horizon of many hyperperiods costs about
+    two of them (one when the first repeat is the boundary before).
+    The trace marks the jump with one kSkippedTask segment.
 
-    bool operator>(const Job& other) const {
-        return absolute_deadline > other.absolute_deadline;
+    Checkpoints (recordCheckpoints): every `interval` ticks the run
+    saves the clock and the pending jobs.  Releases are synchronous
+    and periodic, so the calendar follows from the clock, and
+    restore() can resume any checkpoint with runUntil() (see
+    Timeline.h).
+*/
+
+// Ties on the deadline are broken by release time, then task id,
+// so runs are deterministic regardless of heap layout.
+struct LaterDeadline {
+    bool operator()(const TCB& a, const TCB& b) const {
+        if (a.deadline != b.deadline)
+            return a.deadline > b.deadline;
+        if (a.release != b.release)
+            return a.release > b.release;
+        return a.taskId > b.taskId;
     }
 };
 
+// The ready queue, with its heap readable for steady-state snapshots
+class EDFReadyQueue : public priority_queue<TCB, vector<TCB>, LaterDeadline> {
+public:
+    vector<TCB>&       jobs()       { return c; }
+    const vector<TCB>& jobs() const { return c; }
+};
+
 class EDFScheduler {
 private:
     vector<Task> tasks;
-    priority_queue<Job, vector<Job>, greater<Job>> ready_queue;
-    int hyperperiod;
+    EDFReadyQueue ready_queue;
+    ReleaseCalendar calendar;   // Next release of every task
+    SegmentTrace execution_trace;
+    int hyperperiod;   // End of the run
     int current_time;
     int deadline_misses;
+    long long busy_time;
+    int context_switches = 0;     // Dispatches of a task other than the last one
+    int last_task = -1;           // Task index of the last dispatch
+    vector<JobStats> job_stats;   // Per task
+
+    // ── Steady-state detection ──
+    struct Boundary {
+        Tick        time;
+        int         lastTask;  // Decides whether the next dispatch switches
+        vector<TCB> backlog;   // Relative to `time`, in canonical order
+    };
+    struct Snapshot {
+        Tick             time = 0;
+        int              misses = 0;
+        long long        busy = 0;
+        int              switches = 0;
+        vector<JobStats> stats;
+    };
+    static constexpr size_t kMaxBoundaries  = 1024;
+    static constexpr size_t kMaxBoundaryJobs = size_t(1) << 20;
+
+    Tick boundary_step = 0;           // Hyperperiod, 0 = detection off
+    Tick next_boundary = kNever;
+    vector<Boundary> boundaries;
+    size_t boundary_jobs = 0;
+    unordered_multimap<uint64_t, size_t> boundary_index;   // Backlog hash
+    Snapshot last_boundary;           // Counters at the previous boundary
+    Snapshot cycle_start;             // Counters where a pending cycle began
+    Tick cycle_length = 0;            // Found, waiting for one more cycle
+    SteadyState steady;
+
+    bool keep_trace = true;
+    Tick checkpoint_interval = 0;
+    Tick next_checkpoint = kNever;
+    vector<Checkpoint>* checkpoints = nullptr;
 
 public:
     EDFScheduler(vector<Task> t, int sim_time)
-        : tasks(t), hyperperiod(sim_time), current_time(0), deadline_misses(0) {}
+        : tasks(std::move(t)), hyperperiod(sim_time), current_time(0), deadline_misses(0),
+          busy_time(0), job_stats(tasks.size()) {
+        calendar.reserve(tasks.size());
+        for (int i = 0; i < (int)tasks.size(); i++)
+            calendar.schedule(0, i);
+    }
+
+    // `period` is the hyperperiod of the task set; a run over more
+    // than one of them stops simulating once the schedule repeats.
+    void enableSteadyState(Tick period) {
+        if (period <= 0) return;
+        boundary_step = period;
+        next_boundary = 0;
+    }
+
+    // Counters only: long checkpointing passes keep no Gantt trace.
+    void keepTrace(bool keep) { keep_trace = keep; }
+
+    void recordCheckpoints(Tick interval, vector<Checkpoint>* out) {
+        if (interval <= 0 || !out) return;
+        checkpoint_interval = interval;
+        next_checkpoint = current_time;
+        checkpoints = out;
+    }
+
+    // Resumes at `cp`; counters and the trace start again from zero.
+    void restore(const Checkpoint& cp) {
+        current_time = cp.time;
+        ready_queue = EDFReadyQueue();
+        for (const TCB& job : cp.backlog) ready_queue.push(job);
+        calendar = ReleaseCalendar();
+        calendar.reserve(tasks.size());
+        for (int i = 0; i < (int)tasks.size(); i++) {
+            long long period = tasks[i].period;
+            long long next = ((long long)cp.time + period - 1) / period * period;
+            if (next < kNever) calendar.schedule((Tick)next, i);
+        }
+        clearCounters();
+        last_task = -1;
+        next_boundary = kNever;
+        steady = SteadyState{};
+    }
+
+    // Starts the trace and the counters again from the current tick.
+    void clearCounters() {
+        execution_trace.clear();
+        deadline_misses = 0;
+        busy_time = 0;
+        context_switches = 0;
+        fill(job_stats.begin(), job_stats.end(), JobStats{});
+    }
+
+    Tick now() const { return current_time; }
+    const SegmentTrace& executionTrace() const { return execution_trace; }
+    // Move the trace, the job counters and the tasks out once the run
+    // is over.
+    SegmentTrace takeTrace() { return std::move(execution_trace); }
+    vector<JobStats> takeJobStats() { return std::move(job_stats); }
+    vector<Task> takeTasks() { return std::move(tasks); }
+    int deadlineMisses() const { return deadline_misses; }
+    long long busyTime() const { return busy_time; }
+    int contextSwitches() const { return context_switches; }
+    const vector<JobStats>& jobStats() const { return job_stats; }
+    const SteadyState& steadyState() const { return steady; }
 
     void releaseJobs() {
-        for (auto &task : tasks) {
-            if (current_time % task.period == 0) {
-                Job new_job;
-                new_job.task_id = task.id;
-                new_job.release_time = current_time;
-                new_job.absolute_deadline = current_time + task.relative_deadline;
-                new_job.remaining_time = task.execution_time;
-                new_job.job_number = current_time / task.period;
-
-                ready_queue.push(new_job);
-
-                cout << "Time " << current_time 
-                     << ": Task " << task.id 
-                     << " released (Deadline: " 
-                     << new_job.absolute_deadline << ")\n";
-            }
+        RTOS_PHASE(Phase::Release);
+        while (calendar.due(current_time)) {
+            ReleaseCalendar::Release release = calendar.pop();
+            RTOS_COUNT(Counter::Releases, 1);
+            const Task &task = tasks[release.task];
+
+            TCB new_job;
+            new_job.taskId = task.id;
+            new_job.taskIndex = release.task;
+            new_job.release = current_time;
+            new_job.deadline = current_time + task.relativeDeadline;
+            new_job.remaining = task.burstTime;
+            new_job.jobNumber = current_time / task.period;
+
+            pushReady(new_job);
+
+            RTOS_TRACE(TraceLevel::Event, TraceEvent::Release,
+                       current_time, task.id, new_job.deadline,
+                       "Time " << current_time 
+                       << ": Task " << task.id 
+                       << " released (Deadline: " 
+                       << new_job.deadline << ")\n");
+
+            long long next_release = (long long)current_time + task.period;
+            if (next_release < kNever)
+                calendar.schedule((int)next_release, release.task);
         }
     }
 
+    // The ready queue is ordered by absolute deadline, so every expired
+    // job sits at the top: pop only those k jobs, O(k log n), and never
+    // touch the rest of the heap.
     void checkDeadlineMisses() {
-        vector<Job> temp;
-        while (!ready_queue.empty()) {
-            Job job = ready_queue.top();
-            ready_queue.pop();
-
-            if (current_time >= job.absolute_deadline && job.remaining_time > 0) {
-                cout << "⚠ Deadline Missed! Task " 
-                     << job.task_id 
-                     << " at time " << current_time << "\n";
+        RTOS_PHASE(Phase::Deadline);
+        vector<TCB> no_work_left;
+        while (!ready_queue.empty() &&
+               ready_queue.top().deadline <= current_time) {
+            TCB job = popReady();
+
+            if (job.remaining > 0) {
+                RTOS_TRACE(TraceLevel::Event, TraceEvent::DeadlineMiss,
+                           current_time, job.taskId, job.deadline,
+                           "⚠ Deadline Missed! Task " 
+                           << job.taskId 
+                           << " at time " << current_time << "\n");
                 deadline_misses++;
+                JobStats& stats = job_stats[job.taskIndex];
+                stats.misses++;
+                stats.latency.drop(job.release, tasks[job.taskIndex].burstTime, job.remaining,
+                                   current_time, job.deadline);
+                RTOS_COUNT(Counter::DeadlineMisses, 1);
             } else {
-                temp.push_back(job);
+                no_work_left.push_back(job);
             }
         }
 
-        for (auto &job : temp)
-            ready_queue.push(job);
+        for (auto &job : no_work_left)
+            pushReady(job);
     }
 
     void run() {
-        cout << "===== EDF Scheduler Simulation =====\n\n";
+        RTOS_TRACE_TEXT(TraceLevel::Summary,
+                        "===== EDF Scheduler Simulation =====\n\n");
 
-        while (current_time < hyperperiod) {
+        runUntil(hyperperiod);
+
+        if (steady.cyclesSkipped > 0) {
+            RTOS_TRACE_TEXT(TraceLevel::Summary,
+                            "\nSteady state: ticks " << steady.cycleStart << "-"
+                            << steady.cycleStart + steady.cycleLength
+                            << " repeat; " << steady.cyclesSkipped
+                            << " cycles extrapolated\n");
+        }
+        RTOS_TRACE_TEXT(TraceLevel::Summary,
+                        "\n===== Simulation Complete =====\n"
+                        << "Total Deadline Misses: " 
+                        << deadline_misses << endl);
+    }
+
+    // Simulates up to `end` (at most the end of the run).  Stopping
+    // early changes nothing: a later call continues the same schedule.
+    void runUntil(Tick end) {
+        end = min(end, (Tick)hyperperiod);
+        int cut_short = -1;   // Task of a job stopped with work left
+        while (current_time < end) {
+
+            // A skip may move the clock to the horizon: test it again
+            if (current_time == next_boundary) {
+                atBoundary();
+                continue;
+            }
+            if (current_time >= next_checkpoint)
+                takeCheckpoint();
 
             releaseJobs();
             checkDeadlineMisses();
 
+            // Nothing changes until the next release, completion or deadline
+            EventHorizon horizon(end);
+            horizon.offer(calendar.nextTime());
+
             if (!ready_queue.empty()) {
-                Job current_job = ready_queue.top();
-                ready_queue.pop();
+                TCB current_job = popReady();
+                RTOS_COUNT(Counter::Dispatches, 1);
+                if (cut_short >= 0 && cut_short != current_job.taskIndex)
+                    RTOS_COUNT(Counter::Preemptions, 1);
+                cut_short = -1;
+                if (last_task >= 0 && last_task != current_job.taskIndex)
+                    context_switches++;
+                last_task = current_job.taskIndex;
 
-                cout << "Time " << current_time 
-                     << ": Running Task " 
-                     << current_job.task_id << "\n";
+                // First dispatch: nothing of the job has run yet
+                const Task& task = tasks[current_job.taskIndex];
+                if (current_job.remaining == task.burstTime)
+                    job_stats[current_job.taskIndex].latency.jitter.record(
+                        current_time - current_job.release);
 
-                current_job.remaining_time--;
+                horizon.offer(current_time + max(current_job.remaining, 1));
+                if (current_job.deadline > current_time)
+                    horizon.offer(current_job.deadline);
+                int next_time = horizon.next();
 
-                if (current_job.remaining_time > 0) {
-                    ready_queue.push(current_job);
+                current_job.remaining -= next_time - current_time;
+                if (keep_trace)
+                    execution_trace.extend(current_job.taskId, current_time, next_time);
+                busy_time += next_time - current_time;
+                bool completed = current_job.remaining <= 0;
+                if (completed) {
+                    RTOS_COUNT(Counter::Completions, 1);
+                    JobStats& stats = job_stats[current_job.taskIndex];
+                    Tick response = next_time - current_job.release;
+                    stats.jobs++;
+                    stats.totalResponse += response;
+                    stats.worstResponse = max(stats.worstResponse, response);
+                    stats.latency.complete(current_job.release, task.burstTime, next_time,
+                                           current_job.deadline);
+                }
+
+                // Per-tick lines exist only for Tick-level text traces;
+                // everyone else gets one record per segment.
+                if (ostream* os = trace::textAt(TraceLevel::Tick)) {
+                    RTOS_PHASE(Phase::Output);
+                    for (int t = current_time; t < next_time; t++) {
+                        *os << "Time " << t
+                            << ": Running Task "
+                            << current_job.taskId << "\n";
+
+                        if (t + 1 == next_time && completed) {
+                            *os << "Time " << t + 1
+                                << ": Task " << current_job.taskId
+                                << " completed\n";
+                        }
+                        *os << "---------------------------------\n";
+                    }
                 } else {
-                    cout << "Time " << current_time + 1 
-                         << ": Task " << current_job.task_id 
-                         << " completed\n";
+                    RTOS_TRACE_RECORD(TraceLevel::Event, TraceEvent::Run,
+                                      current_time, current_job.taskId, next_time);
+                    if (completed) {
+                        RTOS_TRACE(TraceLevel::Event, TraceEvent::Complete,
+                                   next_time, current_job.taskId, current_job.jobNumber,
+                                   "Time " << next_time
+                                   << ": Task " << current_job.taskId
+                                   << " completed\n");
+                    }
                 }
 
+                if (current_job.remaining > 0) {
+                    pushReady(current_job);
+                    cut_short = current_job.taskIndex;
+                }
+
+                current_time = next_time;
+
+            } else {
+                int next_time = horizon.next();
+                if (keep_trace)
+                    execution_trace.extend(kIdleTask, current_time, next_time);
+
+                if (ostream* os = trace::textAt(TraceLevel::Tick)) {
+                    RTOS_PHASE(Phase::Output);
+                    for (int t = current_time; t < next_time; t++) {
+                        *os << "Time " << t
+                            << ": CPU Idle\n";
+                        *os << "---------------------------------\n";
+                    }
+                } else {
+                    RTOS_TRACE_RECORD(TraceLevel::Event, TraceEvent::Idle,
+                                      current_time, -1, next_time);
+                }
+
+                current_time = next_time;
+            }
+        }
+    }
+
+private:
+    // Every ready-queue operation, timed as Phase::Queue
+    void pushReady(const TCB& job) {
+        RTOS_PHASE(Phase::Queue);
+        RTOS_COUNT(Counter::QueuePushes, 1);
+        ready_queue.push(job);
+    }
+
+    TCB popReady() {
+        RTOS_PHASE(Phase::Queue);
+        RTOS_COUNT(Counter::QueuePops, 1);
+        TCB job = ready_queue.top();
+        ready_queue.pop();
+        return job;
+    }
+
+    void takeCheckpoint() {
+        checkpoints->push_back(Checkpoint{current_time, ready_queue.jobs()});
+        long long next = (long long)current_time + checkpoint_interval;
+        next_checkpoint = next < kNever ? (Tick)next : kNever;
+    }
+
+    Snapshot snapshot() const {
+        return Snapshot{current_time, deadline_misses, busy_time, context_switches, job_stats};
+    }
+
+    static bool canonicalLess(const TCB& a, const TCB& b) {
+        if (a.taskIndex != b.taskIndex) return a.taskIndex < b.taskIndex;
+        if (a.release != b.release)     return a.release < b.release;
+        return a.remaining < b.remaining;
+    }
+
+    static bool sameJob(const TCB& a, const TCB& b) {
+        return a.taskIndex == b.taskIndex && a.release == b.release &&
+               a.deadline == b.deadline && a.remaining == b.remaining;
+    }
+
+    static uint64_t hashBacklog(const vector<TCB>& backlog) {
+        uint64_t h = 1469598103934665603ull;   // FNV-1a over the fields
+        auto mix = [&h](int64_t v) {
+            h ^= (uint64_t)v;
+            h *= 1099511628211ull;
+        };
+        for (const TCB& j : backlog) {
+            mix(j.taskIndex);
+            mix(j.release);
+            mix(j.deadline);
+            mix(j.remaining);
+        }
+        return h;
+    }
+
+    // Called before the releases of a hyperperiod boundary.
+    void atBoundary() {
+        long long following = (long long)current_time + boundary_step;
+        next_boundary = following < hyperperiod ? (Tick)following : kNever;
+
+        // A repeat was found earlier: this boundary closes one more
+        // cycle, which measured what each cycle adds
+        if (cycle_length > 0) {
+            if (current_time - cycle_start.time == cycle_length)
+                skipCycles(cycle_start, snapshot());
+            return;
+        }
+
+        Boundary here{current_time, last_task, ready_queue.jobs()};
+        for (TCB& j : here.backlog) {
+            j.release  -= current_time;
+            j.deadline -= current_time;
+            j.jobNumber = 0;
+        }
+        sort(here.backlog.begin(), here.backlog.end(), canonicalLess);
+        uint64_t hash = hashBacklog(here.backlog) ^ (uint64_t)(here.lastTask + 1);
+
+        auto range = boundary_index.equal_range(hash);
+        for (auto it = range.first; it != range.second; ++it) {
+            const Boundary& seen = boundaries[it->second];
+            if (seen.lastTask != here.lastTask ||
+                !equal(seen.backlog.begin(), seen.backlog.end(),
+                       here.backlog.begin(), here.backlog.end(), sameJob))
+                continue;
+            if (seen.time == last_boundary.time) {
+                skipCycles(last_boundary, snapshot());
             } else {
-                cout << "Time " << current_time 
-                     << ": CPU Idle\n";
+                cycle_length = current_time - seen.time;
+                cycle_start  = snapshot();
+                long long close = (long long)current_time + cycle_length;
+                next_boundary = close < hyperperiod ? (Tick)close : kNever;
             }
+            return;
+        }
 
-            current_time++;
-            cout << "---------------------------------\n";
+        boundary_jobs += here.backlog.size();
+        if (boundaries.size() == kMaxBoundaries || boundary_jobs > kMaxBoundaryJobs) {
+            next_boundary = kNever;   // Give up; simulate the rest
+            return;
         }
+        boundary_index.emplace(hash, boundaries.size());
+        boundaries.push_back(move(here));
+        last_boundary = snapshot();
+    }
 
-        cout << "\n===== Simulation Complete =====\n";
-        cout << "Total Deadline Misses: " 
-             << deadline_misses << endl;
+    // `from` and `to` are the counters at two boundaries with the same
+    // backlog; add their difference once per remaining whole cycle and
+    // move the pending jobs and releases forward by those cycles.
+    void skipCycles(const Snapshot& from, const Snapshot& to) {
+        next_boundary = kNever;
+        Tick length = to.time - from.time;
+        long long cycles = ((long long)hyperperiod - to.time) / length;
+        steady.cycleStart    = from.time;
+        steady.cycleLength   = length;
+        steady.cyclesSkipped = cycles;
+        if (cycles == 0) return;
+
+        deadline_misses += (int)(cycles * (to.misses - from.misses));
+        busy_time       += cycles * (to.busy - from.busy);
+        context_switches += (int)(cycles * (to.switches - from.switches));
+        for (size_t i = 0; i < job_stats.size(); i++) {
+            job_stats[i].jobs          += cycles * (to.stats[i].jobs - from.stats[i].jobs);
+            job_stats[i].misses        += cycles * (to.stats[i].misses - from.stats[i].misses);
+            job_stats[i].totalResponse += cycles * (to.stats[i].totalResponse -
+                                                    from.stats[i].totalResponse);
+            job_stats[i].latency.addDifference(to.stats[i].latency, from.stats[i].latency,
+                                               cycles);
+        }
+
+        // A uniform shift keeps both heaps in order
+        Tick shift = (Tick)(cycles * length);
+        if (keep_trace)
+            execution_trace.append(kSkippedTask, current_time, current_time + shift);
+        for (TCB& j : ready_queue.jobs()) {
+            j.release  += shift;
+            j.deadline += shift;
+        }
+        vector<ReleaseCalendar::Release> pending;
+        while (!calendar.empty()) pending.push_back(calendar.pop());
+        for (const auto& r : pending) calendar.schedule(r.time + shift, r.task);
+        current_time += shift;
     }
 };
@@ -1,20 +1,18 @@
 #pragma once
-#include "Common.h"          // ← gets Task + GanttEntry from here
+#include "Task.h"
+#include "Scheduler.h"         // ← ScheduleResult, printGantt / printMetrics
+#include "Clock.h"
+#include "Instrument.h"
+#include "SegmentTrace.h"
+#include "Trace.h"
 #include <vector>
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
 #include <sstream>
 
-// ── FCFS-specific result ──────────────────────────────────────
-struct FCFSResult {
-    std::vector<Task>       tasks;
-    std::vector<GanttEntry> gantt;
-    int totalClockTime   = 0;
-    int totalBusyTime    = 0;
-    int contextSwitches  = 0;
-    int deadlineMisses   = 0;
-};
+// ── FCFS result ───────────────────────────────────────────────
+using FCFSResult = ScheduleResult;
 
 // ── FCFS Scheduler ────────────────────────────────────────────
 class FCFSScheduler {
@@ -26,156 +24,135 @@ public:
     FCFSResult run(std::vector<Task> tasks) {
         FCFSResult result;
 
-        std::sort(tasks.begin(), tasks.end(),
-            [](const Task& a, const Task& b){
-                return a.arrivalTime < b.arrivalTime;
-            });
+        // Labels first, while the names are read in input order.
+        // Stable: tasks arriving together keep their input order.
+        labelTasks(result.gantt, tasks);
+        {
+            RTOS_PHASE(Phase::Release);
+            sortByArrival(tasks);
+        }
+        result.tasks = std::move(tasks);
 
-        int clock      = 0;
-        int prevTaskId = -1;
+        RTOS_TRACE_TEXT(TraceLevel::Summary,
+                  "\n+--------------------------------------------------+\n"
+                  << "|  FCFS Scheduler  (CS Penalty = "
+                  << csPenalty_ << " tick)           |\n"
+                  << "+--------------------------------------------------+\n");
 
-        std::cout << "\n+--------------------------------------------------+\n";
-        std::cout << "|  FCFS Scheduler  (CS Penalty = "
-                  << csPenalty_ << " tick)           |\n";
-        std::cout << "+--------------------------------------------------+\n";
+        resume(result, 0);
 
-        for (auto& t : tasks) {
+        RTOS_TRACE_TEXT(TraceLevel::Summary,
+                        "\n  FCFS done. Total clock = " << result.totalClockTime << " ticks.\n");
+        return result;
+    }
+
+    // Runs res.tasks (arrival order) from position `from` on.  `res`
+    // is empty or holds a whole earlier run of as many tasks: the tasks
+    // before `from` keep their results, the Gantt trace is cut after
+    // the last of them, and the rest are reset and run again, their
+    // old results taken off the counters (IncrementalScheduler).
+    void resume(FCFSResult& res, std::size_t from) const {
+        std::vector<Task>& tasks = res.tasks;
+
+        // A whole run leaves exactly one run segment per task
+        std::size_t keep = res.gantt.size();
+        std::size_t runs = res.gantt.empty() ? 0 : tasks.size();
+        while (keep > 0) {
+            const Segment& s = res.gantt[keep - 1];
+            if (s.task == kContextSwitchTask) {
+                --res.contextSwitches;
+            } else if (s.task != kIdleTask) {
+                if (runs <= from) break;
+                --runs;
+                res.totalBusyTime -= s.length();
+            }
+            --keep;
+        }
+        res.gantt.truncate(keep);
+
+        int clock      = from > 0 ? tasks[from - 1].completionTime : 0;
+        int prevTaskId = from > 0 ? tasks[from - 1].id : -1;
+
+        for (std::size_t i = from; i < tasks.size(); ++i) {
+            Task& t = tasks[i];
+            if (t.deadlineMissed) --res.deadlineMisses;
+            resetRunState(t);
+            RTOS_COUNT(Counter::Releases, 1);
 
             // Idle gap
             if (clock < t.arrivalTime) {
-                std::cout << "  [IDLE]  " << clock << " -> " << t.arrivalTime << "\n";
-                result.gantt.push_back({"IDLE", clock, t.arrivalTime});
+                RTOS_TRACE(TraceLevel::Event, TraceEvent::Idle, clock, -1, t.arrivalTime,
+                           "  [IDLE]  " << clock << " -> " << t.arrivalTime << "\n");
+                res.gantt.append(kIdleTask, clock, t.arrivalTime);
                 clock = t.arrivalTime;
             }
 
             // Context switch penalty
             if (prevTaskId != -1 && prevTaskId != t.id) {
                 int csEnd = clock + csPenalty_;
-                std::cout << "  [CS]    " << clock << " -> " << csEnd << "\n";
-                result.gantt.push_back({"CS", clock, csEnd});
+                RTOS_TRACE(TraceLevel::Event, TraceEvent::ContextSwitch, clock, t.id, csEnd,
+                           "  [CS]    " << clock << " -> " << csEnd << "\n");
+                res.gantt.append(kContextSwitchTask, clock, csEnd);
                 clock = csEnd;
-                ++result.contextSwitches;
+                ++res.contextSwitches;
             }
 
             t.startTime   = clock;
             int execStart = clock;
-
-            std::cout << "  [RUN]   " << t.name
-                      << "  start=" << clock
-                      << "  burst=" << t.burstTime
-                      << "  deadline=" << t.hardDeadline << "\n";
-
-            // Tick-by-tick execution with deadline check
-            for (int i = 0; i < t.burstTime; ++i) {
-                ++clock;
-                --t.remainingTime;
-                if (!t.deadlineMissed && clock > t.hardDeadline) {
+            RTOS_COUNT(Counter::Dispatches, 1);
+
+            RTOS_TRACE(TraceLevel::Event, TraceEvent::Dispatch, clock, t.id, t.burstTime,
+                       "  [RUN]   " << t.name
+                       << "  start=" << clock
+                       << "  burst=" << t.burstTime
+                       << "  deadline=" << t.hardDeadline << "\n");
+
+            // Jump to completion; the violation tick is computed, not stepped
+            // (hardDeadline <= 0 means the task has no deadline)
+            {
+                RTOS_PHASE(Phase::Deadline);
+                Tick violation = t.hardDeadline > 0
+                    ? firstDeadlineViolation(clock, t.burstTime, t.hardDeadline)
+                    : kNever;
+                if (!t.deadlineMissed && violation != kNever) {
                     t.deadlineMissed = true;
-                    std::cout << "  !! DEADLINE VIOLATION  " << t.name
-                              << "  clock=" << clock
-                              << "  deadline=" << t.hardDeadline << "\n";
+                    RTOS_COUNT(Counter::DeadlineMisses, 1);
+                    RTOS_TRACE(TraceLevel::Event, TraceEvent::DeadlineMiss, violation, t.id, t.hardDeadline,
+                               "  !! DEADLINE VIOLATION  " << t.name
+                               << "  clock=" << violation
+                               << "  deadline=" << t.hardDeadline << "\n");
                 }
             }
+            if (t.burstTime > 0) {
+                clock            += t.burstTime;
+                t.remainingTime  -= t.burstTime;
+            }
 
-            result.gantt.push_back({t.name, execStart, clock});
-            result.totalBusyTime += t.burstTime;
+            res.gantt.append(t.id, execStart, clock);
+            res.totalBusyTime += t.burstTime;
 
             t.completionTime = clock;
+            t.completed      = true;
+            RTOS_COUNT(Counter::Completions, 1);
             t.turnaroundTime = t.completionTime - t.arrivalTime;
             t.waitingTime    = t.turnaroundTime - t.burstTime;
-            if (t.deadlineMissed) ++result.deadlineMisses;
+            if (t.deadlineMissed) ++res.deadlineMisses;
 
-            std::cout << "  [DONE]  " << t.name
-                      << "  completion=" << t.completionTime
-                      << "  TAT=" << t.turnaroundTime
-                      << "  WT=" << t.waitingTime
-                      << (t.deadlineMissed ? "  !! MISSED" : "  OK") << "\n";
+            RTOS_TRACE(TraceLevel::Event, TraceEvent::Complete, clock, t.id, t.turnaroundTime,
+                       "  [DONE]  " << t.name
+                       << "  completion=" << t.completionTime
+                       << "  TAT=" << t.turnaroundTime
+                       << "  WT=" << t.waitingTime
+                       << (t.deadlineMissed ? "  !! MISSED" : "  OK") << "\n");
 
             prevTaskId = t.id;
         }
 
-        result.tasks          = tasks;
-        result.totalClockTime = clock;
-        std::cout << "\n  FCFS done. Total clock = " << clock << " ticks.\n";
-        return result;
-    }
-
-    static void printGantt(const FCFSResult& res) {
-        std::cout << "\n  Gantt Chart [FCFS]\n  ";
-        for (const auto& e : res.gantt) {
-            int w = (e.end - e.start) * 4;
-            for (int i = 0; i < w; ++i) std::cout << '-';
-            std::cout << '+';
-        }
-        std::cout << "\n  |";
-        for (const auto& e : res.gantt) {
-            int w    = (e.end - e.start) * 4 - 1;
-            int lLen = (int)e.label.size();
-            int padL = (w - lLen) / 2;
-            int padR = w - lLen - padL;
-            for (int i = 0; i < padL; ++i) std::cout << ' ';
-            std::cout << e.label;
-            for (int i = 0; i < padR; ++i) std::cout << ' ';
-            std::cout << '|';
-        }
-        std::cout << "\n  ";
-        for (const auto& e : res.gantt) {
-            int w = (e.end - e.start) * 4;
-            for (int i = 0; i < w; ++i) std::cout << '-';
-            std::cout << '+';
-        }
-        std::cout << "\n  ";
-        int prev = -1;
-        for (const auto& e : res.gantt) {
-            std::string ts = std::to_string(e.start);
-            if (e.start != prev) { std::cout << ts; prev = e.start; }
-            int w = (e.end - e.start) * 4 + 1 - (int)ts.size();
-            for (int i = 0; i < w; ++i) std::cout << ' ';
-        }
-        if (!res.gantt.empty()) std::cout << res.gantt.back().end;
-        std::cout << "\n";
+        res.totalClockTime = clock;
     }
 
-    static void printMetrics(const FCFSResult& res) {
-        std::cout << "\n  Per-Task Metrics [FCFS]\n";
-        std::cout << "  " << std::string(68, '-') << "\n";
-        std::cout << std::left
-                  << "  " << std::setw(6)  << "Task"
-                  << std::setw(9)  << "Arrival"
-                  << std::setw(8)  << "Burst"
-                  << std::setw(11) << "Deadline"
-                  << std::setw(12) << "Completion"
-                  << std::setw(12) << "Turnaround"
-                  << std::setw(9)  << "Waiting"
-                  << "Missed\n";
-        std::cout << "  " << std::string(68, '-') << "\n";
-
-        double totalTAT = 0, totalWT = 0;
-        for (const auto& t : res.tasks) {
-            std::cout << std::left
-                      << "  " << std::setw(6)  << t.name
-                      << std::setw(9)  << t.arrivalTime
-                      << std::setw(8)  << t.burstTime
-                      << std::setw(11) << t.hardDeadline
-                      << std::setw(12) << t.completionTime
-                      << std::setw(12) << t.turnaroundTime
-                      << std::setw(9)  << t.waitingTime
-                      << (t.deadlineMissed ? "YES !!" : "No") << "\n";
-            totalTAT += t.turnaroundTime;
-            totalWT  += t.waitingTime;
-        }
-        std::cout << "  " << std::string(68, '-') << "\n";
-        int n = (int)res.tasks.size();
-        double util = res.totalClockTime > 0
-                      ? 100.0 * res.totalBusyTime / res.totalClockTime : 0.0;
-        std::cout << std::fixed << std::setprecision(2);
-        std::cout << "  Avg Turnaround  : " << totalTAT / n << " ticks\n"
-                  << "  Avg Waiting     : " << totalWT  / n << " ticks\n"
-                  << "  Deadline Misses : " << res.deadlineMisses << "\n"
-                  << "  Context Switches: " << res.contextSwitches << "\n"
-                  << "  CPU Utilization : " << util << "%\n"
-                  << "  Total Clock     : " << res.totalClockTime << " ticks\n";
-    }
+    static void printGantt(const FCFSResult& res)   { ::printGantt(res, "FCFS"); }
+    static void printMetrics(const FCFSResult& res) { ::printMetrics(res, "FCFS"); }
 
 private:
     int csPenalty_;
@@ -1,55 +1,258 @@
 #pragma once
 #include <vector>
 #include <algorithm>
+#include <queue>
+#include <tuple>
+#include "Task.h"
+#include "Clock.h"
+#include "ArrivalCursor.h"
+#include "Instrument.h"
+#include "SegmentTrace.h"
+#include "BitmapRunQueue.h"
 
 using namespace std;
 
-struct Task {
-    int id;
-    int arrivalTime;
-    int burstTime;
-    int priority;
-    int completionTime;
-    int waitingTime;
-    int turnaroundTime;
-    bool completed = false;
+inline void priorityScheduling(vector<Task>& tasks, SegmentTrace* schedule = nullptr) {
+
+    int currentTime = 0;
+    int completedTasks = 0;
+    int n = tasks.size();
+
+    ArrivalCursor<Task> arrivals(tasks);
+
+    // Ready tasks keyed on (priority, index): the same winner the old
+    // linear scan picked (smallest priority value, lowest index).
+    priority_queue<pair<int, int>, vector<pair<int, int>>,
+                   greater<pair<int, int>>> ready;
+
+    while (completedTasks < n) {
+
+        arrivals.admit(currentTime, [&](int i) {
+            RTOS_PHASE(Phase::Queue);
+            RTOS_COUNT(Counter::QueuePushes, 1);
+            ready.push({tasks[i].priority, i});
+        });
+
+        if (ready.empty()) {
+            // CPU idle: jump straight to the next arrival
+            if (schedule) schedule->extend(kIdleTask, currentTime, arrivals.nextArrival());
+            currentTime = arrivals.nextArrival();
+            continue;
+        }
+
+        int idx;
+        {
+            RTOS_PHASE(Phase::Queue);
+            idx = ready.top().second;
+            ready.pop();
+        }
+        RTOS_COUNT(Counter::QueuePops, 1);
+        RTOS_COUNT(Counter::Dispatches, 1);
+
+        if (schedule) schedule->extend(tasks[idx].id, currentTime, currentTime + tasks[idx].burstTime);
+        currentTime += tasks[idx].burstTime;
+
+        tasks[idx].completionTime = currentTime;
+        tasks[idx].turnaroundTime =
+            tasks[idx].completionTime - tasks[idx].arrivalTime;
+        tasks[idx].waitingTime =
+            tasks[idx].turnaroundTime - tasks[idx].burstTime;
+
+        tasks[idx].completed = true;
+        completedTasks++;
+        RTOS_COUNT(Counter::Completions, 1);
+    }
+}
+
+// Preemptive priority: re-evaluated at every arrival.  Ready tasks are
+// keyed on (priority, arrival, index) so an equal-priority arrival
+// never preempts the running task.
+inline void preemptivePriorityScheduling(vector<Task>& tasks, SegmentTrace* schedule = nullptr) {
+
+    int currentTime = 0;
+    int completedTasks = 0;
+    int n = tasks.size();
+
+    vector<int> remaining(n);
+    for (int i = 0; i < n; i++)
+        remaining[i] = tasks[i].burstTime;
+
+    ArrivalCursor<Task> arrivals(tasks);
+
+    priority_queue<tuple<int, int, int>, vector<tuple<int, int, int>>,
+                   greater<tuple<int, int, int>>> ready;
+    int cutShort = -1;   // Stopped by an arrival with work left
+
+    while (completedTasks < n) {
+
+        arrivals.admit(currentTime, [&](int i) {
+            RTOS_PHASE(Phase::Queue);
+            RTOS_COUNT(Counter::QueuePushes, 1);
+            ready.push({tasks[i].priority, tasks[i].arrivalTime, i});
+        });
+
+        if (ready.empty()) {
+            if (schedule) schedule->extend(kIdleTask, currentTime, arrivals.nextArrival());
+            currentTime = arrivals.nextArrival();
+            continue;
+        }
+
+        int idx;
+        {
+            RTOS_PHASE(Phase::Queue);
+            idx = get<2>(ready.top());
+            ready.pop();
+        }
+        RTOS_COUNT(Counter::QueuePops, 1);
+        RTOS_COUNT(Counter::Dispatches, 1);
+        if (cutShort != -1 && cutShort != idx) RTOS_COUNT(Counter::Preemptions, 1);
+        cutShort = -1;
+
+        // Run until completion or the next arrival, whichever is first
+        EventHorizon next;
+        next.offer(currentTime + remaining[idx]);
+        next.offer(arrivals.nextArrival());
+
+        remaining[idx] -= next.next() - currentTime;
+        if (schedule) schedule->extend(tasks[idx].id, currentTime, next.next());
+        currentTime = next.next();
+
+        if (remaining[idx] > 0) {
+            RTOS_PHASE(Phase::Queue);
+            RTOS_COUNT(Counter::QueuePushes, 1);
+            ready.push({tasks[idx].priority, tasks[idx].arrivalTime, idx});
+            cutShort = idx;
+            continue;
+        }
+
+        tasks[idx].completionTime = currentTime;
+        tasks[idx].turnaroundTime =
+            tasks[idx].completionTime - tasks[idx].arrivalTime;
+        tasks[idx].waitingTime =
+            tasks[idx].turnaroundTime - tasks[idx].burstTime;
+
+        tasks[idx].completed = true;
+        completedTasks++;
+        RTOS_COUNT(Counter::Completions, 1);
+    }
+}
+
+// ── Fixed-level bitmap scheduler ──────────────────────────────
+//
+// Preemptive priority scheduling over kPriorityLevels FIFO run queues
+// (priority is clamped to [0, kPriorityLevels - 1], 0 = highest).
+// Picking the next task is O(1) through the run-queue bitmap, so the
+// dispatch cost does not grow with the number of tasks.
+//
+//   quantum        time slice per dispatch; on expiry the task goes to
+//                  the tail of its level (0 = run until preempted)
+//   agingInterval  a task that has waited this long is promoted one
+//                  level (0 = no aging)
+//   feedback       multilevel feedback: a task that uses its whole
+//                  slice is demoted one level
+//
+// A preempted task rejoins the tail of its level.
+
+constexpr int kPriorityLevels = 256;
+
+struct MultilevelConfig {
+    int  quantum       = 0;
+    int  agingInterval = 0;
+    bool feedback      = false;
 };
 
-void priorityScheduling(vector<Task>& tasks) {
+inline void multilevelScheduling(vector<Task>& tasks,
+                          const MultilevelConfig& config = {},
+                          SegmentTrace* schedule = nullptr) {
 
     int currentTime = 0;
     int completedTasks = 0;
     int n = tasks.size();
 
+    vector<int> remaining(n);
+    ArrivalCursor<Task> arrivals(tasks);
+    BitmapRunQueue<kPriorityLevels> ready(n, config.agingInterval);
+
+    int running = -1;
+    int sliceUsed = 0;
+    int cutShort = -1;   // Requeued with work left
+
     while (completedTasks < n) {
 
-        int idx = -1;
-        int highestPriority = 1e9;
+        arrivals.admit(currentTime, [&](int i) {
+            remaining[i] = tasks[i].burstTime;
+            int level = min(max(tasks[i].priority, 0), kPriorityLevels - 1);
+            RTOS_PHASE(Phase::Queue);
+            RTOS_COUNT(Counter::QueuePushes, 1);
+            ready.push(i, level, currentTime);
+        });
 
-        for (int i = 0; i < n; i++) {
-            if (!tasks[i].completed && tasks[i].arrivalTime <= currentTime) {
+        if (config.agingInterval > 0) {
+            RTOS_PHASE(Phase::Queue);
+            ready.age(currentTime);
+        }
 
-                if (tasks[i].priority < highestPriority) {
-                    highestPriority = tasks[i].priority;
-                    idx = i;
-                }
+        if (running != -1 && config.quantum > 0 && sliceUsed >= config.quantum) {
+            int level = ready.levelOf(running);
+            if (config.feedback)
+                level = min(level + 1, kPriorityLevels - 1);
+            RTOS_PHASE(Phase::Queue);
+            RTOS_COUNT(Counter::QueuePushes, 1);
+            ready.push(running, level, currentTime);
+            cutShort = running;
+            running = -1;
+        }
+
+        if (running != -1 && !ready.empty() &&
+            ready.highestLevel() < ready.levelOf(running)) {
+            RTOS_PHASE(Phase::Queue);
+            RTOS_COUNT(Counter::QueuePushes, 1);
+            ready.push(running, ready.levelOf(running), currentTime);
+            cutShort = running;
+            running = -1;
+        }
+
+        if (running == -1) {
+            if (ready.empty()) {
+                if (schedule) schedule->extend(kIdleTask, currentTime, arrivals.nextArrival());
+                currentTime = arrivals.nextArrival();
+                continue;
+            }
+            {
+                RTOS_PHASE(Phase::Queue);
+                running = ready.popHighest();
             }
+            RTOS_COUNT(Counter::QueuePops, 1);
+            RTOS_COUNT(Counter::Dispatches, 1);
+            if (cutShort != -1 && cutShort != running) RTOS_COUNT(Counter::Preemptions, 1);
+            cutShort = -1;
+            sliceUsed = 0;
         }
 
-        if (idx != -1) {
-            currentTime += tasks[idx].burstTime;
+        // Run until completion, an arrival, quantum expiry or a promotion
+        EventHorizon next;
+        next.offer(currentTime + remaining[running]);
+        next.offer(arrivals.nextArrival());
+        if (config.quantum > 0)
+            next.offer(currentTime + config.quantum - sliceUsed);
+        if (config.agingInterval > 0)
+            next.offer(ready.nextAgingTime());
 
-            tasks[idx].completionTime = currentTime;
-            tasks[idx].turnaroundTime =
-                tasks[idx].completionTime - tasks[idx].arrivalTime;
-            tasks[idx].waitingTime =
-                tasks[idx].turnaroundTime - tasks[idx].burstTime;
+        int ran = next.next() - currentTime;
+        if (schedule) schedule->extend(tasks[running].id, currentTime, next.next());
+        remaining[running] -= ran;
+        sliceUsed += ran;
+        currentTime = next.next();
 
-            tasks[idx].completed = true;
+        if (remaining[running] == 0) {
+            Task &t = tasks[running];
+            t.completionTime = currentTime;
+            t.turnaroundTime = t.completionTime - t.arrivalTime;
+            t.waitingTime = t.turnaroundTime - t.burstTime;
+            t.completed = true;
             completedTasks++;
-        }
-        else {
-            currentTime++;
+            RTOS_COUNT(Counter::Completions, 1);
+            running = -1;
         }
     }
 }
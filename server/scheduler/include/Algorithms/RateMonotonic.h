@@ -1,12 +1,17 @@
+#pragma once
 #include <vector>
+#include <queue>
+#include "Task.h"
+#include "Clock.h"
+#include "Instrument.h"
+#include "ReleaseCalendar.h"
+#include "SegmentTrace.h"
 using namespace std;
 
-struct Task {
-    int id;
-    int arrival_time;
-    int execution_time;
-    int period;   // Used as priority (smaller = higher priority)
-};
+/*
+    Each task runs once from arrivalTime for burstTime ticks; its
+    period is used as priority (smaller = higher priority).
+*/
 
 /*
     Rate Monotonic Scheduling Function
@@ -14,53 +19,102 @@ struct Task {
         tasks  -> vector of tasks
         n      -> number of tasks
     Returns:
-        vector<int> -> execution order (task IDs per time unit)
+        SegmentTrace -> execution order as (task ID, start, end) runs,
+                        idle runs use kIdleTask (-1)
 */
 
-vector<int> RM_Schedule(vector<Task> tasks, int n) {
+inline SegmentTrace RM_ScheduleSegments(const vector<Task>& tasks, int n) {
 
-    vector<int> execution_order;
+    SegmentTrace execution_order;
     vector<int> remaining(n);
     vector<bool> completed(n, false);
 
     // Initialize remaining time
     for (int i = 0; i < n; i++)
-        remaining[i] = tasks[i].execution_time;
+        remaining[i] = tasks[i].burstTime;
+
+    // Arrivals come off the calendar; ready tasks sit in a heap keyed on
+    // (period, index) so the top is the highest-priority task and ties go
+    // to the lower index, as with the original linear scan.
+    ReleaseCalendar arrivals;
+    arrivals.reserve(n);
+    for (int i = 0; i < n; i++)
+        arrivals.schedule(tasks[i].arrivalTime, i);
 
-    int time = 0;
+    priority_queue<pair<int, int>, vector<pair<int, int>>,
+                   greater<pair<int, int>>> ready;
+
+    SimClock clock;
     int completed_tasks = 0;
+    int running = -1;   // Ran last and has work left
 
     while (completed_tasks < n) {
 
-        int highest_priority = -1;
-        int min_period = 1e9;
-
-        // Select task with smallest period (highest priority)
-        for (int i = 0; i < n; i++) {
-            if (tasks[i].arrival_time <= time &&
-                !completed[i] &&
-                remaining[i] > 0 &&
-                tasks[i].period < min_period) {
+        int time = clock.now();
 
-                min_period = tasks[i].period;
-                highest_priority = i;
+        {
+            RTOS_PHASE(Phase::Release);
+            while (arrivals.due(time)) {
+                int i = arrivals.pop().task;
+                RTOS_COUNT(Counter::Releases, 1);
+                if (remaining[i] > 0 && tasks[i].period < 1e9) {
+                    RTOS_PHASE(Phase::Queue);
+                    RTOS_COUNT(Counter::QueuePushes, 1);
+                    ready.push({tasks[i].period, i});
+                }
             }
         }
 
-        if (highest_priority != -1) {
-            execution_order.push_back(tasks[highest_priority].id);
-            remaining[highest_priority]--;
+        // Only the next arrival can preempt the running task
+        EventHorizon next_event;
+        next_event.offer(arrivals.nextTime());
+
+        if (!ready.empty()) {
+            int highest_priority = ready.top().second;
+
+            // The running task stays on top of the heap until it completes
+            if (highest_priority != running) {
+                RTOS_COUNT(Counter::Dispatches, 1);
+                if (running != -1) RTOS_COUNT(Counter::Preemptions, 1);
+            }
+
+            next_event.offer(time + remaining[highest_priority]);
+            int run = next_event.next() - time;
+
+            execution_order.extend(tasks[highest_priority].id,
+                                   time, time + run);
+            remaining[highest_priority] -= run;
 
+            running = highest_priority;
             if (remaining[highest_priority] == 0) {
                 completed[highest_priority] = true;
                 completed_tasks++;
+                RTOS_COUNT(Counter::Completions, 1);
+                RTOS_PHASE(Phase::Queue);
+                RTOS_COUNT(Counter::QueuePops, 1);
+                ready.pop();
+                running = -1;
             }
         } else {
-            execution_order.push_back(-1);  // CPU Idle
+            if (!next_event.bounded())
+                break;  // Nothing left can ever become ready
+
+            execution_order.extend(kIdleTask, time,
+                                   next_event.next());  // CPU Idle
         }
 
-        time++;
+        clock.advanceTo(next_event.next());
     }
 
     return execution_order;
 }
+
+/*
+    Per-tick form of RM_ScheduleSegments
+    Returns:
+        vector<int> -> execution order (task IDs per time unit)
+*/
+
+inline vector<int> RM_Schedule(vector<Task> tasks, int n) {
+    return RM_ScheduleSegments(tasks, n).toTickOrder();
+}
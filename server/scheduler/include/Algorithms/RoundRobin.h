@@ -1,216 +1,275 @@
 #pragma once
-#include "Common.h"          // ← gets Task + GanttEntry from here
+#include "Task.h"
+#include "Scheduler.h"         // ← ScheduleResult, printGantt / printMetrics
+#include "Clock.h"
+#include "Instrument.h"
+#include "SegmentTrace.h"
+#include "TCB.h"
+#include "Trace.h"
+#include <cstddef>
 #include <vector>
-#include <deque>
 #include <iostream>
 #include <iomanip>
 #include <algorithm>
 #include <sstream>
 
-// ── RR-specific result ────────────────────────────────────────
-struct RRResult {
-    std::vector<Task>       tasks;
-    std::vector<GanttEntry> gantt;
-    int totalClockTime   = 0;
-    int totalBusyTime    = 0;
-    int contextSwitches  = 0;
-    int deadlineMisses   = 0;
+// ── RR result ─────────────────────────────────────────────────
+using RRResult = ScheduleResult;
+
+// Loop state at the top of one dispatch, enough to continue the run
+// from there (IncrementalScheduler).  Indices are positions in
+// arrival order: queued tasks carry their progress, the other tasks
+// before nextArrive have finished and the rest have not arrived.
+struct RRCheckpoint {
+    struct Queued {
+        int  index;
+        int  remaining;
+        int  startTime;
+        bool deadlineMissed;
+    };
+
+    Tick                clock           = 0;
+    int                 nextArrive      = 0;
+    int                 completed       = 0;
+    int                 prevTaskId      = -1;
+    std::size_t         segments        = 0;   // Gantt trace so far
+    int                 busy            = 0;
+    int                 contextSwitches = 0;
+    int                 misses          = 0;
+    std::vector<Queued> queue;                 // Front first
 };
 
 // ── Round Robin Scheduler ─────────────────────────────────────
+//
+// The pooled task state and the ready queue belong to the scheduler
+// and only grow, so a scheduler kept across runs (as
+// IncrementalScheduler does) allocates neither again.
 class RRScheduler {
 public:
 
     RRScheduler(int quantum, int csPenalty = 1)
         : quantum_(quantum), csPenalty_(csPenalty) {}
 
-    RRResult run(std::vector<Task> tasks) {
+    // New parameters for the next run; the buffers are kept.
+    void configure(int quantum, int csPenalty) {
+        quantum_   = quantum;
+        csPenalty_ = csPenalty;
+    }
+
+    // With `checkpoints`, the loop state is saved every
+    // max(kCheckpointGap, queue length) dispatches, so they take no
+    // more memory than the Gantt trace.
+    RRResult run(std::vector<Task> tasks, std::vector<RRCheckpoint>* checkpoints = nullptr) {
         RRResult result;
 
-        std::sort(tasks.begin(), tasks.end(),
-            [](const Task& a, const Task& b){
-                return a.arrivalTime < b.arrivalTime;
-            });
+        // Labels first, while the names are read in input order.
+        // Stable: tasks arriving together keep their input order.
+        labelTasks(result.gantt, tasks);
+        {
+            RTOS_PHASE(Phase::Release);
+            sortByArrival(tasks);
+        }
+        result.tasks = std::move(tasks);
+
+        RTOS_TRACE_TEXT(TraceLevel::Summary,
+                  "\n+--------------------------------------------------+\n"
+                  << "|  Round Robin  (Q=" << quantum_
+                  << "  CS Penalty=" << csPenalty_ << " tick)        |\n"
+                  << "+--------------------------------------------------+\n");
 
-        const int       N = (int)tasks.size();
-        std::deque<int> readyQ;
-        int clock      = 0;
-        int nextArrive = 0;
-        int completed  = 0;
-        int prevTaskId = -1;
+        RRCheckpoint start;
+        if (!result.tasks.empty()) start.clock = result.tasks[0].arrivalTime;
+        resume(result, start, checkpoints);
 
-        std::cout << "\n+--------------------------------------------------+\n";
-        std::cout << "|  Round Robin  (Q=" << quantum_
-                  << "  CS Penalty=" << csPenalty_ << " tick)        |\n";
-        std::cout << "+--------------------------------------------------+\n";
+        RTOS_TRACE_TEXT(TraceLevel::Summary,
+                        "\n  Round Robin done. Total clock = " << result.totalClockTime
+                        << " ticks.\n");
+        return result;
+    }
+
+    // Continues `res` from `cp`, a checkpoint of the same schedule:
+    // the trace is cut back to it and the counters and queued tasks
+    // restored.  Tasks before cp.nextArrive that are not queued keep
+    // their results; the caller resets the ones after it.  The
+    // checkpoints of the rest of the run, `cp` first, are appended.
+    void resume(RRResult& res, const RRCheckpoint& cp,
+                std::vector<RRCheckpoint>* checkpoints = nullptr) {
+        std::vector<Task>& tasks = res.tasks;
+        res.gantt.truncate(cp.segments);
+        res.totalBusyTime   = cp.busy;
+        res.contextSwitches = cp.contextSwitches;
+        res.deadlineMisses  = cp.misses;
+
+        // The loop works on the pooled state; names stay in `tasks`
+        // for the trace
+        const int       N      = (int)tasks.size();
+        TCBPool&        pool   = pool_;
+        RingQueue<int>& readyQ = readyQ_;
+        pool.load(tasks);
+        readyQ.reset(tasks.size());
+        for (const RRCheckpoint::Queued& q : cp.queue) {
+            HotTCB& h        = pool.hot(q.index);
+            h.remaining      = q.remaining;
+            h.startTime      = q.startTime;
+            h.deadlineMissed = q.deadlineMissed;
+            pool.cold(q.index).completed = false;
+            readyQ.push_back(q.index);
+        }
+        int clock      = cp.clock;
+        int nextArrive = cp.nextArrive;
+        int completed  = cp.completed;
+        int prevTaskId = cp.prevTaskId;
+
+        std::size_t dispatches     = 0;
+        std::size_t nextCheckpoint = 0;
+        int         cutShort       = -1;   // Quantum expired with work left
 
         auto enqueue = [&]() {
-            while (nextArrive < N && tasks[nextArrive].arrivalTime <= clock) {
-                readyQ.push_back(nextArrive);
-                std::cout << "  [ARR]   " << tasks[nextArrive].name
-                          << " arrived at tick " << tasks[nextArrive].arrivalTime << "\n";
+            RTOS_PHASE(Phase::Release);
+            while (nextArrive < N && pool.hot(nextArrive).arrival <= clock) {
+                RTOS_COUNT(Counter::Releases, 1);
+                RTOS_COUNT(Counter::QueuePushes, 1);
+                {
+                    RTOS_PHASE(Phase::Queue);
+                    readyQ.push_back(nextArrive);
+                }
+                RTOS_TRACE(TraceLevel::Event, TraceEvent::Arrival,
+                           tasks[nextArrive].arrivalTime, tasks[nextArrive].id, 0,
+                           "  [ARR]   " << tasks[nextArrive].name
+                           << " arrived at tick " << tasks[nextArrive].arrivalTime << "\n");
                 ++nextArrive;
             }
         };
 
-        if (N > 0) clock = tasks[0].arrivalTime;
         enqueue();
 
         while (completed < N) {
 
+            if (checkpoints && dispatches >= nextCheckpoint) {
+                RRCheckpoint here{clock, nextArrive, completed, prevTaskId,
+                                  res.gantt.size(), res.totalBusyTime,
+                                  res.contextSwitches, res.deadlineMisses, {}};
+                here.queue.reserve(readyQ.size());
+                for (std::size_t j = 0; j < readyQ.size(); ++j) {
+                    const HotTCB& h = pool.hot(readyQ[j]);
+                    here.queue.push_back({readyQ[j], h.remaining, h.startTime,
+                                          h.deadlineMissed});
+                }
+                checkpoints->push_back(std::move(here));
+                nextCheckpoint = dispatches + std::max(kCheckpointGap, readyQ.size());
+            }
+
             if (readyQ.empty()) {
                 if (nextArrive < N) {
-                    int idleEnd = tasks[nextArrive].arrivalTime;
-                    std::cout << "  [IDLE]  " << clock << " -> " << idleEnd << "\n";
-                    result.gantt.push_back({"IDLE", clock, idleEnd});
+                    int idleEnd = pool.hot(nextArrive).arrival;
+                    RTOS_TRACE(TraceLevel::Event, TraceEvent::Idle, clock, -1, idleEnd,
+                               "  [IDLE]  " << clock << " -> " << idleEnd << "\n");
+                    res.gantt.append(kIdleTask, clock, idleEnd);
                     clock = idleEnd;
                     enqueue();
                 }
                 continue;
             }
 
-            int   idx = readyQ.front(); readyQ.pop_front();
-            Task& t   = tasks[idx];
+            int idx;
+            {
+                RTOS_PHASE(Phase::Queue);
+                idx = readyQ.pop_front();
+            }
+            HotTCB& t = pool.hot(idx);
+            ++dispatches;
+            RTOS_COUNT(Counter::QueuePops, 1);
+            RTOS_COUNT(Counter::Dispatches, 1);
+            if (cutShort != -1 && cutShort != idx) RTOS_COUNT(Counter::Preemptions, 1);
+            cutShort = -1;
 
             // Context switch
             if (prevTaskId != -1 && prevTaskId != t.id) {
                 int csEnd = clock + csPenalty_;
-                std::cout << "  [CS]    " << clock << " -> " << csEnd
-                          << "  (switch to " << t.name << ")\n";
-                result.gantt.push_back({"CS", clock, csEnd});
+                RTOS_TRACE(TraceLevel::Event, TraceEvent::ContextSwitch, clock, t.id, csEnd,
+                           "  [CS]    " << clock << " -> " << csEnd
+                           << "  (switch to " << tasks[idx].name << ")\n");
+                res.gantt.append(kContextSwitchTask, clock, csEnd);
                 clock = csEnd;
-                ++result.contextSwitches;
+                ++res.contextSwitches;
             }
 
             if (t.startTime == -1) t.startTime = clock;
 
-            int slice      = std::min(quantum_, t.remainingTime);
+            int slice      = std::min(quantum_, t.remaining);
             int sliceStart = clock;
 
-            std::cout << "  [RUN]   " << t.name
-                      << "  clock=" << clock
-                      << "  slice=" << slice
-                      << "  remaining=" << t.remainingTime
-                      << "  deadline=" << t.hardDeadline << "\n";
+            RTOS_TRACE(TraceLevel::Event, TraceEvent::Dispatch, clock, t.id, slice,
+                       "  [RUN]   " << tasks[idx].name
+                       << "  clock=" << clock
+                       << "  slice=" << slice
+                       << "  remaining=" << t.remaining
+                       << "  deadline=" << t.hardDeadline << "\n");
 
-            for (int i = 0; i < slice; ++i) {
-                ++clock; --t.remainingTime;
-                if (!t.deadlineMissed && clock > t.hardDeadline) {
+            // Jump to the quantum expiry / completion tick
+            // (hardDeadline <= 0 means the task has no deadline)
+            {
+                RTOS_PHASE(Phase::Deadline);
+                Tick violation = t.hardDeadline > 0
+                    ? firstDeadlineViolation(clock, slice, t.hardDeadline)
+                    : kNever;
+                if (!t.deadlineMissed && violation != kNever) {
                     t.deadlineMissed = true;
-                    std::cout << "  !! DEADLINE VIOLATION  " << t.name
-                              << "  clock=" << clock
-                              << "  deadline=" << t.hardDeadline << "\n";
+                    RTOS_COUNT(Counter::DeadlineMisses, 1);
+                    RTOS_TRACE(TraceLevel::Event, TraceEvent::DeadlineMiss, violation, t.id, t.hardDeadline,
+                               "  !! DEADLINE VIOLATION  " << tasks[idx].name
+                               << "  clock=" << violation
+                               << "  deadline=" << t.hardDeadline << "\n");
                 }
             }
+            if (slice > 0) {
+                clock       += slice;
+                t.remaining -= slice;
+            }
 
-            result.gantt.push_back({t.name, sliceStart, clock});
-            result.totalBusyTime += slice;
+            res.gantt.append(t.id, sliceStart, clock);
+            res.totalBusyTime += slice;
             prevTaskId = t.id;
 
             enqueue();
 
-            if (t.remainingTime == 0) {
-                t.completionTime = clock;
-                t.turnaroundTime = t.completionTime - t.arrivalTime;
-                t.waitingTime    = t.turnaroundTime - t.burstTime;
-                if (t.deadlineMissed) ++result.deadlineMisses;
+            if (t.remaining == 0) {
+                pool.complete(idx, clock);
+                if (t.deadlineMissed) ++res.deadlineMisses;
                 ++completed;
-                std::cout << "  [DONE]  " << t.name
-                          << "  completion=" << t.completionTime
-                          << "  TAT=" << t.turnaroundTime
-                          << "  WT=" << t.waitingTime
-                          << (t.deadlineMissed ? "  !! MISSED" : "  OK") << "\n";
+                RTOS_COUNT(Counter::Completions, 1);
+                RTOS_TRACE(TraceLevel::Event, TraceEvent::Complete, clock, t.id,
+                           pool.cold(idx).turnaround,
+                           "  [DONE]  " << tasks[idx].name
+                           << "  completion=" << clock
+                           << "  TAT=" << pool.cold(idx).turnaround
+                           << "  WT=" << pool.cold(idx).waiting
+                           << (t.deadlineMissed ? "  !! MISSED" : "  OK") << "\n");
             } else {
-                readyQ.push_back(idx);
-                std::cout << "  [PRE]   " << t.name
-                          << "  preempted, remaining=" << t.remainingTime << "\n";
+                {
+                    RTOS_PHASE(Phase::Queue);
+                    readyQ.push_back(idx);
+                }
+                RTOS_COUNT(Counter::QueuePushes, 1);
+                cutShort = idx;
+                RTOS_TRACE(TraceLevel::Event, TraceEvent::Preempt, clock, t.id, t.remaining,
+                           "  [PRE]   " << tasks[idx].name
+                           << "  preempted, remaining=" << t.remaining << "\n");
             }
         }
 
-        result.tasks          = tasks;
-        result.totalClockTime = clock;
-        std::cout << "\n  Round Robin done. Total clock = " << clock << " ticks.\n";
-        return result;
-    }
-
-    static void printGantt(const RRResult& res) {
-        std::cout << "\n  Gantt Chart [Round Robin]\n  ";
-        for (const auto& e : res.gantt) {
-            int w = (e.end - e.start) * 4;
-            for (int i = 0; i < w; ++i) std::cout << '-';
-            std::cout << '+';
-        }
-        std::cout << "\n  |";
-        for (const auto& e : res.gantt) {
-            int w    = (e.end - e.start) * 4 - 1;
-            int lLen = (int)e.label.size();
-            int padL = (w - lLen) / 2;
-            int padR = w - lLen - padL;
-            for (int i = 0; i < padL; ++i) std::cout << ' ';
-            std::cout << e.label;
-            for (int i = 0; i < padR; ++i) std::cout << ' ';
-            std::cout << '|';
-        }
-        std::cout << "\n  ";
-        for (const auto& e : res.gantt) {
-            int w = (e.end - e.start) * 4;
-            for (int i = 0; i < w; ++i) std::cout << '-';
-            std::cout << '+';
-        }
-        std::cout << "\n  ";
-        int prev = -1;
-        for (const auto& e : res.gantt) {
-            std::string ts = std::to_string(e.start);
-            if (e.start != prev) { std::cout << ts; prev = e.start; }
-            int w = (e.end - e.start) * 4 + 1 - (int)ts.size();
-            for (int i = 0; i < w; ++i) std::cout << ' ';
-        }
-        if (!res.gantt.empty()) std::cout << res.gantt.back().end;
-        std::cout << "\n";
+        pool.store(tasks);
+        res.totalClockTime = clock;
     }
 
-    static void printMetrics(const RRResult& res) {
-        std::cout << "\n  Per-Task Metrics [Round Robin]\n";
-        std::cout << "  " << std::string(68, '-') << "\n";
-        std::cout << std::left
-                  << "  " << std::setw(6)  << "Task"
-                  << std::setw(9)  << "Arrival"
-                  << std::setw(8)  << "Burst"
-                  << std::setw(11) << "Deadline"
-                  << std::setw(12) << "Completion"
-                  << std::setw(12) << "Turnaround"
-                  << std::setw(9)  << "Waiting"
-                  << "Missed\n";
-        std::cout << "  " << std::string(68, '-') << "\n";
-
-        double totalTAT = 0, totalWT = 0;
-        for (const auto& t : res.tasks) {
-            std::cout << std::left
-                      << "  " << std::setw(6)  << t.name
-                      << std::setw(9)  << t.arrivalTime
-                      << std::setw(8)  << t.burstTime
-                      << std::setw(11) << t.hardDeadline
-                      << std::setw(12) << t.completionTime
-                      << std::setw(12) << t.turnaroundTime
-                      << std::setw(9)  << t.waitingTime
-                      << (t.deadlineMissed ? "YES !!" : "No") << "\n";
-            totalTAT += t.turnaroundTime;
-            totalWT  += t.waitingTime;
-        }
-        std::cout << "  " << std::string(68, '-') << "\n";
-        int n = (int)res.tasks.size();
-        double util = res.totalClockTime > 0
-                      ? 100.0 * res.totalBusyTime / res.totalClockTime : 0.0;
-        std::cout << std::fixed << std::setprecision(2);
-        std::cout << "  Avg Turnaround  : " << totalTAT / n << " ticks\n"
-                  << "  Avg Waiting     : " << totalWT  / n << " ticks\n"
-                  << "  Deadline Misses : " << res.deadlineMisses << "\n"
-                  << "  Context Switches: " << res.contextSwitches << "\n"
-                  << "  CPU Utilization : " << util << "%\n"
-                  << "  Total Clock     : " << res.totalClockTime << " ticks\n";
-    }
+    static void printGantt(const RRResult& res)   { ::printGantt(res, "Round Robin"); }
+    static void printMetrics(const RRResult& res) { ::printMetrics(res, "Round Robin"); }
 
 private:
-    int quantum_;
-    int csPenalty_;
+    static constexpr std::size_t kCheckpointGap = 64;   // Dispatches
+
+    int            quantum_;
+    int            csPenalty_;
+    TCBPool        pool_;
+    RingQueue<int> readyQ_;
 };
@@ -1,54 +1,137 @@
 #pragma once
 #include <vector>
 #include <algorithm>
+#include <queue>
+#include <tuple>
+#include "Task.h"
+#include "Clock.h"
+#include "ArrivalCursor.h"
+#include "Instrument.h"
+#include "SegmentTrace.h"
 
 using namespace std;
 
-struct Task {
-    int id;
-    int arrivalTime;
-    int burstTime;
-    int completionTime;
-    int waitingTime;
-    int turnaroundTime;
-    bool completed = false;
-};
-
-void sjfScheduling(vector<Task>& tasks) {
+inline void sjfScheduling(vector<Task>& tasks, SegmentTrace* schedule = nullptr) {
 
     int currentTime = 0;
     int completedTasks = 0;
     int n = tasks.size();
 
+    ArrivalCursor<Task> arrivals(tasks);
+
+    // Ready tasks keyed on (burst, index): the same winner the old
+    // linear scan picked (shortest burst, lowest index).
+    priority_queue<pair<int, int>, vector<pair<int, int>>,
+                   greater<pair<int, int>>> ready;
+
     while (completedTasks < n) {
 
-        int idx = -1;
-        int shortestBurst = 1e9;
+        arrivals.admit(currentTime, [&](int i) {
+            RTOS_PHASE(Phase::Queue);
+            RTOS_COUNT(Counter::QueuePushes, 1);
+            ready.push({tasks[i].burstTime, i});
+        });
 
-        for (int i = 0; i < n; i++) {
-            if (!tasks[i].completed && tasks[i].arrivalTime <= currentTime) {
+        if (ready.empty()) {
+            // CPU idle: jump straight to the next arrival
+            if (schedule) schedule->extend(kIdleTask, currentTime, arrivals.nextArrival());
+            currentTime = arrivals.nextArrival();
+            continue;
+        }
 
-                if (tasks[i].burstTime < shortestBurst) {
-                    shortestBurst = tasks[i].burstTime;
-                    idx = i;
-                }
-            }
+        int idx;
+        {
+            RTOS_PHASE(Phase::Queue);
+            idx = ready.top().second;
+            ready.pop();
         }
+        RTOS_COUNT(Counter::QueuePops, 1);
+        RTOS_COUNT(Counter::Dispatches, 1);
 
-        if (idx != -1) {
-            currentTime += tasks[idx].burstTime;
+        if (schedule) schedule->extend(tasks[idx].id, currentTime, currentTime + tasks[idx].burstTime);
+        currentTime += tasks[idx].burstTime;
+
+        tasks[idx].completionTime = currentTime;
+        tasks[idx].turnaroundTime =
+            tasks[idx].completionTime - tasks[idx].arrivalTime;
+        tasks[idx].waitingTime =
+            tasks[idx].turnaroundTime - tasks[idx].burstTime;
+
+        tasks[idx].completed = true;
+        completedTasks++;
+        RTOS_COUNT(Counter::Completions, 1);
+    }
+}
+
+// Shortest Remaining Time First (preemptive SJF): re-evaluated at every
+// arrival.  Ready tasks are keyed on (remaining, arrival, index) so a
+// tie never preempts the running task.
+inline void srtfScheduling(vector<Task>& tasks, SegmentTrace* schedule = nullptr) {
+
+    int currentTime = 0;
+    int completedTasks = 0;
+    int n = tasks.size();
 
-            tasks[idx].completionTime = currentTime;
-            tasks[idx].turnaroundTime =
-                tasks[idx].completionTime - tasks[idx].arrivalTime;
-            tasks[idx].waitingTime =
-                tasks[idx].turnaroundTime - tasks[idx].burstTime;
+    vector<int> remaining(n);
+    for (int i = 0; i < n; i++)
+        remaining[i] = tasks[i].burstTime;
 
-            tasks[idx].completed = true;
-            completedTasks++;
+    ArrivalCursor<Task> arrivals(tasks);
+
+    priority_queue<tuple<int, int, int>, vector<tuple<int, int, int>>,
+                   greater<tuple<int, int, int>>> ready;
+    int cutShort = -1;   // Stopped by an arrival with work left
+
+    while (completedTasks < n) {
+
+        arrivals.admit(currentTime, [&](int i) {
+            RTOS_PHASE(Phase::Queue);
+            RTOS_COUNT(Counter::QueuePushes, 1);
+            ready.push({remaining[i], tasks[i].arrivalTime, i});
+        });
+
+        if (ready.empty()) {
+            if (schedule) schedule->extend(kIdleTask, currentTime, arrivals.nextArrival());
+            currentTime = arrivals.nextArrival();
+            continue;
+        }
+
+        int idx;
+        {
+            RTOS_PHASE(Phase::Queue);
+            idx = get<2>(ready.top());
+            ready.pop();
         }
-        else {
-            currentTime++;
+        RTOS_COUNT(Counter::QueuePops, 1);
+        RTOS_COUNT(Counter::Dispatches, 1);
+        if (cutShort != -1 && cutShort != idx) RTOS_COUNT(Counter::Preemptions, 1);
+        cutShort = -1;
+
+        // Run until completion or the next arrival, whichever is first
+        EventHorizon next;
+        next.offer(currentTime + remaining[idx]);
+        next.offer(arrivals.nextArrival());
+
+        remaining[idx] -= next.next() - currentTime;
+        if (schedule) schedule->extend(tasks[idx].id, currentTime, next.next());
+        currentTime = next.next();
+
+        if (remaining[idx] > 0) {
+            RTOS_PHASE(Phase::Queue);
+            RTOS_COUNT(Counter::QueuePushes, 1);
+            ready.push({remaining[idx], tasks[idx].arrivalTime, idx});
+            cutShort = idx;
+            continue;
         }
+
+        tasks[idx].completionTime = currentTime;
+        tasks[idx].turnaroundTime =
+            tasks[idx].completionTime - tasks[idx].arrivalTime;
+        tasks[idx].waitingTime =
+            tasks[idx].turnaroundTime - tasks[idx].burstTime;
+
+        tasks[idx].completed = true;
+        completedTasks++;
+        RTOS_COUNT(Counter::Completions, 1);
     }
 }
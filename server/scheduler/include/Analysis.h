@@ -0,0 +1,91 @@
+#pragma once
+#include "Task.h"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// ── Schedulability analysis ───────────────────────────────────
+//
+// Answers "will this periodic task set meet every deadline?" without
+// simulating a hyperperiod.  Tasks are read as (C, T, D) =
+// (burstTime, period, relativeDeadline or period when 0); every task
+// needs period > 0.  Release offsets (arrivalTime) are ignored: the
+// synchronous release at t = 0 is the worst case for fixed priority,
+// so the verdict is safe for any offsets.
+//
+//   utilization          U = sum C/T; U > 1 is never schedulable
+//   Liu & Layland        U <= n(2^(1/n) - 1)       sufficient, RM/DM, D = T
+//   hyperbolic bound     prod(C/T + 1) <= 2        sufficient, RM/DM, D = T
+//   response-time test   exact for any fixed priority order, any D
+//
+// The response-time test iterates
+//
+//   w = (q+1)C_i + sum_{j in hp(i)} ceil(w / T_j) C_j
+//
+// to its least fixed point for q = 0, 1, ... jobs of task i in the
+// level-i busy period, and stops as soon as a window passes the
+// deadline.  Each task's first window is seeded from the one above
+// it (R_i >= R_{i-1} + C_i), which cuts most tasks to one or two
+// passes.
+enum class PriorityOrder {
+    RateMonotonic,       // Shorter period first
+    DeadlineMonotonic,   // Shorter relative deadline first
+    Explicit,            // Task::priority, smaller = higher
+};
+
+const char* priorityOrderName(PriorityOrder order);
+bool        parsePriorityOrder(const std::string& name, PriorityOrder& order);
+
+// Task indices, highest priority first (stable, so equal keys keep
+// input order).  Throws std::invalid_argument for a period <= 0.
+std::vector<std::size_t> priorityIndex(const std::vector<Task>& tasks, PriorityOrder order);
+
+// LCM of all periods; false (and `out` untouched) if it overflows
+// int64.  Non-positive periods are skipped.
+bool hyperperiod(const std::vector<Task>& tasks, std::int64_t& out);
+
+struct ResponseTime {
+    int          taskId      = 0;
+    std::int64_t wcet        = 0;
+    std::int64_t period      = 0;
+    std::int64_t deadline    = 0;
+    std::int64_t wcrt        = 0;   // Past the deadline when !schedulable
+    bool         schedulable = false;
+    bool         upperBound  = false;   // wcrt is a closed-form bound, not exact
+    bool         analysed    = false;   // false: skipped after an early exit
+};
+
+struct SchedulabilityReport {
+    PriorityOrder order             = PriorityOrder::RateMonotonic;
+    double        utilization       = 0;
+    double        liuLaylandBound   = 0;
+    double        hyperbolicProduct = 0;
+    bool          boundsApply       = false;   // RM / DM with implicit deadlines
+    bool          liuLaylandPass    = false;
+    bool          hyperbolicPass    = false;
+    bool          exact             = false;   // Response-time test ran
+    bool          schedulable       = false;
+    bool          hyperperiodFits   = false;
+    std::int64_t  hyperperiod       = 0;
+    std::vector<ResponseTime> responses;       // Highest priority first
+};
+
+// With `allResponses` false the analysis stops at the first verdict:
+// a passing bound, U > 1, or the first task that misses.  Throws
+// std::invalid_argument for tasks without a period.
+SchedulabilityReport analyzeFixedPriority(const std::vector<Task>& tasks,
+                                          PriorityOrder order,
+                                          bool allResponses = true);
+
+// Confirmation run: synchronous release, fixed-priority preemptive,
+// simulated only until the processor first goes idle (or `limit`).
+// Returns the longest observed response of each task, in the same
+// order as SchedulabilityReport::responses.
+std::vector<std::int64_t> simulateFixedPriority(const std::vector<Task>& tasks,
+                                                PriorityOrder order,
+                                                std::int64_t limit);
+
+void printAnalysis(const SchedulabilityReport& report, std::ostream& os,
+                   const std::vector<std::int64_t>* observed = nullptr);
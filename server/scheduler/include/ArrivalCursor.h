@@ -0,0 +1,48 @@
+#pragma once
+#include "Clock.h"
+#include "Instrument.h"
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+// ── Arrival-sorted cursor ─────────────────────────────────────
+//
+// Walks a task vector in arrival order (ties keep vector order)
+// without reordering the caller's tasks.  Schedulers admit every
+// task that has arrived by `now` into their ready structure and use
+// nextArrival() as the idle-time jump target.  Works with any task
+// type that exposes an `arrivalTime` member.
+template <class TaskT>
+class ArrivalCursor {
+public:
+    explicit ArrivalCursor(const std::vector<TaskT>& tasks)
+        : tasks_(tasks), order_(tasks.size()) {
+        std::iota(order_.begin(), order_.end(), 0);
+        std::stable_sort(order_.begin(), order_.end(),
+            [&](int a, int b){
+                return tasks_[a].arrivalTime < tasks_[b].arrivalTime;
+            });
+    }
+
+    bool pending() const { return next_ < order_.size(); }
+
+    Tick nextArrival() const {
+        return pending() ? tasks_[order_[next_]].arrivalTime : kNever;
+    }
+
+    // Call onArrive(index) for every task with arrivalTime <= now.
+    template <class F>
+    void admit(Tick now, F&& onArrive) {
+        RTOS_PHASE(Phase::Release);
+        while (pending() && tasks_[order_[next_]].arrivalTime <= now) {
+            RTOS_COUNT(Counter::Releases, 1);
+            onArrive(order_[next_++]);
+        }
+    }
+
+private:
+    const std::vector<TaskT>& tasks_;
+    std::vector<int>          order_;
+    std::size_t               next_ = 0;
+};
@@ -0,0 +1,65 @@
+#pragma once
+#include "Options.h"
+#include "Scheduler.h"
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// ── Batch and parameter-sweep runs ────────────────────────────
+//
+// A batch file lists workloads and the runs to make over them:
+//
+//   workload light  tasks/light.txt      # path relative to the batch file
+//   workload heavy  tasks/heavy.txt
+//   run light all                        # every policy
+//   run *     rr --quantum 1..8 --cs 0..2
+//   run heavy mlq --aging 0..100:10 --feedback
+//
+// `*` means every workload; numeric values written `a..b` or
+// `a..b:step` expand into one job per value (the cartesian product
+// when several options are ranges).  Workloads are loaded once
+// (task lines, or a mapped task-set file; see TaskSet.h) and shared
+// read-only by all jobs.  Trace output is off in batch mode.
+struct BatchWorkload {
+    std::string       name;
+    std::vector<Task> tasks;
+};
+
+struct BatchJob {
+    int         workload = 0;   // Index into BatchPlan::workloads
+    RunOptions  options;
+    std::string params;         // Options as written, for the report
+};
+
+struct BatchPlan {
+    std::vector<BatchWorkload> workloads;
+    std::vector<BatchJob>      jobs;
+};
+
+// Everything the report needs from one run; the full ScheduleResult
+// is dropped as soon as the job finishes.
+struct JobSummary {
+    double       avgTurnaround   = 0;
+    double       avgWaiting      = 0;
+    int          deadlineMisses  = 0;
+    int          contextSwitches = 0;
+    int          totalBusyTime   = 0;
+    int          totalClockTime  = 0;
+    LogHistogram response;       // Response times of the run's jobs
+    std::string  error;          // Non-empty if the job threw
+};
+
+struct BatchReport {
+    std::vector<JobSummary> jobs;   // Same order as BatchPlan::jobs
+    unsigned threads     = 0;
+    double   wallSeconds = 0;
+};
+
+// `baseDir` resolves relative workload paths; throws on bad input.
+BatchPlan   parseBatch(std::istream& in, const std::string& baseDir = "");
+
+// threads = 0 uses one worker per core.
+BatchReport runBatch(const BatchPlan& plan, unsigned threads = 0);
+
+void printBatchReport(const BatchPlan& plan, const BatchReport& report,
+                      std::ostream& os);
@@ -0,0 +1,145 @@
+#pragma once
+#include "Clock.h"
+#include <array>
+#include <deque>
+#include <cstdint>
+#include <vector>
+
+// ── Bitmap multilevel run queue ───────────────────────────────
+//
+// Fixed number of priority levels, level 0 = highest.  Every level
+// is an intrusive FIFO threaded through per-task arrays (no node
+// allocation), and a two-level bitmap (one summary word over up to
+// 64 level words) finds the highest non-empty level with two
+// find-first-set instructions, as in the Linux O(1) scheduler and
+// the FreeRTOS / uC/OS ready lists.  push / pop are O(1) no matter
+// how many tasks are queued.
+//
+// Optional aging: every push happens at the current (monotonic)
+// simulation time, so promotions fall due in push order.  A single
+// FIFO of (task, stamp) entries therefore yields the next promotion
+// in O(1); entries for tasks that have since been popped or re-pushed
+// are skipped lazily.
+template <int Levels = 256>
+class BitmapRunQueue {
+    static_assert(Levels > 0 && Levels <= 64 * 64, "1..4096 levels");
+    static constexpr int kWords = (Levels + 63) / 64;
+
+public:
+    static constexpr int kLevels = Levels;
+
+    // agingInterval > 0 promotes a task one level after it has waited
+    // that long (see age()); 0 disables aging.
+    explicit BitmapRunQueue(int capacity, Tick agingInterval = 0)
+        : agingInterval_(agingInterval),
+          next_(capacity, -1), level_(capacity, 0), since_(capacity, 0),
+          stamp_(capacity, 0), queued_(capacity, false) {
+        head_.fill(-1);
+        tail_.fill(-1);
+    }
+
+    bool empty()      const { return size_ == 0; }
+    int  size()       const { return size_; }
+    int  levelOf(int task)    const { return level_[task]; }
+    Tick enqueuedAt(int task) const { return since_[task]; }
+    int  front(int level)     const { return head_[level]; }
+
+    // Highest-priority (lowest-numbered) non-empty level, -1 if empty.
+    int highestLevel() const {
+        if (summary_ == 0) return -1;
+        int w = __builtin_ctzll(summary_);
+        return w * 64 + __builtin_ctzll(words_[w]);
+    }
+
+    void push(int task, int level, Tick now) {
+        next_[task]  = -1;
+        level_[task] = level;
+        since_[task] = now;
+        if (tail_[level] < 0) {
+            head_[level] = task;
+            setBit(level);
+        } else {
+            next_[tail_[level]] = task;
+        }
+        tail_[level] = task;
+        ++size_;
+
+        queued_[task] = true;
+        if (agingInterval_ > 0)
+            aging_.push_back({task, ++stamp_[task]});
+    }
+
+    int pop(int level) {
+        int task     = head_[level];
+        head_[level] = next_[task];
+        if (head_[level] < 0) {
+            tail_[level] = -1;
+            clearBit(level);
+        }
+        --size_;
+        queued_[task] = false;
+        return task;
+    }
+
+    int popHighest() { return pop(highestLevel()); }
+
+    // Promote every task that has waited agingInterval or longer by one
+    // level.  Each promotion is O(1).
+    void age(Tick now) {
+        while (dropStale(), !aging_.empty()) {
+            int task = aging_.front().task;
+            if (now - since_[task] < agingInterval_) break;
+            aging_.pop_front();
+            int level = level_[task];
+            // The oldest queued task is always the head of its level
+            if (level > 0)
+                push(pop(level), level - 1, now);
+        }
+    }
+
+    // Earliest time age() would promote anything, kNever if nothing can.
+    Tick nextAgingTime() {
+        dropStale();
+        return aging_.empty() ? kNever : since_[aging_.front().task] + agingInterval_;
+    }
+
+private:
+    struct AgingEntry {
+        int      task;
+        unsigned stamp;
+    };
+
+    void dropStale() {
+        while (!aging_.empty()) {
+            const AgingEntry& e = aging_.front();
+            if (queued_[e.task] && stamp_[e.task] == e.stamp) return;
+            aging_.pop_front();
+        }
+    }
+
+    void setBit(int level) {
+        words_[level / 64] |= std::uint64_t(1) << (level % 64);
+        summary_           |= std::uint64_t(1) << (level / 64);
+    }
+
+    void clearBit(int level) {
+        words_[level / 64] &= ~(std::uint64_t(1) << (level % 64));
+        if (words_[level / 64] == 0)
+            summary_ &= ~(std::uint64_t(1) << (level / 64));
+    }
+
+    std::array<int, Levels>           head_;
+    std::array<int, Levels>           tail_;
+    std::array<std::uint64_t, kWords> words_{};
+    std::uint64_t                     summary_ = 0;
+    int                               size_    = 0;
+
+    Tick                   agingInterval_;
+    std::deque<AgingEntry> aging_;
+
+    std::vector<int>      next_;
+    std::vector<int>      level_;
+    std::vector<Tick>     since_;
+    std::vector<unsigned> stamp_;
+    std::vector<bool>     queued_;
+};
@@ -0,0 +1,46 @@
+#pragma once
+#include <limits>
+
+// ── Discrete-event simulation clock ───────────────────────────
+//
+// Schedulers never step time one tick at a time.  At every event
+// they offer the candidate times of everything that could change
+// the schedule (next release, completion, quantum expiry, deadline)
+// to an EventHorizon and jump the clock straight to the earliest.
+
+using Tick = int;
+
+constexpr Tick kNever = std::numeric_limits<Tick>::max();
+
+class SimClock {
+public:
+    explicit SimClock(Tick start = 0) : now_(start) {}
+
+    Tick now() const { return now_; }
+
+    // Jump forward to t (t >= now()).
+    void advanceTo(Tick t);
+    void advanceBy(Tick d) { advanceTo(now_ + d); }
+
+private:
+    Tick now_;
+};
+
+// ── Next-event horizon ────────────────────────────────────────
+class EventHorizon {
+public:
+    explicit EventHorizon(Tick limit = kNever) : next_(limit) {}
+
+    void offer(Tick t) { if (t < next_) next_ = t; }
+
+    Tick next()    const { return next_; }
+    bool bounded() const { return next_ != kNever; }
+
+private:
+    Tick next_;
+};
+
+// First clock value c in (start, start + len] with c > deadline, or
+// kNever if the whole run finishes on time.  Replaces the per-tick
+// "++clock; if (clock > deadline)" loops.
+Tick firstDeadlineViolation(Tick start, Tick len, Tick deadline);
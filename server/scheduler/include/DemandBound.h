@@ -0,0 +1,73 @@
+#pragma once
+#include "TaskTable.h"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+// ── EDF processor-demand analysis ─────────────────────────────
+//
+// A periodic task set is EDF-schedulable iff the demand bound
+//
+//   dbf(t) = sum_i max(0, floor((t - D_i) / T_i) + 1) C_i
+//
+// never exceeds t.  It is enough to check absolute deadlines below
+// L = min(La, Lb), where La is the Baruah bound
+// max(D_max, sum (T_i - D_i) U_i / (1 - U)) (U < 1) and Lb the
+// synchronous busy period.
+//
+// analyzeEDF() runs QPA (Zhang & Burns): starting from the last
+// deadline before L it walks t downwards, t <- dbf(t) while
+// dbf(t) < t, and usually settles in a few dozen evaluations where
+// the exhaustive test needs one per deadline.  Every evaluation is a
+// pass over the TaskTable columns, done four tasks at a time with
+// AVX2 when the CPU has it and by the scalar loop otherwise; both
+// give identical (exact integer) results.
+enum class DemandKernel {
+    Scalar,
+    AVX2,
+};
+
+// Chosen once from CPUID.  setDemandKernel() is for benchmarks and
+// cross-checks; asking for AVX2 on a CPU without it keeps Scalar.
+DemandKernel activeDemandKernel();
+void         setDemandKernel(DemandKernel kernel);
+const char*  demandKernelName(DemandKernel kernel);
+
+// dbf at one point, and at `m` points with one pass over the columns
+// per four points.
+double demandBound(const TaskTable& table, double t);
+void   demandBound(const TaskTable& table, const double* t, double* out, std::size_t m);
+
+// Latest absolute deadline strictly before t, or -1 if there is none.
+double lastDeadlineBefore(const TaskTable& table, double t);
+
+struct DemandReport {
+    const char*  method        = "qpa";
+    std::size_t  tasks         = 0;
+    double       utilization   = 0;
+    std::int64_t testLimit     = 0;    // L
+    std::int64_t witness       = -1;   // A t with dbf(t) > t, if any
+    std::int64_t witnessDemand = 0;
+    std::size_t  points        = 0;    // dbf evaluations
+    bool         schedulable   = false;
+};
+
+// Both throw std::runtime_error when L does not fit in 2^52 ticks.
+DemandReport analyzeEDF(const TaskTable& table);             // QPA
+DemandReport analyzeEDFExhaustive(const TaskTable& table);   // Every deadline < L
+
+void printDemandReport(const DemandReport& report, std::ostream& os);
+
+// ── EDF admission control ─────────────────────────────────────
+//
+// Keeps an admitted task set and accepts a new task only if the set
+// stays schedulable.  Each request is one QPA run over the table.
+class EdfAdmission {
+public:
+    bool tryAdmit(const Task& task, DemandReport* report = nullptr);
+
+    const TaskTable& table() const { return table_; }
+
+private:
+    TaskTable table_;
+};
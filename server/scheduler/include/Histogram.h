@@ -0,0 +1,101 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// ── Log-bucketed histogram ────────────────────────────────────
+//
+// Distribution of integer samples (ticks) in constant memory,
+// HDR-histogram style: magnitudes below 2 * kSubBuckets get a bucket
+// each, and every power of two above that is split into kSubBuckets
+// equal buckets, so a bucket is never wider than 1/32 of the values
+// in it.  Percentiles are exact for small values and within ~3%
+// above them, whatever the number of samples.  Negative samples
+// (early completions) get the same buckets, mirrored.
+//
+// Only buckets that were hit are stored, as (bucket, count) pairs in
+// value order: at most ~4000 for 64-bit values and ~1800 for a Tick,
+// and a handful for a task whose jobs all take about as long, so a
+// histogram per task stays cheap with many tasks.  Histograms merge
+// by adding counts, so runs split over tasks, cores or threads
+// combine without keeping their samples.
+class LogHistogram {
+public:
+    static constexpr int         kSubBucketBits = 5;
+    static constexpr std::size_t kSubBuckets    = std::size_t(1) << kSubBucketBits;
+
+    void record(std::int64_t value, std::uint64_t count = 1);
+    void merge(const LogHistogram& other);
+
+    // Adds `times` x (later - earlier), where `earlier` is a previous
+    // state of `later` (steady-state extrapolation: what one cycle
+    // recorded, counted again).  The extremes stay those of `later`.
+    void addDifference(const LogHistogram& later, const LogHistogram& earlier,
+                       std::int64_t times);
+
+    void clear();
+
+    std::uint64_t count() const { return count_; }
+    bool          empty() const { return count_ == 0; }
+    std::int64_t  min()   const { return count_ ? min_ : 0; }
+    std::int64_t  max()   const { return count_ ? max_ : 0; }
+    double        mean()  const { return count_ ? sum_ / (double)count_ : 0.0; }
+
+    // Smallest value v such that `percent`% of the samples are <= v,
+    // reported as the top of v's bucket (never above max()).
+    std::int64_t percentile(double percent) const;
+
+private:
+    // `key` orders buckets by value: kZeroKey +/- the bucket of the
+    // magnitude
+    struct Bucket {
+        std::uint32_t key;
+        std::uint64_t count;
+    };
+    static constexpr std::uint32_t kZeroKey = std::uint32_t(1) << 16;
+
+    void add(std::uint32_t key, std::uint64_t n);
+
+    static std::uint32_t keyOf(std::int64_t value);
+    static std::int64_t  topOf(std::uint32_t key);   // Value nearest +infinity
+
+    std::vector<Bucket> buckets_;   // Nonzero, by key
+    std::uint64_t       count_ = 0;
+    std::int64_t        min_   = 0;
+    std::int64_t        max_   = 0;
+    double              sum_   = 0;
+};
+
+// ── Job latency ───────────────────────────────────────────────
+//
+// What the schedulers record for every job, as it completes or is
+// dropped at its deadline (and for `jitter`, as it first runs).
+// Times are in ticks.
+struct JobLatency {
+    LogHistogram response;   // Completion - release
+    LogHistogram waiting;    // Response - execution time
+    LogHistogram lateness;   // Completion - deadline, < 0 when early
+    LogHistogram jitter;     // First dispatch - release (release jitter)
+
+    // A job released at `release` with `execution` ticks of work that
+    // completed at `completion`; deadline <= 0 means none.
+    void complete(std::int64_t release, std::int64_t execution, std::int64_t completion,
+                  std::int64_t deadline) {
+        response.record(completion - release);
+        waiting.record(completion - release - execution);
+        if (deadline > 0) lateness.record(completion - deadline);
+    }
+
+    // A job dropped at `abort` with `remaining` ticks of its work left.
+    // It is recorded as completing at abort + remaining, the earliest
+    // it could have finished, so a dropped miss lands in the tail of
+    // response and lateness instead of vanishing from them.
+    void drop(std::int64_t release, std::int64_t execution, std::int64_t remaining,
+              std::int64_t abort, std::int64_t deadline) {
+        complete(release, execution, abort + remaining, deadline);
+    }
+
+    void merge(const JobLatency& other);
+    void addDifference(const JobLatency& later, const JobLatency& earlier, std::int64_t times);
+    void clear();
+};
@@ -0,0 +1,58 @@
+#pragma once
+#include "Algorithms/RoundRobin.h"
+#include "Clock.h"
+#include "Scheduler.h"
+#include "Task.h"
+#include <cstddef>
+#include <vector>
+
+// ── Incremental re-simulation ─────────────────────────────────
+//
+// Keeps the last run so that editing one task does not replay the
+// whole workload.  When a request has the same options and differs
+// from the previous one in a single task, only what that task can
+// change is simulated again:
+//
+//   parameters the policy ignores (name, priority, ... see Task.h)
+//                  the result is patched in place
+//   FCFS           tasks run in arrival order; the schedule is kept
+//                  up to the first task at or after the edited one,
+//                  old or new position
+//   Round Robin    resumes from the last checkpoint (RRCheckpoint)
+//                  taken before the edited task arrived, or, for a
+//                  burst edit, before its first slice that is not a
+//                  whole quantum in both versions
+//
+// Anything else (a second edit, other options, another policy, a
+// changed period or deadline under EDF, where every task releases at
+// t = 0) is a full run.  Results are the same as runScheduler()'s.
+//
+// A partial run cannot replay the trace of the part it keeps, so
+// with a trace sink listening every run is a full one.
+class IncrementalScheduler {
+public:
+    // Throws like runScheduler(); the result stays valid until the
+    // next call.
+    const ScheduleResult& run(const SchedulerConfig& config, std::vector<Task> tasks);
+
+    // Of the last run(): first simulated tick, 0 for a full run and
+    // kNever when the result was only patched.
+    Tick resumedAt() const { return resumedAt_; }
+
+private:
+    const ScheduleResult& fullRun(const SchedulerConfig& config, std::vector<Task> tasks);
+    bool editFCFS(std::size_t k, const Task& edited);
+    bool editRR(std::size_t k, const Task& edited);
+    void patch(std::size_t position, const Task& edited, unsigned changed);
+
+    std::size_t sortedPosition(std::size_t k, Tick arrival) const;
+    void        moveTask(std::size_t from, std::size_t to);
+
+    bool                      valid_ = false;
+    SchedulerConfig           config_;
+    std::vector<Task>         input_;         // Tasks of the last run, as given
+    ScheduleResult            result_;
+    std::vector<RRCheckpoint> checkpoints_;   // Round Robin
+    RRScheduler               rr_{1};         // Kept for its buffers
+    Tick                      resumedAt_ = 0;
+};
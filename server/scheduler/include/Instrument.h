@@ -0,0 +1,181 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+// ── Run instrumentation ───────────────────────────────────────
+//
+// Where a scheduler run spends its time.  The scheduler loops mark
+// phases with RTOS_PHASE and events with RTOS_COUNT:
+//
+//   * Both are removed at compile time with -DRTOS_INSTRUMENT=0
+//     (the CMake option of the same name).
+//   * Otherwise they cost a thread-local load and a branch until a
+//     RunProfiler is installed on the current thread.
+//
+// Phase time is exclusive: a phase entered inside another stops the
+// outer one's clock, so the phases add up to at most the run's total
+// and the rest is loop bookkeeping.  Times are ticks of
+// instrument::now(), the TSC on x86 and nanoseconds elsewhere; the
+// profile carries the wall time to convert them.  Counters count the
+// work done: cycles extrapolated by EDF's steady-state detection are
+// not in them.
+//
+// A RunProfiler also reads the CPU's counters for the run through
+// perf_event_open on Linux, when the kernel lets this process.
+
+#ifndef RTOS_INSTRUMENT
+#define RTOS_INSTRUMENT 1
+#endif
+
+enum class Phase : int {
+    Release,    // Arrival / release scanning
+    Queue,      // Ready-queue pushes and pops
+    Deadline,   // Deadline checks
+    Output,     // Trace lines and records, Gantt segments
+};
+constexpr int kPhaseCount = 4;
+
+enum class Counter : int {
+    Releases,      // Jobs or tasks made ready
+    Dispatches,    // Picks of a job to run
+    Preemptions,   // A job with work left gave way to another
+    QueuePushes,
+    QueuePops,
+    Completions,
+    DeadlineMisses,
+};
+constexpr int kCounterCount = 7;
+
+const char* phaseName(Phase phase);
+const char* counterName(Counter counter);
+
+// perf_event_open counts for the run's thread, user space only;
+// -1 where the counter could not be opened.
+struct HardwareCounters {
+    std::int64_t instructions = -1;
+    std::int64_t cycles       = -1;
+    std::int64_t cacheMisses  = -1;
+    std::int64_t branchMisses = -1;
+};
+
+struct RunProfile {
+    std::uint64_t                             totalTicks = 0;   // The whole run
+    std::uint64_t                             wallNanos  = 0;
+    std::array<std::uint64_t, kPhaseCount>    phaseTicks{};
+    std::array<std::uint64_t, kPhaseCount>    phaseCalls{};
+    std::array<std::uint64_t, kCounterCount>  counters{};
+    HardwareCounters                          hardware;
+
+    // Exclusive phase timing (instrument::PhaseScope)
+    int           active = -1;   // Phase whose clock runs, -1 = none
+    std::uint64_t since  = 0;
+
+    std::uint64_t count(Counter c) const { return counters[(int)c]; }
+    std::uint64_t ticks(Phase p)   const { return phaseTicks[(int)p]; }
+};
+
+namespace instrument {
+
+constexpr bool kCompiled = RTOS_INSTRUMENT != 0;
+
+// "tsc" or "ns": the unit of RunProfile's ticks
+const char* clockName();
+
+inline std::uint64_t now() {
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+inline thread_local RunProfile* current = nullptr;
+
+// Charges the scope's time to `phase`, pausing the phase it is
+// nested in.
+class PhaseScope {
+public:
+    explicit PhaseScope(Phase phase) {
+        if constexpr (kCompiled) {
+            profile_ = current;
+            if (__builtin_expect(profile_ == nullptr, 1)) return;
+            const std::uint64_t t = now();
+            if (profile_->active >= 0) profile_->phaseTicks[profile_->active] += t - profile_->since;
+            outer_           = profile_->active;
+            profile_->active = (int)phase;
+            profile_->since  = t;
+            ++profile_->phaseCalls[(int)phase];
+        }
+    }
+    ~PhaseScope() {
+        if constexpr (kCompiled) {
+            if (__builtin_expect(profile_ == nullptr, 1)) return;
+            const std::uint64_t t = now();
+            profile_->phaseTicks[profile_->active] += t - profile_->since;
+            profile_->active = outer_;
+            profile_->since  = t;
+        }
+    }
+    PhaseScope(const PhaseScope&) = delete;
+    PhaseScope& operator=(const PhaseScope&) = delete;
+
+private:
+    RunProfile* profile_ = nullptr;
+    int         outer_   = -1;
+};
+
+} // namespace instrument
+
+// ── Profiler ──────────────────────────────────────────────────
+//
+// Profiles whatever the current thread runs between construction and
+// finish(): installs its RunProfile for the macros and starts the
+// clocks and the hardware counters.
+class RunProfiler {
+public:
+    RunProfiler();
+    ~RunProfiler();
+    RunProfiler(const RunProfiler&) = delete;
+    RunProfiler& operator=(const RunProfiler&) = delete;
+
+    // Stops counting and uninstalls; call once.
+    const RunProfile& finish();
+
+private:
+    static constexpr int kHardwareEvents = 4;
+
+    RunProfile                            profile_;
+    RunProfile*                           outer_;
+    bool                                  running_ = true;
+    std::array<int, kHardwareEvents>      fds_;   // Group leader first, -1 = closed
+    std::chrono::steady_clock::time_point startWall_;
+};
+
+// Phase and counter table, then the hardware counts.
+void printProfile(const RunProfile& profile, const std::string& title,
+                  std::ostream& os = std::cout);
+
+// ── Instrumentation points ────────────────────────────────────
+
+#define RTOS_INSTRUMENT_CAT2(a, b) a##b
+#define RTOS_INSTRUMENT_CAT(a, b)  RTOS_INSTRUMENT_CAT2(a, b)
+
+// Times the rest of the enclosing scope as `phase`.
+#define RTOS_PHASE(phase)                                                  \
+    instrument::PhaseScope RTOS_INSTRUMENT_CAT(rtos_phase_, __LINE__)(phase)
+
+#define RTOS_COUNT(counter, n)                                             \
+    do {                                                                   \
+        if constexpr (instrument::kCompiled) {                             \
+            RunProfile* rtos_profile_ = instrument::current;               \
+            if (__builtin_expect(rtos_profile_ != nullptr, 0))             \
+                rtos_profile_->counters[(int)(counter)] += (n);            \
+        }                                                                  \
+    } while (0)
@@ -0,0 +1,134 @@
+#pragma once
+#include "Instrument.h"
+#include "Scheduler.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+// ── Buffered output ───────────────────────────────────────────
+//
+// Fixed-size buffer in front of a file descriptor, or in front of a
+// string for the `--serve` response.  The fd path never allocates:
+// numbers are formatted by hand into the buffer, and a full buffer
+// is written out and reused.  flush() throws std::runtime_error on
+// a write error; the destructor flushes quietly.
+class BufferedWriter {
+public:
+    explicit BufferedWriter(int fd) : fd_(fd) {}
+    explicit BufferedWriter(std::string& out) : out_(&out) {}
+    ~BufferedWriter();
+
+    BufferedWriter(const BufferedWriter&)            = delete;
+    BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+    void put(char c) {
+        if (len_ == kCapacity) drain();
+        buf_[len_++] = c;
+    }
+    void write(const char* p, std::size_t n);
+    void write(std::string_view s) { write(s.data(), s.size()); }
+
+    void writeInt(long long v);
+    void writeFixed(double v, int decimals);   // NaN / inf -> "null"
+    void writeI32LE(std::int32_t v);
+    void writeU32LE(std::uint32_t v);
+
+    void flush();
+
+private:
+    static constexpr std::size_t kCapacity = 1 << 16;
+
+    void drain();
+
+    int          fd_  = -1;
+    std::string* out_ = nullptr;
+    std::size_t  len_ = 0;
+    char         buf_[kCapacity];
+};
+
+// ── JSON writer ───────────────────────────────────────────────
+//
+// Streaming writer: commas and key/value separators are tracked
+// with one bit per nesting level, so there is no document tree and
+// nothing to allocate.  Nesting deeper than 64 levels is a bug.
+class JsonWriter {
+public:
+    explicit JsonWriter(BufferedWriter& out) : out_(out) {}
+
+    void beginObject() { open('{'); }
+    void endObject()   { close('}'); }
+    void beginArray()  { open('['); }
+    void endArray()    { close(']'); }
+
+    void key(std::string_view k);
+
+    void value(long long v)        { separator(); out_.writeInt(v); }
+    void value(int v)              { value((long long)v); }
+    void value(double v)           { separator(); out_.writeFixed(v, 3); }
+    void value(bool v)             { separator(); out_.write(v ? "true" : "false"); }
+    void value(std::string_view v) { separator(); string(v); }
+    void value(const char* v)      { value(std::string_view(v)); }
+    void null()                    { separator(); out_.write("null"); }
+
+private:
+    void open(char c);
+    void close(char c);
+    void separator();
+    void string(std::string_view s);
+
+    BufferedWriter& out_;
+    std::uint64_t   hasItem_  = 0;   // Bit d: level d already has an element
+    int             depth_    = 0;
+    bool            afterKey_ = false;
+};
+
+// ── Result exporters ──────────────────────────────────────────
+//
+// JSON: one object, written front to back straight from the result.
+// The Gantt chart comes first and is columnar, so a client can start
+// drawing before the task table arrives:
+//
+//   { "policy": "rr",
+//     "gantt":   { "task": [...], "start": [...], "end": [...],
+//                  "labels": { "1": "A", ... } },
+//     "tasks":   [ { "id": 1, "name": "A", ... }, ... ],
+//     "summary": { "clock": ..., "busy": ..., ...,
+//                  "latency": LATENCY },
+//     "jobs":    [ { "id": 1, "jobs": ..., "misses": ...,
+//                    "worstResponse": ..., "avgResponse": ...,
+//                    "latency": LATENCY }, ... ],
+//     "steadyState": { "cycleStart": ..., "cycleLength": ...,
+//                      "cyclesSkipped": ... },
+//     "profile": { "clock": "tsc", "ticks": ..., "wallNs": ...,
+//                  "phases":   { "release": { "ticks", "calls" }, ... },
+//                  "counters": { "releases": ..., "dispatches": ..., ... },
+//                  "hardware": { "instructions", "cycles",
+//                                "cacheMisses", "branchMisses" } } }
+//
+//   LATENCY = { "response": H, "waiting": H, "lateness": H, "jitter": H }
+//   H       = { "count", "mean", "min", "p50", "p90", "p99", "p999", "max" }
+//
+// "jobs" is present for periodic policies and "steadyState" when the
+// run found its schedule repeating (see ScheduleResult).  Latency
+// percentiles come from JobLatency's histograms (Histogram.h).
+// "profile" is written when one is passed (Instrument.h); "hardware"
+// is null when perf_event_open was refused, and so is a counter the
+// CPU does not have.
+//
+// Segment task ids use kIdleTask (-1), kContextSwitchTask (-2) and
+// kSkippedTask (-3), the stretch a steady-state run extrapolated.
+void exportJson(const ScheduleResult& res, const char* policy, BufferedWriter& out,
+                const RunProfile* profile = nullptr);
+
+// Binary Gantt ("RTGB"), little-endian, every field 4-byte aligned so
+// the columns map straight onto Int32Array views:
+//
+//   offset  0   "RTGB"
+//           4   u32 version (1)
+//           8   u32 segment count S
+//          12   u32 label count L
+//          16   i32 task[S], i32 start[S], i32 end[S]
+//               L x { i32 task, u32 byte length n, n bytes UTF-8,
+//                     zero padding to a multiple of 4 }
+void exportGanttBinary(const ScheduleResult& res, BufferedWriter& out);
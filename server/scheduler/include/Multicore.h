@@ -0,0 +1,87 @@
+#pragma once
+#include "Analysis.h"
+#include "Clock.h"
+#include "Histogram.h"
+#include "SegmentTrace.h"
+#include "Task.h"
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// ── Multiprocessor scheduling ─────────────────────────────────
+//
+// Periodic tasks on M identical simulated cores.  Each task releases
+// a job every `period` ticks from `arrivalTime`, with WCET burstTime
+// and deadline relativeDeadline (0 = period).  As in EDFScheduler, a
+// job still unfinished at its deadline counts as a miss and is
+// dropped.  Jobs of one task run in release order, never two at once.
+//
+//   gedf   global EDF: the M earliest deadlines run, jobs migrate
+//   gfp    global fixed priority (order from --order, default RM)
+//   pedf   partitioned EDF: tasks bin-packed onto cores, admitted
+//          with the QPA test, then one EDF scheduler per core
+//   prm    partitioned fixed priority (RM by default), admitted with
+//          response-time analysis
+//
+// Packing sorts tasks by utilization, largest first, and places each
+// on the first core (first-fit decreasing) or the least-loaded core
+// (worst-fit decreasing) whose admission test still passes.  Tasks
+// that fit nowhere are reported and not simulated.
+//
+// The engine is event driven and never scans the cores: ready jobs
+// sit in a min-heap on priority, running jobs in a max-heap so the
+// preemption victim is at the top, and completions and deadlines are
+// calendars.  Entries that went stale (a job preempted, finished or
+// dropped) are skipped when they surface, so every dispatch is
+// O(log n) whatever the core count.
+enum class MulticorePolicy {
+    GlobalEDF,
+    GlobalFP,
+    PartitionedEDF,
+    PartitionedFP,
+};
+
+enum class BinPacking {
+    FirstFitDecreasing,
+    WorstFitDecreasing,
+};
+
+const char* multicorePolicyName(MulticorePolicy policy);
+bool        parseMulticorePolicy(const std::string& name, MulticorePolicy& policy);
+bool        parseBinPacking(const std::string& name, BinPacking& packing);
+
+struct MulticoreConfig {
+    MulticorePolicy policy  = MulticorePolicy::GlobalEDF;
+    int             cores   = 2;
+    BinPacking      packing = BinPacking::FirstFitDecreasing;
+    PriorityOrder   order   = PriorityOrder::RateMonotonic;   // gfp / prm
+    Tick            horizon = 0;                              // 0 = hyperperiod
+};
+
+struct MulticoreTaskStats {
+    int        core         = -1;   // Partitioned: assigned core (-1 = did not fit)
+    int        jobs         = 0;    // Completed
+    int        misses       = 0;
+    Tick       worstResponse = 0;
+    JobLatency latency;
+};
+
+struct MulticoreResult {
+    std::vector<SegmentTrace>       cores;       // One Gantt per core
+    std::vector<Tick>               busy;        // Per core
+    std::vector<MulticoreTaskStats> tasks;       // Same order as the input
+    JobLatency                      latency;     // The tasks', merged
+    Tick horizon        = 0;
+    int  jobsCompleted  = 0;
+    int  deadlineMisses = 0;
+    int  preemptions    = 0;
+    int  migrations     = 0;   // A job resuming on a different core
+    int  unassigned     = 0;   // Partitioned: tasks left out
+};
+
+// Throws std::invalid_argument for tasks without a period or cores < 1.
+MulticoreResult runMulticore(const MulticoreConfig& config, const std::vector<Task>& tasks);
+
+void printMulticore(const MulticoreResult& res, const std::vector<Task>& tasks,
+                    const MulticoreConfig& config, bool gantt, std::ostream& os);
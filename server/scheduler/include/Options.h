@@ -0,0 +1,58 @@
+#pragma once
+#include "Scheduler.h"
+#include "Trace.h"
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// ── Run options ───────────────────────────────────────────────
+//
+// One simulation request as written on the command line:
+//
+//   <policy> [--quantum N] [--cs N] [--aging N] [--feedback]
+//            [--horizon N] [--exact] [--trace LEVEL] [--no-gantt]
+//            [--format text|json|binary] [--window A:B [--checkpoint N]]
+//            [--profile]
+//
+// --window reports only ticks [A, B) of the run, through a Timeline
+// (Timeline.h) checkpointed every N ticks.  --profile adds the run's
+// phase times and counters (Instrument.h) to the report.  --quantum
+// and --checkpoint must be positive, --cs, --aging and --horizon
+// non-negative, and a window 0 <= A < B; parseArgs() rejects anything
+// else (including non-numeric text) rather than run a schedule that
+// cannot make progress.
+//
+// Shared by the one-shot CLI, `--serve` and `--batch`.
+enum class OutputFormat {
+    Text,     // Gantt chart and metrics table
+    Json,     // exportJson()
+    Binary,   // exportGanttBinary()
+};
+
+struct RunOptions {
+    SchedulerConfig config;
+    TraceLevel      traceLevel = TraceLevel::Tick;
+    bool            gantt      = true;
+    OutputFormat    format     = OutputFormat::Text;
+    Tick            windowFrom = 0;
+    Tick            windowTo   = 0;   // 0 = the whole run
+    Tick            checkpoint = 0;   // Timeline interval, 0 = automatic
+    bool            profile    = false;
+};
+
+bool parseTraceLevel(const std::string& s, TraceLevel& level);
+
+// "<policy> [options]" -> RunOptions; throws std::invalid_argument.
+RunOptions parseArgs(const std::vector<std::string>& args);
+
+// Task lines, one per line ('#' starts a comment):
+//
+//   id name arrival burst [priority [period [deadline]]]
+//
+// `deadline` is relative to each release when period > 0 and an
+// absolute hard deadline otherwise.  Lines that do not start with a
+// number (e.g. the `cs` lines of ResourceManager.h and the `body`
+// lines of TaskBody.h) are skipped.
+// Appends to `tasks` (callers clear() it, keeping its capacity);
+// throws std::runtime_error.
+void readTasks(std::istream& in, std::vector<Task>& tasks);
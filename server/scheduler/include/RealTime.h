@@ -0,0 +1,100 @@
+#pragma once
+#include "Analysis.h"
+#include "Clock.h"
+#include "Histogram.h"
+#include "Scheduler.h"
+#include "Task.h"
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// ── Real execution ────────────────────────────────────────────
+//
+// Runs a periodic task set on Linux threads instead of simulating
+// it, to see what the machine adds to the schedule: wake-up latency,
+// release jitter and overruns.  Every task is one thread:
+//
+//   * Job k is released at start + (arrival + k * period) ticks,
+//     with clock_nanosleep(TIMER_ABSTIME) on CLOCK_MONOTONIC.  A job
+//     still running at its next release delays that one (an
+//     overrun), as a backlog does in the simulators.
+//   * A job busy-loops for its burstTime, in spin iterations
+//     calibrated once per run against the thread CPU clock.
+//   * The loop looks at the clock every few microseconds.  A gap
+//     between two looks means the thread was preempted, so each
+//     thread records the intervals it actually ran.  Merged, they
+//     give the Gantt chart.
+//
+// Scheduling classes:
+//
+//   fifo       SCHED_FIFO, priorities by rank in the PriorityOrder
+//              (rank 0 highest; ranks past the 98 distinct levels
+//              share the lowest)
+//   deadline   SCHED_DEADLINE with runtime = WCET, deadline = D,
+//              period = T, i.e. the kernel runs EDF
+//   other      SCHED_OTHER, the default time-sharing class
+//
+// fifo and deadline need CAP_SYS_NICE (or root).  Without it the
+// run falls back to other and says why.  All threads are pinned to
+// one CPU so the run is comparable with the one-core simulators;
+// the kernel refuses affinity for deadline threads, which then
+// float.
+enum class RealTimeClass {
+    Fifo,
+    Deadline,
+    Other,
+};
+
+const char* realTimeClassName(RealTimeClass cls);
+bool        parseRealTimeClass(const std::string& name, RealTimeClass& cls);
+
+struct RealConfig {
+    RealTimeClass cls        = RealTimeClass::Fifo;
+    PriorityOrder order      = PriorityOrder::RateMonotonic;   // fifo priorities
+    Tick          horizon    = 0;      // 0 = hyperperiod, at most 10 s
+    int           tickMicros = 1000;   // Length of one tick
+    int           cpu        = 0;      // -1 = do not pin
+};
+
+struct RealTaskStats {
+    std::int64_t overruns = 0;   // Jobs still running at their next release
+    // Release to the thread running, in nanoseconds, over the jobs
+    // not delayed by an overrun.  For the highest-priority task that
+    // is the kernel's wake-up latency; for the others it also holds
+    // the interference the simulators predict.
+    LogHistogram wakeup;
+};
+
+struct RealResult {
+    // The simulators' result type, in ticks: one JobStats per task
+    // (jitter = start - release, rounded to ticks), the observed
+    // Gantt chart, busy time and deadline misses.
+    ScheduleResult schedule;
+
+    std::vector<RealTaskStats> tasks;    // Same order as the input
+    LogHistogram               wakeup;   // The tasks', merged
+    Tick          horizon       = 0;
+    std::int64_t  overruns      = 0;
+    RealTimeClass granted       = RealTimeClass::Other;   // After any fallback
+    std::string   fallback;                               // Why, empty if none
+    int           refused       = 0;   // Threads the kernel left in other
+    bool          pinned        = false;
+    double        spinsPerMicro = 0;
+};
+
+// Blocks for the horizon plus start-up.  Throws std::invalid_argument
+// for tasks without a period and std::runtime_error when a thread
+// cannot be created.
+RealResult runReal(const RealConfig& config, const std::vector<Task>& tasks);
+
+// What the simulators predict for the same run, one JobStats per
+// task: simulateResources() with no sections for fifo and other, and
+// global EDF on one core for deadline.  Both release each task first
+// at its arrivalTime, like runReal().
+std::vector<JobStats> predictReal(const RealConfig& config, const std::vector<Task>& tasks,
+                                  Tick horizon);
+
+// Run setup, then predicted and observed per task side by side.
+void printRealReport(const RealResult& res, const std::vector<JobStats>& predicted,
+                     const RealConfig& config, bool gantt, std::ostream& os);
@@ -0,0 +1,48 @@
+#pragma once
+#include "Clock.h"
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+// ── Release calendar ──────────────────────────────────────────
+//
+// Min-heap of pending job releases keyed on (time, task index).
+// Schedulers pop only the releases that are due, so the cost per
+// event is O(r log n) for r releases instead of a scan over every
+// task.  Releases at the same tick come out in task order.
+class ReleaseCalendar {
+public:
+    struct Release {
+        Tick time;
+        int  task;
+    };
+
+    void reserve(std::size_t n) { heap_.reserve(n); }
+
+    void schedule(Tick time, int task) {
+        heap_.push_back({time, task});
+        std::push_heap(heap_.begin(), heap_.end(), Later{});
+    }
+
+    bool due(Tick now) const { return !heap_.empty() && heap_.front().time <= now; }
+
+    Release pop() {
+        std::pop_heap(heap_.begin(), heap_.end(), Later{});
+        Release r = heap_.back();
+        heap_.pop_back();
+        return r;
+    }
+
+    Tick        nextTime() const { return heap_.empty() ? kNever : heap_.front().time; }
+    bool        empty()    const { return heap_.empty(); }
+    std::size_t size()     const { return heap_.size(); }
+
+private:
+    struct Later {
+        bool operator()(const Release& a, const Release& b) const {
+            return a.time != b.time ? a.time > b.time : a.task > b.task;
+        }
+    };
+
+    std::vector<Release> heap_;
+};
@@ -0,0 +1,175 @@
+#pragma once
+#include "Analysis.h"
+#include "Clock.h"
+#include "SegmentTrace.h"
+#include "Task.h"
+#include <climits>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// ── Shared resources ──────────────────────────────────────────
+//
+// Periodic tasks that lock shared resources (mutexes) while they
+// run.  A critical section is a line in the task file:
+//
+//   cs <task id> <resource> <offset> <length>
+//
+// meaning every job of the task locks `resource` after executing
+// `offset` ticks and unlocks it `length` ticks of execution later.
+// Sections of one task may nest but not overlap, and must end within
+// the WCET.  readTasks() skips these lines, so one file serves every
+// mode.
+//
+// Priorities are fixed (smaller = higher), by rank in the chosen
+// PriorityOrder.  The lock protocols are
+//
+//   none   plain mutex: a blocked job waits for the holder at the
+//          holder's own priority, so medium-priority work can
+//          stretch the inversion without limit
+//   pip    priority inheritance: the holder runs at the highest
+//          priority of the jobs it blocks (transitively)
+//   ipcp   immediate priority ceiling: locking raises the holder to
+//          the resource's ceiling, the highest priority of any task
+//          that uses it; on one core a lock then never blocks
+enum class LockProtocol {
+    None,
+    Inheritance,
+    ImmediateCeiling,
+};
+
+const char* lockProtocolName(LockProtocol protocol);
+bool        parseLockProtocol(const std::string& name, LockProtocol& protocol);
+
+struct CriticalSection {
+    int taskId   = 0;
+    int resource = 0;
+    int offset   = 0;
+    int length   = 0;
+};
+
+// Appends the `cs` lines of a task file; throws std::runtime_error.
+void readCriticalSections(std::istream& in, std::vector<CriticalSection>& sections);
+
+// ── Resource manager ──────────────────────────────────────────
+//
+// Tracks who holds each resource, who waits for it and the
+// effective priority of every job.  Jobs are small integer slots
+// chosen by the caller.  Ceilings come from a per-resource table and
+// the system ceiling (the highest ceiling of all locked resources)
+// from the top of a stack, so both lookups are O(1).
+//
+// acquire() and release() report the jobs whose effective priority
+// changed in changed(), so a scheduler can re-key only those.
+class ResourceManager {
+public:
+    static constexpr int kNoCeiling = INT_MAX;
+
+    ResourceManager(LockProtocol protocol, int resources, int jobs);
+
+    LockProtocol protocol() const { return protocol_; }
+
+    // Ceiling table: the highest priority that ever locks `resource`.
+    void declareUse(int resource, int priority);
+    int  ceiling(int resource) const { return ceiling_[resource]; }
+    int  systemCeiling() const { return stack_.empty() ? kNoCeiling : stack_.back().ceiling; }
+    int  locked()        const { return (int)stack_.size(); }
+
+    void attach(int job, int priority);   // Job starts with nothing held
+    void detach(int job);                 // Throws if it still holds a resource
+
+    int  priority(int job)     const { return effective_[job]; }
+    int  basePriority(int job) const { return base_[job]; }
+    int  holder(int resource)  const { return holder_[resource]; }
+    int  blockedOn(int job)    const { return blockedOn_[job]; }
+
+    // true: `job` now holds `resource`.  false: it is blocked on it.
+    // Throws std::runtime_error on a deadlock.
+    bool acquire(int job, int resource);
+
+    // Unlocks and appends every waiter to `woken`.  The resource is
+    // not handed over: waiters try again when they next run, so a
+    // lower-priority waiter cannot take it ahead of a job that
+    // arrived since (the blocking bounds rely on that).
+    void release(int job, int resource, std::vector<int>& woken);
+
+    const std::vector<int>& changed() const { return changed_; }
+    void                    clearChanged()  { changed_.clear(); }
+
+private:
+    struct CeilingEntry {
+        int resource;
+        int ceiling;   // min(ceiling below, ceiling(resource))
+    };
+
+    void grant(int job, int resource);
+    void recompute(int job);
+    void setPriority(int job, int priority);
+
+    LockProtocol protocol_;
+
+    std::vector<int>              ceiling_;     // Per resource
+    std::vector<int>              holder_;      // Per resource, -1 = free
+    std::vector<std::vector<int>> waiters_;     // Per resource
+    std::vector<CeilingEntry>     stack_;       // System ceiling
+
+    std::vector<int>              base_;        // Per job
+    std::vector<int>              effective_;   // Per job
+    std::vector<int>              blockedOn_;   // Per job, -1 = not blocked
+    std::vector<std::vector<int>> held_;        // Per job, in lock order
+
+    std::vector<int> changed_;
+};
+
+// ── Simulation and bounds ─────────────────────────────────────
+struct ResourceConfig {
+    LockProtocol  protocol = LockProtocol::Inheritance;
+    PriorityOrder order    = PriorityOrder::RateMonotonic;
+    Tick          horizon  = 0;   // 0 = hyperperiod
+};
+
+struct BlockingStats {
+    int          jobs          = 0;   // Completed
+    int          misses        = 0;
+    Tick         worstResponse = 0;
+    std::int64_t blocking      = 0;   // Total over all jobs
+    Tick         worstBlocking = 0;   // Longest for one job
+    std::int64_t bound         = 0;   // Analytical, -1 = unbounded
+};
+
+struct ResourceResult {
+    SegmentTrace               gantt;
+    std::vector<BlockingStats> tasks;   // Same order as the input
+    Tick horizon         = 0;
+    int  deadlineMisses  = 0;
+    int  preemptions     = 0;
+    int  blocks          = 0;   // Lock requests that had to wait
+    int  maxLockDepth    = 0;   // Deepest system-ceiling stack
+};
+
+// Blocking bound per task (input order) for `protocol`:
+//
+//   pip    min(sum over lower tasks of their longest section on a
+//              resource with ceiling >= P_i,
+//              sum over such resources of the longest lower section)
+//   ipcp   the single longest such section
+//   none   unbounded (-1) whenever pip would be > 0
+//
+// For pip and none, a resource locked inside a section on another
+// takes the outer resource's ceiling when that is higher (chained
+// blocking).
+// Throws std::invalid_argument for malformed sections.
+std::vector<std::int64_t> blockingBounds(const std::vector<Task>& tasks,
+                                         const std::vector<CriticalSection>& sections,
+                                         LockProtocol protocol, PriorityOrder order);
+
+// Preemptive fixed-priority simulation on one core; each task first
+// releases at its arrivalTime.  Jobs of one task run in release order; a
+// late job keeps running and counts as a miss.  A job is blocked
+// while a lower-priority job runs and it is pending.
+ResourceResult simulateResources(const ResourceConfig& config, const std::vector<Task>& tasks,
+                                 const std::vector<CriticalSection>& sections);
+
+void printResourceReport(const ResourceResult& res, const std::vector<Task>& tasks,
+                         const ResourceConfig& config, bool gantt, std::ostream& os);
@@ -0,0 +1,136 @@
+#pragma once
+#include "Task.h"
+#include "Histogram.h"
+#include "SegmentTrace.h"
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ── Scheduling policies ───────────────────────────────────────
+enum class Policy {
+    FCFS,
+    RoundRobin,
+    SJF,
+    SRTF,
+    Priority,
+    PreemptivePriority,
+    Multilevel,
+    RateMonotonic,
+    EDF,
+};
+
+const char* policyName(Policy policy);
+bool        parsePolicy(const std::string& name, Policy& policy);
+
+struct SchedulerConfig {
+    Policy policy        = Policy::FCFS;
+    int    quantum       = 2;       // RR, Multilevel
+    int    csPenalty     = 1;       // FCFS, RR
+    int    agingInterval = 0;       // Multilevel
+    bool   feedback      = false;   // Multilevel
+    int    horizon       = 0;       // EDF: simulated ticks, 0 = hyperperiod
+    bool   steadyState   = true;    // EDF: extrapolate once the schedule repeats
+};
+
+// ── Result shared by every algorithm ──────────────────────────
+
+// Periodic policies (EDF): one entry per task, over every job that
+// completed or missed its deadline within the horizon.
+struct JobStats {
+    std::int64_t jobs          = 0;   // Completed
+    std::int64_t misses        = 0;
+    Tick         worstResponse = 0;
+    std::int64_t totalResponse = 0;   // Over completed jobs
+    JobLatency   latency;             // Completed and dropped jobs; jitter at first run
+};
+
+// Set when a periodic run found its schedule repeating: the cycle
+// [cycleStart, cycleStart + cycleLength) was counted `cyclesSkipped`
+// more times instead of being simulated.  The Gantt chart has one
+// kSkippedTask segment of cyclesSkipped * cycleLength ticks there.
+struct SteadyState {
+    Tick         cycleStart    = 0;
+    Tick         cycleLength   = 0;   // 0 = no repeat found
+    std::int64_t cyclesSkipped = 0;
+};
+
+struct ScheduleResult {
+    std::vector<Task> tasks;
+    SegmentTrace      gantt;
+    int totalClockTime   = 0;
+    int totalBusyTime    = 0;
+    int contextSwitches  = 0;
+    int deadlineMisses   = 0;
+
+    std::vector<JobStats> jobs;     // Periodic policies, same order as tasks
+    SteadyState           steady;
+    JobLatency            latency;  // Every job: the tasks, or `jobs` merged
+};
+
+// Every run starts from the task parameters only.
+inline void resetRunState(Task& t) {
+    t.remainingTime  = t.burstTime;
+    t.startTime      = -1;
+    t.completionTime = 0;
+    t.turnaroundTime = 0;
+    t.waitingTime    = 0;
+    t.deadlineMissed = false;
+    t.completed      = false;
+}
+
+inline void resetRunState(std::vector<Task>& tasks) {
+    for (auto& t : tasks) resetRunState(t);
+}
+
+// ── Policy-based scheduler ────────────────────────────────────
+//
+// Each algorithm is a Derived class providing
+//
+//     ScheduleResult schedule(std::vector<Task> tasks);
+//
+// and is reached through SchedulerBase<Derived>::run().  The call is
+// resolved at compile time, so nothing on the hot path goes through
+// a virtual function; the only run-time choice is the single switch
+// in runScheduler().
+template <class Derived>
+class SchedulerBase {
+public:
+    ScheduleResult run(std::vector<Task> tasks) {
+        resetRunState(tasks);
+        return static_cast<Derived&>(*this).schedule(std::move(tasks));
+    }
+};
+
+ScheduleResult runScheduler(const SchedulerConfig& config, std::vector<Task> tasks);
+
+// Gantt labels from the task names in one pass; unnamed tasks show
+// their id.
+void labelTasks(SegmentTrace& trace, const std::vector<Task>& tasks);
+
+// One-shot policies: every completed task is one job.  Fills
+// res.latency from the task records.
+void recordLatency(ScheduleResult& res);
+
+// Stable sort by arrival time that orders (arrival, position) keys
+// and then moves every task once, instead of swapping whole Tasks.
+void sortByArrival(std::vector<Task>& tasks);
+
+// Default horizon of the periodic simulators (EDF, multicore,
+// resources, bodies): the hyperperiod, clamped to the Tick range.
+Tick hyperperiodTicks(const std::vector<Task>& tasks);
+
+// EDF input, shared with Timeline: throws std::invalid_argument for a
+// task without a period, fills implicit deadlines (D = T) and returns
+// the hyperperiod, clamped to the Tick range.
+int preparePeriodicTasks(std::vector<Task>& tasks);
+
+void printGantt(const ScheduleResult& res, const std::string& title,
+                std::ostream& os = std::cout);
+void printMetrics(const ScheduleResult& res, const std::string& title,
+                  std::ostream& os = std::cout);
+// Percentiles of each JobLatency histogram; prints nothing when no
+// job ran.
+void printLatency(const JobLatency& latency, const std::string& title,
+                  std::ostream& os = std::cout);
@@ -0,0 +1,92 @@
+#pragma once
+#include "Clock.h"
+#include "Instrument.h"
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+// ── Execution trace ───────────────────────────────────────────
+//
+// Every scheduler records what the CPU did as (task, start, end)
+// runs instead of one entry per tick or a label string per Gantt
+// box.  Segments hold only the integer task id; display labels are
+// stored once per task, in one array sorted by id (no node per
+// task).  Conversions to the older per-tick vector (RM_Schedule)
+// and GanttEntry list (FCFS / RR) are provided for callers that
+// still want them.
+
+constexpr int kIdleTask          = -1;   // same marker RM_Schedule uses
+constexpr int kContextSwitchTask = -2;
+// Stretch that steady-state detection extrapolated instead of
+// simulating (EDF.h): the CPU ran whole repeating cycles there, so
+// renderers draw it as a break rather than as idle or to scale.
+constexpr int kSkippedTask       = -3;
+
+struct Segment {
+    int  task;
+    Tick start;
+    Tick end;
+
+    Tick length() const { return end - start; }
+};
+
+struct GanttEntry {
+    std::string label;
+    int start;
+    int end;
+};
+
+class SegmentTrace {
+public:
+    using const_iterator = std::vector<Segment>::const_iterator;
+
+    // Always starts a new segment (keeps slice boundaries, e.g. RR).
+    // Timed as Phase::Output, like extend().
+    void append(int task, Tick start, Tick end) {
+        RTOS_PHASE(Phase::Output);
+        segments_.push_back({task, start, end});
+    }
+
+    // Grows the last segment when it is the same task and contiguous.
+    void extend(int task, Tick start, Tick end) {
+        RTOS_PHASE(Phase::Output);
+        if (!segments_.empty() && segments_.back().task == task &&
+            segments_.back().end == start)
+            segments_.back().end = end;
+        else
+            segments_.push_back({task, start, end});
+    }
+
+    // A later label for the same task replaces the earlier one.
+    void setLabel(int task, std::string label);
+    // Many labels in any order: one sort instead of an insert each.
+    void setLabels(std::vector<std::pair<int, std::string>> labels);
+    std::string label(int task) const;
+
+    // Task running at tick t (kIdleTask outside the trace), O(log n).
+    int taskAt(Tick t) const;
+
+    std::vector<int>        toTickOrder() const;   // one id per tick from start()
+    std::vector<GanttEntry> toGantt()     const;
+
+    void reserve(std::size_t n) { segments_.reserve(n); }
+    void clear() { segments_.clear(); labels_.clear(); }
+
+    // Keeps the first n segments (and every label).
+    void truncate(std::size_t n) { if (n < segments_.size()) segments_.resize(n); }
+
+    const_iterator begin() const { return segments_.begin(); }
+    const_iterator end()   const { return segments_.end(); }
+    std::size_t    size()  const { return segments_.size(); }
+    bool           empty() const { return segments_.empty(); }
+    const Segment& operator[](std::size_t i) const { return segments_[i]; }
+    const Segment& back() const { return segments_.back(); }
+
+    Tick startTime() const { return segments_.empty() ? 0 : segments_.front().start; }
+    Tick endTime()   const { return segments_.empty() ? 0 : segments_.back().end; }
+
+private:
+    std::vector<Segment>                     segments_;
+    std::vector<std::pair<int, std::string>> labels_;   // Sorted by task
+};
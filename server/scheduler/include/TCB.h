@@ -0,0 +1,164 @@
+#pragma once
+#include "Clock.h"
+#include "Task.h"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// ── Task control block ────────────────────────────────────────
+//
+// Run-time state of one job (one release of a Task).  Task holds
+// what the user asked for; the TCB holds what the engine is doing
+// with it right now.
+enum class TaskState : std::uint8_t {
+    Ready,
+    Running,
+    Blocked,
+    Completed,
+};
+
+struct TCB {
+    int       taskId    = 0;   // Task::id
+    int       taskIndex = 0;   // Position in the scheduler's task list
+    int       jobNumber = 0;
+    Tick      release   = 0;
+    Tick      deadline  = 0;   // Absolute
+    int       remaining = 0;
+    int       priority  = 0;   // Effective priority (smaller = higher)
+    TaskState state     = TaskState::Ready;
+};
+
+// Scheduler state at one instant, enough to resume the run there:
+// the clock and every pending job (absolute times).
+struct Checkpoint {
+    Tick             time = 0;
+    std::vector<TCB> backlog;
+};
+
+// ── Pooled task state ─────────────────────────────────────────
+//
+// Run-time state of a set of one-shot tasks, addressed by index
+// (the position in the scheduler's task list).  What the dispatch
+// loop reads and writes on every slice is packed into 24-byte
+// HotTCBs, contiguous in one array; what is written once, at
+// completion, lives in a separate ColdTCB array, and names stay in
+// the Task list for the trace.  load() and store() move the state
+// from and to the Tasks around a run, reusing the arrays.
+struct HotTCB {
+    int  id           = 0;
+    Tick arrival      = 0;
+    int  remaining    = 0;
+    Tick hardDeadline = 0;   // <= 0: none
+    Tick startTime    = -1;
+    bool deadlineMissed = false;
+};
+static_assert(sizeof(HotTCB) <= 24, "HotTCB is the per-slice working set");
+
+struct ColdTCB {
+    int  burst      = 0;
+    Tick completion = 0;
+    int  turnaround = 0;
+    int  waiting    = 0;
+    bool completed  = false;
+};
+
+class TCBPool {
+public:
+    void load(const std::vector<Task>& tasks) {
+        hot_.resize(tasks.size());
+        cold_.resize(tasks.size());
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            const Task& t = tasks[i];
+            hot_[i]  = HotTCB{t.id, t.arrivalTime, t.remainingTime, t.hardDeadline,
+                              t.startTime, t.deadlineMissed};
+            cold_[i] = ColdTCB{t.burstTime, t.completionTime, t.turnaroundTime,
+                               t.waitingTime, t.completed};
+        }
+    }
+
+    void store(std::vector<Task>& tasks) const {
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            Task& t          = tasks[i];
+            t.remainingTime  = hot_[i].remaining;
+            t.startTime      = hot_[i].startTime;
+            t.deadlineMissed = hot_[i].deadlineMissed;
+            t.completionTime = cold_[i].completion;
+            t.turnaroundTime = cold_[i].turnaround;
+            t.waitingTime    = cold_[i].waiting;
+            t.completed      = cold_[i].completed;
+        }
+    }
+
+    std::size_t size() const { return hot_.size(); }
+
+    HotTCB&        hot(int i)        { return hot_[i]; }
+    const HotTCB&  hot(int i)  const { return hot_[i]; }
+    ColdTCB&       cold(int i)       { return cold_[i]; }
+    const ColdTCB& cold(int i) const { return cold_[i]; }
+
+    // Completion fields, from the clock at which task i finished.
+    void complete(int i, Tick clock) {
+        ColdTCB& c   = cold_[i];
+        c.completion = clock;
+        c.turnaround = clock - hot_[i].arrival;
+        c.waiting    = c.turnaround - c.burst;
+        c.completed  = true;
+    }
+
+private:
+    std::vector<HotTCB>  hot_;
+    std::vector<ColdTCB> cold_;
+};
+
+// ── Ring-buffer ready queue ───────────────────────────────────
+//
+// FIFO of at most `capacity` entries (rounded up to a power of two)
+// in one array allocated by reset(): push and pop are a store and an
+// index mask, and nothing is allocated while the queue is in use.
+// A queue of task indices in which every task is queued at most once
+// needs capacity = number of tasks.
+template <class T>
+class RingQueue {
+public:
+    explicit RingQueue(std::size_t capacity = 0) { reset(capacity); }
+
+    // Empties the queue; allocates only to grow.
+    void reset(std::size_t capacity) {
+        std::size_t rounded = 1;
+        while (rounded < capacity) rounded <<= 1;
+        if (!slots_ || rounded > mask_ + 1) {
+            slots_ = std::make_unique<T[]>(rounded);
+            mask_  = rounded - 1;
+        }
+        head_ = 0;
+        size_ = 0;
+    }
+
+    bool        empty()    const { return size_ == 0; }
+    std::size_t size()     const { return size_; }
+    std::size_t capacity() const { return mask_ + 1; }
+
+    void push_back(T value) {
+        assert(size_ <= mask_ && "RingQueue is full");
+        slots_[(head_ + size_++) & mask_] = value;
+    }
+
+    T pop_front() {
+        assert(size_ > 0);
+        T value = slots_[head_];
+        head_   = (head_ + 1) & mask_;
+        --size_;
+        return value;
+    }
+
+    // i-th entry from the front.
+    const T& operator[](std::size_t i) const { return slots_[(head_ + i) & mask_]; }
+
+private:
+    std::unique_ptr<T[]> slots_;
+    std::size_t          mask_ = 0;
+    std::size_t          head_ = 0;
+    std::size_t          size_ = 0;
+};
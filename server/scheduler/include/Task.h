@@ -0,0 +1,33 @@
+#pragma once
+#include <string>
+
+// ── Task model ────────────────────────────────────────────────
+//
+// One task definition shared by every algorithm.  Each scheduler
+// reads the parameters it needs and ignores the rest:
+//
+//   FCFS / RR / SJF / SRTF   arrivalTime, burstTime, hardDeadline
+//   Priority / Multilevel    + priority (smaller = higher)
+//   Rate Monotonic           arrivalTime, burstTime, period (priority)
+//   EDF                      period, burstTime (WCET), relativeDeadline
+//
+// The second block is written by the scheduler for each run.
+struct Task {
+    int         id = 0;
+    std::string name;
+
+    int arrivalTime      = 0;
+    int burstTime        = 0;
+    int priority         = 0;
+    int period           = 0;   // 0 = aperiodic
+    int relativeDeadline = 0;   // Periodic: deadline relative to each release
+    int hardDeadline     = 0;   // Aperiodic: absolute deadline
+
+    int  remainingTime  = 0;
+    int  startTime      = -1;
+    int  completionTime = 0;
+    int  turnaroundTime = 0;
+    int  waitingTime    = 0;
+    bool deadlineMissed = false;
+    bool completed      = false;
+};
@@ -0,0 +1,267 @@
+#pragma once
+#include "Analysis.h"
+#include "Clock.h"
+#include "Histogram.h"
+#include "ResourceManager.h"
+#include "SegmentTrace.h"
+#include "Task.h"
+#include <array>
+#include <coroutine>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <utility>
+#include <vector>
+
+// ── Job bodies ────────────────────────────────────────────────
+//
+// A task whose jobs are more than one `burstTime` of work: the body
+// is a C++20 coroutine that awaits simulated operations,
+//
+//   JobBody sensor(int bus, int ready) {
+//       co_await body::compute(2);
+//       co_await body::lock(bus);
+//       co_await body::compute(1);
+//       co_await body::unlock(bus);
+//       co_await body::sleep(5);       // I/O, off the CPU
+//       co_await body::compute(3);
+//       co_await body::signal(ready);
+//   }
+//
+// and the engine (simulateBodies) resumes it each time the previous
+// operation is over.  Every body is a suspended coroutine frame, not
+// a thread, so a run can hold hundreds of thousands of them.
+//
+//   compute(n)   run for n ticks of CPU time, preemptible
+//   sleep(n)     self-suspend for n ticks (I/O, a timer)
+//   lock(r)      take resource r under the run's LockProtocol
+//   unlock(r)    release it; a job must not finish holding one
+//   wait(e)      take one count of event e, suspending until there
+//                is one (a counting semaphore, waiters served FIFO)
+//   signal(e)    post one count of event e
+//
+// Awaiting does not allocate: an operation is two words copied into
+// the promise.  Frames come from a per-thread FramePool, so after
+// the first few releases a job's frame reuses one a finished job
+// gave back.
+
+// ── Frame pool ────────────────────────────────────────────────
+//
+// Size-class free lists carved from 64 KiB chunks.  Frames go back
+// to their class when a body is destroyed and to the system only
+// when the pool is, at thread exit; frames over 2 KiB bypass it.  A
+// body must be destroyed on the thread that created it.
+class FramePool {
+public:
+    FramePool() = default;
+    FramePool(const FramePool&)            = delete;
+    FramePool& operator=(const FramePool&) = delete;
+
+    static FramePool& local();   // The current thread's
+
+    void* allocate(std::size_t n);
+    void  deallocate(void* p, std::size_t n) noexcept;
+
+    std::size_t live()     const { return live_; }       // Frames handed out
+    std::size_t reserved() const { return reserved_; }   // Bytes from the system
+
+private:
+    static constexpr std::size_t kGranule = 64;
+    static constexpr std::size_t kClasses = 32;          // Up to 2 KiB
+    static constexpr std::size_t kChunk   = 64 * 1024;
+
+    struct FreeFrame {
+        FreeFrame* next;
+    };
+
+    std::array<FreeFrame*, kClasses>     free_{};
+    std::vector<std::unique_ptr<char[]>> chunks_;
+    char*                                bump_     = nullptr;
+    char*                                end_      = nullptr;
+    std::size_t                          live_     = 0;
+    std::size_t                          reserved_ = 0;
+};
+
+// ── Coroutine type ────────────────────────────────────────────
+enum class BodyOpKind : std::uint8_t {
+    Compute,
+    Sleep,
+    Lock,
+    Unlock,
+    Wait,
+    Signal,
+};
+
+const char* bodyOpName(BodyOpKind kind);
+
+struct BodyOp {
+    BodyOpKind kind = BodyOpKind::Compute;
+    int        arg  = 0;   // Ticks, resource or event
+};
+
+// Owns the frame.  A body starts suspended; each step() runs it to
+// its next operation.
+class JobBody {
+public:
+    struct promise_type {
+        BodyOp             op;      // What the last suspension awaits
+        std::exception_ptr error;
+
+        JobBody get_return_object() {
+            return JobBody(std::coroutine_handle<promise_type>::from_promise(*this));
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept { error = std::current_exception(); }
+
+        static void* operator new(std::size_t n) { return FramePool::local().allocate(n); }
+        static void  operator delete(void* p, std::size_t n) noexcept {
+            FramePool::local().deallocate(p, n);
+        }
+    };
+    using Handle = std::coroutine_handle<promise_type>;
+
+    JobBody() = default;
+    JobBody(JobBody&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    JobBody& operator=(JobBody&& other) noexcept {
+        if (this != &other) {
+            if (handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    ~JobBody() {
+        if (handle_) handle_.destroy();
+    }
+
+    explicit operator bool() const { return (bool)handle_; }
+
+    // false once the body has returned; rethrows what it threw.
+    bool step() {
+        handle_.resume();
+        if (handle_.promise().error) std::rethrow_exception(handle_.promise().error);
+        return !handle_.done();
+    }
+
+    const BodyOp& op() const { return handle_.promise().op; }
+
+private:
+    explicit JobBody(Handle handle) : handle_(handle) {}
+
+    Handle handle_;
+};
+
+// ── Operations ────────────────────────────────────────────────
+namespace body {
+
+struct Operation {
+    BodyOp op;
+
+    bool await_ready() const noexcept { return false; }
+    void await_suspend(JobBody::Handle h) const noexcept { h.promise().op = op; }
+    void await_resume() const noexcept {}
+};
+
+inline Operation compute(Tick n)  { return {{BodyOpKind::Compute, n}}; }
+inline Operation sleep(Tick n)    { return {{BodyOpKind::Sleep, n}}; }
+inline Operation lock(int r)      { return {{BodyOpKind::Lock, r}}; }
+inline Operation unlock(int r)    { return {{BodyOpKind::Unlock, r}}; }
+inline Operation wait(int e)      { return {{BodyOpKind::Wait, e}}; }
+inline Operation signal(int e)    { return {{BodyOpKind::Signal, e}}; }
+
+} // namespace body
+
+// ── Scripted bodies ───────────────────────────────────────────
+//
+// Bodies from a task file, one line per task:
+//
+//   body <task id> <op> <n> [<op> <n> ...]
+//
+// with the operations above by name, e.g.
+//
+//   body 2 compute 2 lock 0 compute 1 unlock 0 sleep 5 compute 3 signal 1
+//
+// A second line for the same task continues the first.  A task
+// without a body line computes its burstTime.  readTasks() skips
+// these lines, like the `cs` lines of ResourceManager.h.
+struct BodyScript {
+    int                 taskId = 0;
+    std::vector<BodyOp> ops;
+};
+
+// Appends the `body` lines of a task file; throws std::runtime_error.
+void readBodyScripts(std::istream& in, std::vector<BodyScript>& scripts);
+
+// Awaits ops[0..n) in order; the ops must outlive the body.
+JobBody scriptedBody(const BodyOp* ops, std::size_t n);
+
+// ── Simulation ────────────────────────────────────────────────
+
+// The body of release `job` (0, 1, ...) of the task at input index
+// `task`.
+using BodyFactory = std::function<JobBody(int task, std::int64_t job)>;
+
+struct BodyConfig {
+    LockProtocol  protocol = LockProtocol::Inheritance;
+    PriorityOrder order    = PriorityOrder::RateMonotonic;
+    Tick          horizon  = 0;   // 0 = hyperperiod
+};
+
+struct BodyTaskStats {
+    int          jobs          = 0;   // Completed
+    int          misses        = 0;
+    Tick         worstResponse = 0;
+    std::int64_t executed      = 0;   // Compute ticks, every job
+    std::int64_t suspensions   = 0;   // Sleeps and waits that suspended
+    std::int64_t blocks        = 0;   // Locks that had to wait
+    JobLatency   latency;             // Waiting = response - executed
+};
+
+struct BodyResult {
+    SegmentTrace               gantt;
+    std::vector<BodyTaskStats> tasks;     // Same order as the input
+    JobLatency                 latency;   // The tasks', merged
+    Tick         horizon        = 0;
+    int          deadlineMisses = 0;
+    int          preemptions    = 0;
+    std::int64_t jobsCompleted  = 0;
+    std::int64_t suspensions    = 0;
+    std::int64_t blocks         = 0;
+    std::size_t  peakFrames     = 0;   // Bodies alive at once
+    std::size_t  frameBytes     = 0;   // FramePool::reserved() at the end
+};
+
+// Preemptive fixed-priority simulation on one core, like
+// simulateResources(): one job per task is active, later releases
+// queue behind it, and priorities are ranks in config.order.  A job
+// is released with its body suspended and is resumed when it is
+// dispatched, when its compute() runs out, and when it is dispatched
+// again after a sleep, a wait or a blocked lock.  Operations that
+// take no time (lock, unlock, signal, zero-length compute and
+// sleep) run as soon as the compute before them ends, ahead of
+// releases at that tick, as simulateResources() runs its lock
+// points; the job stops before a lock when an unlock or signal has
+// made ready a job that outranks it.
+//
+// `locks[i]` lists the resources task i's body may lock; ceilings
+// come from it.  Locking any other resource throws
+// std::runtime_error, and so does a deadlock; unlocking a resource
+// the job does not hold, or finishing with one held, throws
+// std::logic_error.  Throws std::invalid_argument for tasks without
+// a period.
+BodyResult simulateBodies(const BodyConfig& config, const std::vector<Task>& tasks,
+                          const std::vector<std::vector<int>>& locks,
+                          const BodyFactory& body);
+
+// simulateBodies() over scripted bodies; the locks come from the
+// scripts.  Throws std::invalid_argument for a script of an unknown
+// task or with a negative argument.
+BodyResult simulateScripts(const BodyConfig& config, const std::vector<Task>& tasks,
+                           const std::vector<BodyScript>& scripts);
+
+void printBodyReport(const BodyResult& res, const std::vector<Task>& tasks,
+                     const BodyConfig& config, bool gantt, std::ostream& os);
@@ -0,0 +1,144 @@
+#pragma once
+#include "Clock.h"
+#include "Task.h"
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+// ── Binary task-set file ──────────────────────────────────────
+//
+// Fixed layout, little-endian, so a file maps straight onto
+// TaskRecord[] with no parsing:
+//
+//   offset  0   "RTOSTSK1"
+//           8   u32 version (1)
+//          12   u32 record size (32)
+//          16   u64 record count N
+//          24   u64 generator seed
+//          32   f64 target utilization
+//          40   f64 utilization of the rounded WCETs / periods
+//          48   16 reserved bytes (zero)
+//          64   N x TaskRecord
+//
+// Records carry the numeric Task fields only; tasks read from a file
+// are named T<id>, as in the task lines writeTaskLines() produces.
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__
+#error "TaskSet.h maps little-endian files in place"
+#endif
+
+struct TaskRecord {
+    std::int32_t id;
+    std::int32_t arrivalTime;
+    std::int32_t burstTime;
+    std::int32_t priority;
+    std::int32_t period;
+    std::int32_t relativeDeadline;
+    std::int32_t hardDeadline;
+    std::int32_t reserved;
+};
+static_assert(sizeof(TaskRecord) == 32, "TaskRecord is part of the file format");
+
+struct TaskSetHeader {
+    char          magic[8];
+    std::uint32_t version;
+    std::uint32_t recordSize;
+    std::uint64_t count;
+    std::uint64_t seed;
+    double        targetUtilization;
+    double        utilization;
+    std::uint8_t  reserved[16];
+};
+static_assert(sizeof(TaskSetHeader) == 64, "TaskSetHeader is part of the file format");
+
+Task toTask(const TaskRecord& r);
+
+// Read-only mapping of a task-set file.  Loading costs page faults,
+// not a parse: records are read in place, and appendTo() touches
+// each one once.
+class MappedTaskSet {
+public:
+    MappedTaskSet() = default;
+    ~MappedTaskSet();
+
+    MappedTaskSet(MappedTaskSet&& other) noexcept;
+    MappedTaskSet& operator=(MappedTaskSet&& other) noexcept;
+    MappedTaskSet(const MappedTaskSet&)            = delete;
+    MappedTaskSet& operator=(const MappedTaskSet&) = delete;
+
+    // false if `fd` is not a regular file starting with the magic
+    // (the file offset is left alone, so the caller can parse text
+    // instead); throws std::runtime_error for a damaged file.
+    bool map(int fd);
+
+    const TaskSetHeader& header() const { return *header_; }
+    std::size_t          size()   const { return size_; }
+    const TaskRecord*    begin()  const { return records_; }
+    const TaskRecord*    end()    const { return records_ + size_; }
+    const TaskRecord& operator[](std::size_t i) const { return records_[i]; }
+
+    void appendTo(std::vector<Task>& tasks) const;
+
+private:
+    void unmap();
+
+    void*                base_    = nullptr;
+    std::size_t          bytes_   = 0;
+    const TaskSetHeader* header_  = nullptr;
+    const TaskRecord*    records_ = nullptr;
+    std::size_t          size_    = 0;
+};
+
+// Appends the tasks of `path`: a task-set file is mapped, anything
+// else is read as task lines (Options.h).  Throws std::runtime_error.
+void loadTasks(const std::string& path, std::vector<Task>& tasks);
+
+// ── Generator ─────────────────────────────────────────────────
+//
+// Periodic task sets for a target total utilization U:
+//
+//   utilizations  UUniFast (Bini & Buttazzo): uniform over the
+//                 simplex sum u_i = U in one O(n) pass.  With
+//                 `discard`, sets with some u_i > maxTaskUtilization
+//                 are drawn again (UUniFast-Discard, for U > 1 on
+//                 several cores)
+//   periods       log-uniform in [max(periodMin, 1 / u_i), periodMax],
+//                 rounded to a multiple of `granularity` (a coarse
+//                 grid keeps the hyperperiod small); the lower bound
+//                 keeps a small u_i from rounding up to a whole tick
+//                 of a short period
+//   WCET          max(1, round(u_i * T_i)), with each task's rounding
+//                 error carried into the next u_i
+//   deadlines     round(r * T_i), r uniform in [deadlineMin,
+//                 deadlineMax], never below the WCET; 1..1 gives
+//                 implicit deadlines
+//
+// A set whose rounded utilization is more than 1% away from U is
+// drawn again; the header records the value actually produced.
+// With n / periodMax > U even one-tick WCETs overshoot, and the
+// parameters are rejected.
+struct GeneratorConfig {
+    std::size_t   tasks              = 10;
+    double        utilization        = 0.7;
+    Tick          periodMin          = 10;
+    Tick          periodMax          = 1000;
+    Tick          granularity        = 1;
+    double        deadlineMin        = 1.0;
+    double        deadlineMax        = 1.0;
+    bool          discard            = false;
+    double        maxTaskUtilization = 1.0;
+    std::uint64_t seed               = 1;
+};
+
+// Throws std::invalid_argument for inconsistent parameters and
+// std::runtime_error if no draw is within the cap and tolerance.
+std::vector<TaskRecord> generateTaskSet(const GeneratorConfig& config,
+                                        TaskSetHeader& header);
+
+// Header and records in one pass; throws std::runtime_error.
+void writeTaskSet(int fd, const TaskSetHeader& header,
+                  const std::vector<TaskRecord>& records);
+
+// The same set as task lines, for small sets and diffs.
+void writeTaskLines(std::ostream& os, const std::vector<TaskRecord>& records);
@@ -0,0 +1,62 @@
+#pragma once
+#include "Task.h"
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <vector>
+
+// ── Structure-of-arrays task table ────────────────────────────
+//
+// Periodic parameters of a task set as separate columns (WCET,
+// period, relative deadline, 1/period), each 32-byte aligned and
+// padded to a multiple of kLanes with idle entries (C = 0, T = 1,
+// D = 0).  Vector kernels therefore load whole registers from every
+// column with no tail loop, and an idle entry adds nothing to any
+// demand sum.
+//
+// Columns hold doubles: every tick count below 2^53 is exact, and
+// the kernels correct the one rounding step (the reciprocal) with
+// integer compares, so results match integer arithmetic exactly.
+class TaskTable {
+public:
+    static constexpr std::size_t kLanes = 4;   // doubles per 256-bit register
+
+    TaskTable() = default;
+    explicit TaskTable(const std::vector<Task>& tasks);
+
+    TaskTable(TaskTable&& other) noexcept;
+    TaskTable& operator=(TaskTable&& other) noexcept;
+
+    // Throws std::invalid_argument for period <= 0; a zero relative
+    // deadline means an implicit deadline (D = T).
+    void push_back(const Task& t);
+    void pop_back();
+    void reserve(std::size_t n);
+
+    std::size_t size()       const { return ids_.size(); }
+    std::size_t paddedSize() const { return (size() + kLanes - 1) / kLanes * kLanes; }
+    bool        empty()      const { return ids_.empty(); }
+
+    int           id(std::size_t i) const { return ids_[i]; }
+    const double* wcet()      const { return C_.get(); }
+    const double* period()    const { return T_.get(); }
+    const double* deadline()  const { return D_.get(); }
+    const double* invPeriod() const { return invT_.get(); }
+
+    double utilization() const;
+    double minDeadline() const;
+    double maxDeadline() const;
+
+private:
+    struct AlignedFree {
+        void operator()(double* p) const { ::operator delete[](p, std::align_val_t(32)); }
+    };
+    using Column = std::unique_ptr<double[], AlignedFree>;
+
+    void grow(std::size_t capacity);
+    void setPadding(std::size_t i);
+
+    Column           C_, T_, D_, invT_;
+    std::size_t      capacity_ = 0;
+    std::vector<int> ids_;
+};
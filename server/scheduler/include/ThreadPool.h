@@ -0,0 +1,61 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// ── Work-stealing thread pool ─────────────────────────────────
+//
+// parallelFor(n, body) runs body(index, worker) for every index in
+// [0, n) and returns once all of them are done.  The index space is
+// split into one contiguous range per worker; a worker takes indices
+// from the front of its own range and, when that runs dry, steals
+// the back half of another worker's range.  Each range is a single
+// 64-bit atomic (begin | end << 32), so both sides are one CAS and
+// nothing is allocated per job.
+//
+// `worker` is stable for the lifetime of the pool, so callers can
+// keep per-worker state (scratch buffers, trace sinks, partial
+// results) in a vector indexed by it without any locking.  The first
+// exception thrown by a body is rethrown from parallelFor after the
+// remaining indices have run.
+class WorkStealingPool {
+public:
+    using Body = std::function<void(std::size_t index, unsigned worker)>;
+
+    explicit WorkStealingPool(unsigned threads = 0);   // 0 = one per core
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&)            = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    unsigned size() const { return (unsigned)threads_.size(); }
+
+    void parallelFor(std::size_t n, const Body& body);
+
+private:
+    struct alignas(64) Range {
+        std::atomic<std::uint64_t> bounds{0};
+    };
+
+    void workerLoop(unsigned id);
+    bool next(unsigned id, std::size_t& index);
+
+    std::unique_ptr<Range[]> ranges_;
+    std::vector<std::thread> threads_;
+
+    std::mutex              mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    const Body*             body_       = nullptr;
+    std::uint64_t           generation_ = 0;
+    unsigned                active_     = 0;
+    bool                    stop_       = false;
+    std::exception_ptr      error_;
+};
@@ -0,0 +1,51 @@
+#pragma once
+#include "Clock.h"
+#include "Scheduler.h"
+#include "TCB.h"
+#include "Task.h"
+#include <cstddef>
+#include <vector>
+
+// ── Checkpointed timeline ─────────────────────────────────────
+//
+// Lets a viewer jump anywhere in a long run without simulating from
+// tick 0 or keeping the whole trace.  The constructor runs the
+// horizon once with no Gantt trace, saving a Checkpoint (clock and
+// pending jobs, see TCB.h) every `interval` ticks.  window(a, b)
+// restores the last checkpoint at or before a, re-simulates quietly
+// up to a and then traces [a, b), so a query costs at most
+// interval + (b - a) ticks and memory for one window, however long
+// the run.  When the run found its schedule repeating (SteadyState),
+// windows past the first cycle are read from that cycle.
+//
+// Checkpoints apply to EDF, the policy whose runs are bounded by a
+// horizon rather than by the work.  Every other policy stops when
+// its jobs finish; for those the full result is kept and window()
+// clips it.
+class Timeline {
+public:
+    // interval 0 = horizon / 1024.  Throws like runScheduler().
+    Timeline(const SchedulerConfig& config, std::vector<Task> tasks, Tick interval = 0);
+
+    Tick        horizon()     const { return horizon_; }
+    std::size_t checkpoints() const { return checkpoints_.size(); }
+
+    // Counters of the whole run; the Gantt chart is empty for EDF.
+    const ScheduleResult& summary() const { return summary_; }
+
+    // Gantt segments of [from, to) (clamped to the run) and counters
+    // for what happened inside it: totalClockTime is the window
+    // length, `jobs` (EDF) and `latency` count the jobs completed in
+    // the window.
+    ScheduleResult window(Tick from, Tick to) const;
+
+private:
+    ScheduleResult edfWindow(Tick from, Tick to) const;
+    ScheduleResult clippedWindow(Tick from, Tick to) const;
+
+    SchedulerConfig         config_;
+    std::vector<Task>       tasks_;
+    Tick                    horizon_ = 0;
+    std::vector<Checkpoint> checkpoints_;
+    ScheduleResult          summary_;
+};
@@ -0,0 +1,200 @@
+#pragma once
+#include "Instrument.h"
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+// ── Scheduler tracing ─────────────────────────────────────────
+//
+// Every log line in the scheduler loops goes through the RTOS_TRACE*
+// macros below instead of std::cout.
+//
+//   * Levels above RTOS_TRACE_LEVEL are removed at compile time
+//     (build with -DRTOS_TRACE_LEVEL=0 for a trace-free binary).
+//   * The remaining levels are filtered at run time by the sink
+//     installed on the current thread: NullSink, TextSink (the
+//     original human-readable log) or BinaryRingSink (fixed-size
+//     records in a ring buffer, nothing is formatted).
+//
+// The default sink is a Tick-level TextSink on std::cout, so the
+// output is unchanged unless a caller installs something else.
+
+enum class TraceLevel : int {
+    Off     = 0,
+    Summary = 1,   // banners and end-of-run totals
+    Event   = 2,   // arrivals, dispatches, completions, misses
+    Tick    = 3,   // per-tick lines (EDF)
+};
+
+#ifndef RTOS_TRACE_LEVEL
+#define RTOS_TRACE_LEVEL 3
+#endif
+
+constexpr TraceLevel kTraceCompiledLevel = TraceLevel(RTOS_TRACE_LEVEL);
+
+enum class TraceEvent : std::uint32_t {
+    Arrival,
+    Release,
+    Dispatch,
+    Run,
+    Idle,
+    ContextSwitch,
+    Preempt,
+    Complete,
+    DeadlineMiss,
+    Lock,
+    Unlock,
+    Block,
+    Sleep,    // Job bodies (TaskBody.h): arg = wake-up tick
+    Wait,     // arg = event
+    Signal,   // arg = event
+};
+
+// 16-byte binary record; `arg` depends on the event (segment end,
+// deadline, remaining time, ...).
+struct TraceRecord {
+    std::int32_t tick;
+    std::int32_t task;
+    std::int32_t arg;
+    TraceEvent   kind;
+};
+
+// ── Sinks ─────────────────────────────────────────────────────
+class TraceSink {
+public:
+    explicit TraceSink(TraceLevel level) : level_(level) {}
+    virtual ~TraceSink() = default;
+
+    TraceLevel level() const { return level_; }
+    void       setLevel(TraceLevel level) { level_ = level; }
+    bool       wants(TraceLevel l) const { return l != TraceLevel::Off && l <= level_; }
+
+    // Text sinks return their stream; record sinks return nullptr.
+    virtual std::ostream* text() { return nullptr; }
+    virtual void record(const TraceRecord&) {}
+
+private:
+    TraceLevel level_;
+};
+
+class NullSink : public TraceSink {
+public:
+    NullSink() : TraceSink(TraceLevel::Off) {}
+};
+
+class TextSink : public TraceSink {
+public:
+    explicit TextSink(std::ostream& os, TraceLevel level = TraceLevel::Tick)
+        : TraceSink(level), os_(os) {}
+
+    std::ostream* text() override { return &os_; }
+
+private:
+    std::ostream& os_;
+};
+
+// Keeps the newest `capacity` records (rounded up to a power of two);
+// older ones are overwritten and counted in dropped().
+class BinaryRingSink : public TraceSink {
+public:
+    explicit BinaryRingSink(std::size_t capacity,
+                            TraceLevel level = TraceLevel::Event);
+
+    void record(const TraceRecord& r) override { ring_[head_++ & mask_] = r; }
+
+    std::size_t   size()    const;
+    std::uint64_t dropped() const;
+    void          clear()         { head_ = 0; }
+
+    // Oldest to newest.
+    template <class F>
+    void forEach(F&& f) const {
+        for (std::uint64_t i = head_ - size(); i < head_; ++i)
+            f(ring_[i & mask_]);
+    }
+
+    // Raw little-endian TraceRecords, oldest first.
+    void writeTo(std::ostream& os) const;
+
+private:
+    std::vector<TraceRecord> ring_;
+    std::uint64_t            mask_;
+    std::uint64_t            head_ = 0;
+};
+
+// ── Per-thread sink selection ─────────────────────────────────
+namespace trace {
+
+constexpr bool compiled(TraceLevel l) {
+    return l != TraceLevel::Off && l <= kTraceCompiledLevel;
+}
+
+TraceSink& defaultSink();
+
+inline thread_local TraceSink* current = nullptr;
+
+inline TraceSink& sink() { return current ? *current : defaultSink(); }
+inline void       setSink(TraceSink* s) { current = s; }
+
+// Stream to format into at `l`, or nullptr (also when compiled out).
+inline std::ostream* textAt(TraceLevel l) {
+    if (!compiled(l)) return nullptr;
+    TraceSink& s = sink();
+    return s.wants(l) ? s.text() : nullptr;
+}
+
+// Installs a sink for the lifetime of the scope.
+class ScopedSink {
+public:
+    explicit ScopedSink(TraceSink& s) : prev_(current) { current = &s; }
+    ~ScopedSink() { current = prev_; }
+    ScopedSink(const ScopedSink&) = delete;
+    ScopedSink& operator=(const ScopedSink&) = delete;
+
+private:
+    TraceSink* prev_;
+};
+
+} // namespace trace
+
+// ── Trace points ──────────────────────────────────────────────
+//
+// `expr` is a stream expression ("a" << b << "\n"); it is evaluated
+// only when a text sink wants the level.  What a sink takes is timed
+// as Phase::Output.
+
+#define RTOS_TRACE(lvl, kind, tick, task, arg, expr)                       \
+    do {                                                                   \
+        if constexpr (trace::compiled(lvl)) {                              \
+            TraceSink& trace_sink_ = trace::sink();                        \
+            if (trace_sink_.wants(lvl)) {                                  \
+                RTOS_PHASE(Phase::Output);                                 \
+                if (std::ostream* trace_os_ = trace_sink_.text())          \
+                    *trace_os_ << expr;                                    \
+                else                                                       \
+                    trace_sink_.record({(tick), (task), (arg), (kind)});   \
+            }                                                              \
+        }                                                                  \
+    } while (0)
+
+#define RTOS_TRACE_TEXT(lvl, expr)                                         \
+    do {                                                                   \
+        if constexpr (trace::compiled(lvl)) {                              \
+            if (std::ostream* trace_os_ = trace::textAt(lvl)) {            \
+                RTOS_PHASE(Phase::Output);                                 \
+                *trace_os_ << expr;                                        \
+            }                                                              \
+        }                                                                  \
+    } while (0)
+
+#define RTOS_TRACE_RECORD(lvl, kind, tick, task, arg)                      \
+    do {                                                                   \
+        if constexpr (trace::compiled(lvl)) {                              \
+            TraceSink& trace_sink_ = trace::sink();                        \
+            if (trace_sink_.wants(lvl) && !trace_sink_.text()) {           \
+                RTOS_PHASE(Phase::Output);                                 \
+                trace_sink_.record({(tick), (task), (arg), (kind)});       \
+            }                                                              \
+        }                                                                  \
+    } while (0)
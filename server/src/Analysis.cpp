@@ -0,0 +1,360 @@
+#include "Analysis.h"
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+#include <ostream>
+#include <queue>
+#include <stdexcept>
+
+// ── Priority orders ───────────────────────────────────────────
+namespace {
+
+struct OrderName {
+    PriorityOrder order;
+    const char*   name;
+};
+
+constexpr OrderName kOrderNames[] = {
+    {PriorityOrder::RateMonotonic,     "rm"},
+    {PriorityOrder::DeadlineMonotonic, "dm"},
+    {PriorityOrder::Explicit,          "fp"},
+};
+
+// Longest job chain checked per task before giving up on a level-i
+// busy period that never closes (level utilization of exactly 1).
+constexpr std::int64_t kMaxBusyJobs = 1 << 20;
+
+// Periodic parameters in priority order (structure of arrays, so the
+// interference loop streams through contiguous columns).
+struct PriorityTable {
+    std::vector<int>          id;
+    std::vector<std::int64_t> C, T, D;
+    std::vector<double>       invT;   // 1 / T, for division-free ceil()
+};
+
+PriorityTable sortedTable(const std::vector<Task>& tasks, PriorityOrder order) {
+    const std::vector<std::size_t> idx = priorityIndex(tasks, order);
+    const std::size_t n = tasks.size();
+    auto deadline = [&](const Task& t) {
+        return t.relativeDeadline > 0 ? t.relativeDeadline : t.period;
+    };
+
+    PriorityTable table;
+    table.id.reserve(n);
+    table.C.reserve(n);
+    table.T.reserve(n);
+    table.D.reserve(n);
+    table.invT.reserve(n);
+    for (std::size_t i : idx) {
+        table.id.push_back(tasks[i].id);
+        table.C.push_back(tasks[i].burstTime);
+        table.T.push_back(tasks[i].period);
+        table.D.push_back(deadline(tasks[i]));
+        table.invT.push_back(1.0 / tasks[i].period);
+    }
+    return table;
+}
+
+// ceil(w / t) without a 64-bit divide: the floating-point quotient is
+// within one of the answer for any w, t below 2^53, and two compares
+// fix it up exactly.
+inline std::int64_t ceilDiv(std::int64_t w, std::int64_t t, double invT) {
+    std::int64_t k = (std::int64_t)((double)w * invT);
+    if (k * t < w) ++k;
+    if (k > 0 && (k - 1) * t >= w) --k;
+    return k;
+}
+
+// Least fixed point of w = c + sum_{j<i} ceil(w / T_j) C_j, starting
+// from `w` (which must not exceed it).  Returns the first value past
+// `limit` as soon as the sum crosses it.
+std::int64_t busyWindow(const PriorityTable& t, std::size_t i, std::int64_t c,
+                        std::int64_t w, std::int64_t limit) {
+    const std::int64_t* C    = t.C.data();
+    const std::int64_t* T    = t.T.data();
+    const double*       invT = t.invT.data();
+    for (;;) {
+        std::int64_t next = c;
+        for (std::size_t j = 0; j < i; ++j) {
+            next += ceilDiv(w, T[j], invT[j]) * C[j];
+            if (next > limit) return next;
+        }
+        if (next <= w) return w;
+        w = next;
+    }
+}
+
+} // namespace
+
+const char* priorityOrderName(PriorityOrder order) {
+    for (const auto& o : kOrderNames)
+        if (o.order == order) return o.name;
+    return "unknown";
+}
+
+bool parsePriorityOrder(const std::string& name, PriorityOrder& order) {
+    for (const auto& o : kOrderNames) {
+        if (name == o.name) {
+            order = o.order;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ── Hyperperiod ───────────────────────────────────────────────
+std::vector<std::size_t> priorityIndex(const std::vector<Task>& tasks, PriorityOrder order) {
+    std::vector<std::size_t> idx(tasks.size());
+    std::iota(idx.begin(), idx.end(), 0);
+
+    auto deadline = [&](const Task& t) {
+        return t.relativeDeadline > 0 ? t.relativeDeadline : t.period;
+    };
+    for (const Task& t : tasks)
+        if (t.period <= 0)
+            throw std::invalid_argument("task " + std::to_string(t.id) +
+                                        " needs a period > 0");
+
+    std::stable_sort(idx.begin(), idx.end(), [&](std::size_t a, std::size_t b) {
+        const Task& x = tasks[a];
+        const Task& y = tasks[b];
+        switch (order) {
+        case PriorityOrder::RateMonotonic:     return x.period   < y.period;
+        case PriorityOrder::DeadlineMonotonic: return deadline(x) < deadline(y);
+        case PriorityOrder::Explicit:          return x.priority < y.priority;
+        }
+        return false;
+    });
+    return idx;
+}
+
+bool hyperperiod(const std::vector<Task>& tasks, std::int64_t& out) {
+    std::int64_t h = 1;
+    for (const Task& t : tasks) {
+        if (t.period <= 0) continue;
+        std::int64_t step = t.period / std::gcd(h, (std::int64_t)t.period);
+        if (__builtin_mul_overflow(h, step, &h)) return false;
+    }
+    out = h;
+    return true;
+}
+
+// ── Analysis ──────────────────────────────────────────────────
+SchedulabilityReport analyzeFixedPriority(const std::vector<Task>& tasks,
+                                          PriorityOrder order,
+                                          bool allResponses) {
+    const PriorityTable table = sortedTable(tasks, order);
+    const std::size_t n = table.id.size();
+
+    SchedulabilityReport rep;
+    rep.order = order;
+    rep.hyperperiodFits = hyperperiod(tasks, rep.hyperperiod);
+
+    bool implicit = true;
+    rep.hyperbolicProduct = 1;
+    for (std::size_t i = 0; i < n; ++i) {
+        double u = (double)table.C[i] / table.T[i];
+        rep.utilization       += u;
+        rep.hyperbolicProduct *= u + 1;
+        implicit = implicit && table.D[i] == table.T[i];
+    }
+    rep.liuLaylandBound = n ? n * (std::pow(2.0, 1.0 / n) - 1) : 1.0;
+    rep.boundsApply     = implicit && order != PriorityOrder::Explicit;
+    rep.liuLaylandPass  = rep.boundsApply && rep.utilization <= rep.liuLaylandBound;
+    rep.hyperbolicPass  = rep.boundsApply && rep.hyperbolicProduct <= 2.0;
+
+    rep.responses.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        ResponseTime& r = rep.responses[i];
+        r.taskId   = table.id[i];
+        r.wcet     = table.C[i];
+        r.period   = table.T[i];
+        r.deadline = table.D[i];
+    }
+
+    // Fast paths: a sufficient bound, or more work than time
+    if (!allResponses && (rep.liuLaylandPass || rep.hyperbolicPass)) {
+        rep.schedulable = true;
+        return rep;
+    }
+    // Utilization is summed in floating point; an exact integer test
+    // would need the hyperperiod, so only clearly overloaded sets
+    // take this exit and the rest go to the exact test.
+    if (!allResponses && rep.utilization > 1.0 + 1e-9) {
+        rep.schedulable = false;
+        return rep;
+    }
+
+    rep.exact       = true;
+    rep.schedulable = true;
+    double       levelUtil = 0;   // sum_{j<i} U_j
+    double       ubCarry   = 0;   // sum_{j<i} C_j (1 - U_j)
+    std::int64_t sumC      = 0;
+    std::int64_t seed      = 0;   // R_{i-1} when the task above converged
+    bool         seeded    = false;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        ResponseTime& r = rep.responses[i];
+        const std::int64_t C = table.C[i], T = table.T[i], D = table.D[i];
+        const double       u = (double)C / T;
+        sumC      += C;
+        r.analysed = true;
+
+        // Closed-form bounds on the first job's response (Bini & Baruah):
+        //   C / (1 - U_hp)  <=  R  <=  (C + sum C_j (1 - U_j)) / (1 - U_hp)
+        // When only the verdict is wanted, an upper bound inside the
+        // deadline and the period settles the task with no iteration.
+        std::int64_t start = sumC;
+        if (levelUtil < 1.0) {
+            double lb = C / (1.0 - levelUtil);
+            double ub = (C + ubCarry) / (1.0 - levelUtil);
+            if (!allResponses && ub * (1 + 1e-12) < (double)std::min(D, T)) {
+                r.wcrt        = (std::int64_t)std::ceil(ub);
+                r.schedulable = true;
+                r.upperBound  = true;
+                levelUtil += u;
+                ubCarry   += C * (1 - u);
+                seeded     = false;
+                continue;
+            }
+            if (lb < 9e15) start = std::max(start, (std::int64_t)std::floor(lb));
+        }
+        if (seeded) start = std::max(start, seed + C);
+
+        levelUtil += u;
+        ubCarry   += C * (1 - u);
+
+        std::int64_t w    = 0;
+        std::int64_t wcrt = 0;
+        bool ok = true;
+        for (std::int64_t q = 0;; ++q) {
+            std::int64_t limit = q * T + D;
+            w = busyWindow(table, i, (q + 1) * C, q == 0 ? start : w + C, limit);
+            if (w > limit) { wcrt = w - q * T; ok = false; break; }
+            wcrt = std::max(wcrt, w - q * T);
+            if (q == 0) seed = w;
+            if (w <= (q + 1) * T) break;          // Busy period closed
+            if (q + 1 >= kMaxBusyJobs || levelUtil > 1.0) { ok = false; break; }
+        }
+
+        r.wcrt        = wcrt;
+        r.schedulable = ok;
+        seeded        = ok;
+        if (!ok) {
+            rep.schedulable = false;
+            if (!allResponses) break;
+        }
+    }
+    return rep;
+}
+
+// ── Confirmation by simulation ────────────────────────────────
+std::vector<std::int64_t> simulateFixedPriority(const std::vector<Task>& tasks,
+                                                PriorityOrder order,
+                                                std::int64_t limit) {
+    const PriorityTable table = sortedTable(tasks, order);
+    const std::size_t n = table.id.size();
+
+    std::vector<std::int64_t> worst(n, 0);
+    std::vector<std::int64_t> release(n, 0), nextRelease(n, 0), remaining(n, 0);
+    std::vector<int>          backlog(n, 0);   // Released, unfinished jobs
+
+    // Pending releases (time, rank) and ready ranks; rank = priority
+    using Event = std::pair<std::int64_t, std::size_t>;
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> releases;
+    std::priority_queue<std::size_t, std::vector<std::size_t>, std::greater<std::size_t>> ready;
+    for (std::size_t i = 0; i < n; ++i) releases.push({0, i});
+
+    // Jobs of one task run in release order; the head job's release
+    // is `release[i]`, later ones follow at multiples of T_i.
+    std::int64_t now = 0;
+    while (now < limit) {
+        while (!releases.empty() && releases.top().first <= now) {
+            std::size_t i = releases.top().second;
+            releases.pop();
+            if (backlog[i]++ == 0) {
+                release[i]   = nextRelease[i];
+                remaining[i] = table.C[i];
+                ready.push(i);
+            }
+            nextRelease[i] += table.T[i];
+            releases.push({nextRelease[i], i});
+        }
+        if (ready.empty()) break;                 // First idle instant
+
+        std::size_t  i     = ready.top();
+        std::int64_t until = std::min(now + remaining[i], limit);
+        if (!releases.empty()) until = std::min(until, releases.top().first);
+        remaining[i] -= until - now;
+        now = until;
+
+        if (remaining[i] == 0) {
+            worst[i] = std::max(worst[i], now - release[i]);
+            ready.pop();
+            if (--backlog[i] > 0) {
+                release[i]  += table.T[i];
+                remaining[i] = table.C[i];
+                ready.push(i);
+            }
+        }
+    }
+    return worst;
+}
+
+// ── Report ────────────────────────────────────────────────────
+void printAnalysis(const SchedulabilityReport& rep, std::ostream& os,
+                   const std::vector<std::int64_t>* observed) {
+    auto verdict = [](bool pass) { return pass ? "pass" : "fail"; };
+
+    os << "\n  Schedulability Analysis [" << priorityOrderName(rep.order) << "]\n";
+    os << "  " << std::string(68, '-') << "\n";
+    os << std::fixed << std::setprecision(4);
+    os << "  Tasks           : " << rep.responses.size() << "\n"
+       << "  Utilization     : " << rep.utilization << "\n";
+    if (rep.boundsApply) {
+        os << "  Liu & Layland   : U <= " << rep.liuLaylandBound << "  "
+           << verdict(rep.liuLaylandPass) << "\n"
+           << "  Hyperbolic      : prod = " << rep.hyperbolicProduct << " <= 2  "
+           << verdict(rep.hyperbolicPass) << "\n";
+    } else {
+        os << "  Utilization bounds need RM/DM with implicit deadlines\n";
+    }
+    os << "  Hyperperiod     : ";
+    if (rep.hyperperiodFits) os << rep.hyperperiod << " ticks\n";
+    else                     os << "overflows 64 bits\n";
+    os << "  Verdict         : " << (rep.schedulable ? "SCHEDULABLE" : "NOT SCHEDULABLE")
+       << (rep.exact ? "  (response-time test)" : "  (bound)") << "\n";
+
+    if (!rep.exact) return;
+
+    os << "  " << std::string(68, '-') << "\n";
+    os << std::left
+       << "  " << std::setw(8) << "Task"
+       << std::setw(10) << "WCET"
+       << std::setw(10) << "Period"
+       << std::setw(10) << "Deadline"
+       << std::setw(10) << "WCRT"
+       << std::setw(10) << (observed ? "Observed" : "")
+       << "OK\n";
+    os << "  " << std::string(68, '-') << "\n";
+    for (std::size_t i = 0; i < rep.responses.size(); ++i) {
+        const ResponseTime& r = rep.responses[i];
+        os << "  " << std::setw(8) << r.taskId
+           << std::setw(10) << r.wcet
+           << std::setw(10) << r.period
+           << std::setw(10) << r.deadline;
+        if (!r.analysed) {
+            os << "-\n";
+            continue;
+        }
+        std::string wcrt = !r.schedulable ? "> " + std::to_string(r.deadline)
+                         : r.upperBound   ? "<= " + std::to_string(r.wcrt)
+                                          : std::to_string(r.wcrt);
+        os << std::setw(10) << wcrt;
+        if (observed) os << std::setw(10) << (*observed)[i];
+        else          os << std::setw(10) << "";
+        os << (r.schedulable ? "yes" : "NO") << "\n";
+    }
+    os << "  " << std::string(68, '-') << "\n";
+}
@@ -0,0 +1,313 @@
+#include "Batch.h"
+#include "TaskSet.h"
+#include "ThreadPool.h"
+#include "Trace.h"
+#include <chrono>
+#include <iomanip>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+
+// ── Parsing ───────────────────────────────────────────────────
+namespace {
+
+constexpr Policy kAllPolicies[] = {
+    Policy::FCFS, Policy::RoundRobin, Policy::SJF, Policy::SRTF,
+    Policy::Priority, Policy::PreemptivePriority, Policy::Multilevel,
+    Policy::RateMonotonic, Policy::EDF,
+};
+
+// "a..b" or "a..b:step" -> values; false if `s` is not a range.
+bool parseRange(const std::string& s, std::vector<std::string>& values) {
+    auto dots = s.find("..");
+    if (dots == std::string::npos || dots == 0) return false;
+    auto colon = s.find(':', dots + 2);
+
+    std::size_t used;
+    int from = std::stoi(s.substr(0, dots), &used);
+    if (used != dots) return false;
+    std::string toText = s.substr(dots + 2, colon == std::string::npos
+                                                ? std::string::npos : colon - dots - 2);
+    int to   = std::stoi(toText, &used);
+    if (used != toText.size()) return false;
+    int step = colon == std::string::npos ? 1 : std::stoi(s.substr(colon + 1));
+    if (step <= 0 || to < from)
+        throw std::invalid_argument("bad range '" + s + "'");
+
+    for (long long v = from; v <= to; v += step) values.push_back(std::to_string(v));
+    return true;
+}
+
+// Cartesian product of every range in `args`.
+void expand(const std::vector<std::string>& args, std::size_t i,
+            std::vector<std::string>& current,
+            std::vector<std::vector<std::string>>& out) {
+    if (i == args.size()) { out.push_back(current); return; }
+    std::vector<std::string> values;
+    if (i == 0 || !parseRange(args[i], values))
+        values.assign(1, args[i]);
+    for (const auto& v : values) {
+        current.push_back(v);
+        expand(args, i + 1, current, out);
+        current.pop_back();
+    }
+}
+
+std::string joinParams(const std::vector<std::string>& args) {
+    std::string s;
+    for (std::size_t i = 1; i < args.size(); ++i) {
+        if (i > 1) s += ' ';
+        s += args[i];
+    }
+    return s;
+}
+
+} // namespace
+
+BatchPlan parseBatch(std::istream& in, const std::string& baseDir) {
+    BatchPlan plan;
+    std::map<std::string, int> byName;
+
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(in, line)) {
+        ++lineNo;
+        auto hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+
+        std::istringstream words(line);
+        std::vector<std::string> w;
+        for (std::string s; words >> s; ) w.push_back(s);
+        if (w.empty()) continue;
+
+        auto fail = [&](const std::string& what) {
+            return std::runtime_error("batch line " + std::to_string(lineNo) + ": " + what);
+        };
+
+        if (w[0] == "workload") {
+            if (w.size() != 3) throw fail("expected 'workload <name> <path>'");
+            if (byName.count(w[1])) throw fail("duplicate workload '" + w[1] + "'");
+            std::string path = w[2];
+            if (!baseDir.empty() && path[0] != '/') path = baseDir + "/" + path;
+            BatchWorkload wl;
+            wl.name = w[1];
+            try {
+                loadTasks(path, wl.tasks);
+            } catch (const std::exception& e) {
+                throw fail(e.what());
+            }
+            byName.emplace(wl.name, (int)plan.workloads.size());
+            plan.workloads.push_back(std::move(wl));
+
+        } else if (w[0] == "run") {
+            if (w.size() < 3) throw fail("expected 'run <workload|*> <policy|all> [options]'");
+
+            std::vector<int> targets;
+            if (w[1] == "*") {
+                for (int i = 0; i < (int)plan.workloads.size(); ++i) targets.push_back(i);
+            } else {
+                auto it = byName.find(w[1]);
+                if (it == byName.end()) throw fail("unknown workload '" + w[1] + "'");
+                targets.push_back(it->second);
+            }
+
+            std::vector<std::string> args(w.begin() + 2, w.end());
+            std::vector<std::vector<std::string>> variants;
+            std::vector<std::string> current;
+            try {
+                if (args[0] == "all") {
+                    for (Policy p : kAllPolicies) {
+                        args[0] = policyName(p);
+                        expand(args, 0, current, variants);
+                    }
+                } else {
+                    expand(args, 0, current, variants);
+                }
+                for (const auto& v : variants) {
+                    BatchJob job;
+                    job.options            = parseArgs(v);
+                    if (job.options.windowTo > 0)
+                        throw std::invalid_argument("--window is not supported in batch files");
+                    job.options.traceLevel = TraceLevel::Off;
+                    job.options.gantt      = false;
+                    job.params             = joinParams(v);
+                    for (int t : targets) {
+                        job.workload = t;
+                        plan.jobs.push_back(job);
+                    }
+                }
+            } catch (const std::exception& e) {
+                throw fail(e.what());
+            }
+
+        } else {
+            throw fail("unknown directive '" + w[0] + "'");
+        }
+    }
+    return plan;
+}
+
+// ── Execution ─────────────────────────────────────────────────
+namespace {
+
+// Owned by one pool worker and reused for every job it runs.  Task
+// vectors cycle through runScheduler() and come back in the result,
+// so a warm worker copies each workload into existing capacity.
+struct alignas(64) BatchWorker {
+    std::vector<Task> scratch;
+    NullSink          sink;
+};
+
+JobSummary summarizeJob(const ScheduleResult& res) {
+    JobSummary s;
+    double tat = 0, wt = 0;
+    for (const auto& t : res.tasks) {
+        tat += t.turnaroundTime;
+        wt  += t.waitingTime;
+    }
+    int n = (int)res.tasks.size();
+    s.avgTurnaround   = n ? tat / n : 0.0;
+    s.avgWaiting      = n ? wt  / n : 0.0;
+    s.deadlineMisses  = res.deadlineMisses;
+    s.contextSwitches = res.contextSwitches;
+    s.totalBusyTime   = res.totalBusyTime;
+    s.totalClockTime  = res.totalClockTime;
+    s.response        = res.latency.response;
+    return s;
+}
+
+} // namespace
+
+BatchReport runBatch(const BatchPlan& plan, unsigned threads) {
+    WorkStealingPool pool(threads);
+    std::vector<BatchWorker> workers(pool.size());
+
+    BatchReport report;
+    report.jobs.resize(plan.jobs.size());
+    report.threads = pool.size();
+
+    auto started = std::chrono::steady_clock::now();
+    pool.parallelFor(plan.jobs.size(), [&](std::size_t i, unsigned id) {
+        const BatchJob& job = plan.jobs[i];
+        BatchWorker&    w   = workers[id];
+        trace::ScopedSink scopedSink(w.sink);   // Sinks are per thread
+
+        const auto& tasks = plan.workloads[job.workload].tasks;
+        w.scratch.assign(tasks.begin(), tasks.end());
+        try {
+            ScheduleResult res = runScheduler(job.options.config, std::move(w.scratch));
+            report.jobs[i] = summarizeJob(res);
+            w.scratch = std::move(res.tasks);
+        } catch (const std::exception& e) {
+            report.jobs[i].error = e.what();
+            w.scratch.clear();
+        }
+    });
+    report.wallSeconds = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - started).count();
+    return report;
+}
+
+// ── Report ────────────────────────────────────────────────────
+void printBatchReport(const BatchPlan& plan, const BatchReport& report,
+                      std::ostream& os) {
+    auto util = [](const JobSummary& s) {
+        return s.totalClockTime > 0 ? 100.0 * s.totalBusyTime / s.totalClockTime : 0.0;
+    };
+
+    os << "\n  Batch Results\n";
+    os << "  " << std::string(106, '-') << "\n";
+    os << std::left
+       << "  " << std::setw(12) << "Workload"
+       << std::setw(21) << "Policy"
+       << std::setw(24) << "Params"
+       << std::setw(10) << "AvgTAT"
+       << std::setw(10) << "AvgWT"
+       << std::setw(10) << "P99Resp"
+       << std::setw(8)  << "Misses"
+       << std::setw(6)  << "CS"
+       << "Util\n";
+    os << "  " << std::string(106, '-') << "\n";
+
+    // Per-configuration means across workloads, in first-seen order;
+    // response histograms are merged, so P99 is over every job
+    struct Group {
+        std::string policy, params;
+        JobSummary  sum;
+        double      util = 0;
+        int         runs = 0, errors = 0;
+    };
+    std::vector<Group>         groups;
+    std::map<std::string, int> groupIndex;
+
+    os << std::fixed << std::setprecision(2);
+    for (std::size_t i = 0; i < plan.jobs.size(); ++i) {
+        const BatchJob&   job = plan.jobs[i];
+        const JobSummary& s   = report.jobs[i];
+        const char*       pol = policyName(job.options.config.policy);
+
+        os << "  " << std::setw(12) << plan.workloads[job.workload].name
+           << std::setw(21) << pol
+           << std::setw(24) << (job.params.empty() ? "-" : job.params);
+        if (!s.error.empty()) {
+            os << "error: " << s.error << "\n";
+        } else {
+            os << std::setw(10) << s.avgTurnaround
+               << std::setw(10) << s.avgWaiting
+               << std::setw(10) << s.response.percentile(99)
+               << std::setw(8)  << s.deadlineMisses
+               << std::setw(6)  << s.contextSwitches
+               << util(s) << "%\n";
+        }
+
+        std::string key = std::string(pol) + '\0' + job.params;
+        auto [it, added] = groupIndex.emplace(key, (int)groups.size());
+        if (added) groups.push_back({pol, job.params, {}, 0, 0, 0});
+        Group& g = groups[it->second];
+        if (!s.error.empty()) { ++g.errors; continue; }
+        g.sum.avgTurnaround   += s.avgTurnaround;
+        g.sum.avgWaiting      += s.avgWaiting;
+        g.sum.deadlineMisses  += s.deadlineMisses;
+        g.sum.contextSwitches += s.contextSwitches;
+        g.sum.response.merge(s.response);
+        g.util                += util(s);
+        ++g.runs;
+    }
+    os << "  " << std::string(106, '-') << "\n";
+
+    os << "\n  Mean per Configuration\n";
+    os << "  " << std::string(106, '-') << "\n";
+    os << "  " << std::setw(21) << "Policy"
+       << std::setw(24) << "Params"
+       << std::setw(7)  << "Runs"
+       << std::setw(10) << "AvgTAT"
+       << std::setw(10) << "AvgWT"
+       << std::setw(10) << "P99Resp"
+       << std::setw(8)  << "Misses"
+       << std::setw(6)  << "CS"
+       << "Util\n";
+    os << "  " << std::string(106, '-') << "\n";
+    for (const Group& g : groups) {
+        os << "  " << std::setw(21) << g.policy
+           << std::setw(24) << (g.params.empty() ? "-" : g.params)
+           << std::setw(7)  << g.runs;
+        if (g.runs == 0) {
+            os << "all failed\n";
+            continue;
+        }
+        os << std::setw(10) << g.sum.avgTurnaround / g.runs
+           << std::setw(10) << g.sum.avgWaiting / g.runs
+           << std::setw(10) << g.sum.response.percentile(99)
+           << std::setw(8)  << (double)g.sum.deadlineMisses / g.runs
+           << std::setw(6)  << (double)g.sum.contextSwitches / g.runs
+           << g.util / g.runs << "%"
+           << (g.errors ? "  (" + std::to_string(g.errors) + " failed)" : "") << "\n";
+    }
+    os << "  " << std::string(106, '-') << "\n";
+
+    double rate = report.wallSeconds > 0 ? plan.jobs.size() / report.wallSeconds : 0.0;
+    os << "  Jobs            : " << plan.jobs.size() << "\n"
+       << "  Worker Threads  : " << report.threads << "\n"
+       << "  Wall Time       : " << std::setprecision(3) << report.wallSeconds << " s\n"
+       << "  Throughput      : " << std::setprecision(1) << rate << " jobs/s\n";
+}
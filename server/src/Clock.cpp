@@ -0,0 +1,13 @@
+#include "Clock.h"
+#include <algorithm>
+#include <cassert>
+
+void SimClock::advanceTo(Tick t) {
+    assert(t >= now_ && "simulation clock cannot run backwards");
+    now_ = t;
+}
+
+Tick firstDeadlineViolation(Tick start, Tick len, Tick deadline) {
+    if (len <= 0 || start + len <= deadline) return kNever;
+    return std::max(start + 1, deadline + 1);
+}
@@ -0,0 +1,381 @@
+#include "DemandBound.h"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define RTOS_DEMAND_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace {
+
+// Largest tick count the double kernels handle exactly, with room
+// for the k * T products in the fix-up.
+constexpr double kExactLimit = 4503599627370496.0;   // 2^52
+
+// floor(x / T) for integral x and T: the reciprocal product is off by
+// at most one, and two exact compares put it right.
+inline double floorDiv(double x, double T, double invT) {
+    double k = std::floor(x * invT);
+    if (k * T > x)             k -= 1;
+    else if ((k + 1) * T <= x) k += 1;
+    return k;
+}
+
+// ── Scalar kernels ────────────────────────────────────────────
+double dbfScalar(const TaskTable& tt, double t) {
+    const double* C    = tt.wcet();
+    const double* T    = tt.period();
+    const double* D    = tt.deadline();
+    const double* invT = tt.invPeriod();
+    double sum = 0;
+    for (std::size_t i = 0, n = tt.size(); i < n; ++i) {
+        double jobs = floorDiv(t - D[i], T[i], invT[i]) + 1;
+        if (jobs > 0) sum += jobs * C[i];
+    }
+    return sum;
+}
+
+void dbfBatchScalar(const TaskTable& tt, const double* t, double* out, std::size_t m) {
+    for (std::size_t p = 0; p < m; ++p) out[p] = dbfScalar(tt, t[p]);
+}
+
+// Tasks with C = 0 add no demand step, so their deadlines are skipped
+// (this also keeps the vector kernel's padding entries out).
+double lastDeadlineScalar(const TaskTable& tt, double t) {
+    const double* C    = tt.wcet();
+    const double* T    = tt.period();
+    const double* D    = tt.deadline();
+    const double* invT = tt.invPeriod();
+    double best = -1;
+    for (std::size_t i = 0, n = tt.size(); i < n; ++i) {
+        double x = t - D[i];
+        if (x <= 0 || C[i] <= 0) continue;
+        double k = floorDiv(x, T[i], invT[i]);   // Largest k with k T < x
+        if (k * T[i] == x) k -= 1;
+        best = std::max(best, k * T[i] + D[i]);
+    }
+    return best;
+}
+
+// ── AVX2 kernels ──────────────────────────────────────────────
+#ifdef RTOS_DEMAND_AVX2
+
+#define RTOS_AVX2 __attribute__((target("avx2")))
+
+RTOS_AVX2 inline __m256d floorDiv4(__m256d x, __m256d T, __m256d invT) {
+    const __m256d one = _mm256_set1_pd(1.0);
+    __m256d k    = _mm256_floor_pd(_mm256_mul_pd(x, invT));
+    __m256d over = _mm256_cmp_pd(_mm256_mul_pd(k, T), x, _CMP_GT_OQ);
+    k = _mm256_sub_pd(k, _mm256_and_pd(over, one));
+    __m256d under = _mm256_cmp_pd(_mm256_mul_pd(_mm256_add_pd(k, one), T), x, _CMP_LE_OQ);
+    return _mm256_add_pd(k, _mm256_and_pd(under, one));
+}
+
+RTOS_AVX2 inline double hsum(__m256d v) {
+    __m128d s = _mm_add_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+}
+
+RTOS_AVX2 inline double hmax(__m256d v) {
+    __m128d s = _mm_max_pd(_mm256_castpd256_pd128(v), _mm256_extractf128_pd(v, 1));
+    return _mm_cvtsd_f64(_mm_max_sd(s, _mm_unpackhi_pd(s, s)));
+}
+
+RTOS_AVX2 double dbfAVX2(const TaskTable& tt, double t) {
+    const double* C    = tt.wcet();
+    const double* T    = tt.period();
+    const double* D    = tt.deadline();
+    const double* invT = tt.invPeriod();
+    const __m256d one  = _mm256_set1_pd(1.0);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d tv   = _mm256_set1_pd(t);
+
+    // Two accumulators hide the add latency
+    __m256d acc0 = zero, acc1 = zero;
+    const std::size_t n = tt.paddedSize();
+    std::size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        __m256d T0 = _mm256_load_pd(T + i), T1 = _mm256_load_pd(T + i + 4);
+        __m256d k0 = floorDiv4(_mm256_sub_pd(tv, _mm256_load_pd(D + i)), T0,
+                               _mm256_load_pd(invT + i));
+        __m256d k1 = floorDiv4(_mm256_sub_pd(tv, _mm256_load_pd(D + i + 4)), T1,
+                               _mm256_load_pd(invT + i + 4));
+        __m256d j0 = _mm256_max_pd(_mm256_add_pd(k0, one), zero);
+        __m256d j1 = _mm256_max_pd(_mm256_add_pd(k1, one), zero);
+        acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(j0, _mm256_load_pd(C + i)));
+        acc1 = _mm256_add_pd(acc1, _mm256_mul_pd(j1, _mm256_load_pd(C + i + 4)));
+    }
+    for (; i < n; i += 4) {
+        __m256d k = floorDiv4(_mm256_sub_pd(tv, _mm256_load_pd(D + i)),
+                              _mm256_load_pd(T + i), _mm256_load_pd(invT + i));
+        __m256d j = _mm256_max_pd(_mm256_add_pd(k, one), zero);
+        acc0 = _mm256_add_pd(acc0, _mm256_mul_pd(j, _mm256_load_pd(C + i)));
+    }
+    return hsum(_mm256_add_pd(acc0, acc1));
+}
+
+// Four test points per pass: each column block is loaded once and
+// used for every point.
+RTOS_AVX2 void dbfBatchAVX2(const TaskTable& tt, const double* t, double* out,
+                            std::size_t m) {
+    const double* C    = tt.wcet();
+    const double* T    = tt.period();
+    const double* D    = tt.deadline();
+    const double* invT = tt.invPeriod();
+    const __m256d one  = _mm256_set1_pd(1.0);
+    const __m256d zero = _mm256_setzero_pd();
+    const std::size_t n = tt.paddedSize();
+
+    for (std::size_t p = 0; p < m; p += 4) {
+        __m256d tv[4], acc[4];
+        for (int q = 0; q < 4; ++q) {
+            tv[q]  = _mm256_set1_pd(t[std::min(p + q, m - 1)]);
+            acc[q] = zero;
+        }
+        for (std::size_t i = 0; i < n; i += 4) {
+            __m256d Ci = _mm256_load_pd(C + i), Ti = _mm256_load_pd(T + i);
+            __m256d Di = _mm256_load_pd(D + i), Ii = _mm256_load_pd(invT + i);
+            for (int q = 0; q < 4; ++q) {
+                __m256d k = floorDiv4(_mm256_sub_pd(tv[q], Di), Ti, Ii);
+                __m256d j = _mm256_max_pd(_mm256_add_pd(k, one), zero);
+                acc[q] = _mm256_add_pd(acc[q], _mm256_mul_pd(j, Ci));
+            }
+        }
+        for (std::size_t q = 0; q < 4 && p + q < m; ++q) out[p + q] = hsum(acc[q]);
+    }
+}
+
+RTOS_AVX2 double lastDeadlineAVX2(const TaskTable& tt, double t) {
+    const double* C    = tt.wcet();
+    const double* T    = tt.period();
+    const double* D    = tt.deadline();
+    const double* invT = tt.invPeriod();
+    const __m256d one  = _mm256_set1_pd(1.0);
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d none = _mm256_set1_pd(-1.0);
+    const __m256d tv   = _mm256_set1_pd(t);
+
+    __m256d best = none;
+    for (std::size_t i = 0, n = tt.paddedSize(); i < n; i += 4) {
+        __m256d Ti = _mm256_load_pd(T + i), Di = _mm256_load_pd(D + i);
+        __m256d x  = _mm256_sub_pd(tv, Di);
+        __m256d k  = floorDiv4(x, Ti, _mm256_load_pd(invT + i));
+        __m256d kT = _mm256_mul_pd(k, Ti);
+        k  = _mm256_sub_pd(k, _mm256_and_pd(_mm256_cmp_pd(kT, x, _CMP_EQ_OQ), one));
+        __m256d d  = _mm256_add_pd(_mm256_mul_pd(k, Ti), Di);
+        __m256d ok = _mm256_and_pd(_mm256_cmp_pd(x, zero, _CMP_GT_OQ),
+                                   _mm256_cmp_pd(_mm256_load_pd(C + i), zero, _CMP_GT_OQ));
+        best = _mm256_max_pd(best, _mm256_blendv_pd(none, d, ok));
+    }
+    return hmax(best);
+}
+
+#undef RTOS_AVX2
+#endif // RTOS_DEMAND_AVX2
+
+// ── Dispatch ──────────────────────────────────────────────────
+struct Kernels {
+    DemandKernel kind;
+    double (*dbf)(const TaskTable&, double);
+    void   (*dbfBatch)(const TaskTable&, const double*, double*, std::size_t);
+    double (*lastDeadline)(const TaskTable&, double);
+};
+
+constexpr Kernels kScalar = {DemandKernel::Scalar, dbfScalar, dbfBatchScalar, lastDeadlineScalar};
+#ifdef RTOS_DEMAND_AVX2
+constexpr Kernels kAVX2   = {DemandKernel::AVX2, dbfAVX2, dbfBatchAVX2, lastDeadlineAVX2};
+#endif
+
+bool cpuHasAVX2() {
+#ifdef RTOS_DEMAND_AVX2
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+const Kernels* selectKernels(DemandKernel want) {
+#ifdef RTOS_DEMAND_AVX2
+    if (want == DemandKernel::AVX2 && cpuHasAVX2()) return &kAVX2;
+#endif
+    (void)want;
+    return &kScalar;
+}
+
+const Kernels*& kernels() {
+    static const Kernels* active = selectKernels(DemandKernel::AVX2);
+    return active;
+}
+
+// ceil(w / T) C summed over every task: the synchronous workload.
+double workload(const TaskTable& tt, double w) {
+    double sum = 0;
+    for (std::size_t i = 0; i < tt.size(); ++i)
+        sum += (floorDiv(w - 1, tt.period()[i], tt.invPeriod()[i]) + 1) * tt.wcet()[i];
+    return sum;
+}
+
+// L = min(La, Lb); the busy period is only iterated while it can
+// still undercut La.
+double testLimit(const TaskTable& tt, double U) {
+    double La = kExactLimit * 2;
+    if (U < 1.0 - 1e-12) {
+        double s = 0;
+        for (std::size_t i = 0; i < tt.size(); ++i)
+            s += (tt.period()[i] - tt.deadline()[i]) * tt.wcet()[i] * tt.invPeriod()[i];
+        La = std::floor(std::max(tt.maxDeadline(), s / (1.0 - U)));
+    }
+
+    double w = 0;
+    for (std::size_t i = 0; i < tt.size(); ++i) w += tt.wcet()[i];
+    while (w <= La && w <= kExactLimit) {
+        double next = workload(tt, w);
+        if (next == w) break;
+        w = next;
+    }
+    double L = std::min(La, w);
+    if (L > kExactLimit)
+        throw std::runtime_error("EDF test interval exceeds 2^52 ticks");
+    return L;
+}
+
+} // namespace
+
+DemandKernel activeDemandKernel() { return kernels()->kind; }
+
+void setDemandKernel(DemandKernel kernel) { kernels() = selectKernels(kernel); }
+
+const char* demandKernelName(DemandKernel kernel) {
+    return kernel == DemandKernel::AVX2 ? "avx2" : "scalar";
+}
+
+double demandBound(const TaskTable& table, double t) {
+    return kernels()->dbf(table, t);
+}
+
+void demandBound(const TaskTable& table, const double* t, double* out, std::size_t m) {
+    kernels()->dbfBatch(table, t, out, m);
+}
+
+double lastDeadlineBefore(const TaskTable& table, double t) {
+    return kernels()->lastDeadline(table, t);
+}
+
+// ── QPA ───────────────────────────────────────────────────────
+DemandReport analyzeEDF(const TaskTable& table) {
+    DemandReport rep;
+    rep.tasks       = table.size();
+    rep.utilization = table.utilization();
+    if (table.empty()) { rep.schedulable = true; return rep; }
+    if (rep.utilization > 1.0 + 1e-12) return rep;
+
+    const Kernels& k = *kernels();
+    const double dmin = table.minDeadline();
+    const double L    = testLimit(table, rep.utilization);
+    rep.testLimit = (std::int64_t)L;
+
+    double t = k.lastDeadline(table, L + 1);   // Deadlines <= L
+    while (t >= 0) {
+        double h = k.dbf(table, t);
+        ++rep.points;
+        if (h > t) {
+            rep.witness       = (std::int64_t)t;
+            rep.witnessDemand = (std::int64_t)h;
+            return rep;
+        }
+        if (h <= dmin) break;
+        t = h < t ? h : k.lastDeadline(table, t);
+    }
+    rep.schedulable = true;
+    return rep;
+}
+
+// ── Exhaustive test ───────────────────────────────────────────
+DemandReport analyzeEDFExhaustive(const TaskTable& table) {
+    DemandReport rep;
+    rep.method      = "exhaustive";
+    rep.tasks       = table.size();
+    rep.utilization = table.utilization();
+    if (table.empty()) { rep.schedulable = true; return rep; }
+    if (rep.utilization > 1.0 + 1e-12) return rep;
+
+    const Kernels& k = *kernels();
+    const double L = testLimit(table, rep.utilization);
+    rep.testLimit = (std::int64_t)L;
+
+    // Absolute deadlines <= L in increasing order, merged from every task
+    using Next = std::pair<double, std::size_t>;
+    std::priority_queue<Next, std::vector<Next>, std::greater<Next>> next;
+    for (std::size_t i = 0; i < table.size(); ++i)
+        if (table.wcet()[i] > 0 && table.deadline()[i] <= L)
+            next.push({table.deadline()[i], i});
+
+    constexpr std::size_t kBatch = 64;
+    double points[kBatch], demand[kBatch];
+    std::size_t m = 0;
+
+    auto flush = [&] {
+        k.dbfBatch(table, points, demand, m);
+        for (std::size_t p = 0; p < m; ++p) {
+            ++rep.points;
+            if (demand[p] > points[p]) {
+                rep.witness       = (std::int64_t)points[p];
+                rep.witnessDemand = (std::int64_t)demand[p];
+                return false;
+            }
+        }
+        m = 0;
+        return true;
+    };
+
+    while (!next.empty()) {
+        double d = next.top().first;
+        while (!next.empty() && next.top().first == d) {
+            std::size_t i = next.top().second;
+            next.pop();
+            double after = d + table.period()[i];
+            if (after <= L) next.push({after, i});
+        }
+        points[m++] = d;
+        if (m == kBatch && !flush()) return rep;
+    }
+    if (m > 0 && !flush()) return rep;
+    rep.schedulable = true;
+    return rep;
+}
+
+// ── Report ────────────────────────────────────────────────────
+void printDemandReport(const DemandReport& rep, std::ostream& os) {
+    os << "\n  EDF Demand Analysis [" << rep.method << "]\n";
+    os << "  " << std::string(68, '-') << "\n";
+    os << std::fixed << std::setprecision(4);
+    os << "  Tasks           : " << rep.tasks << "\n"
+       << "  Utilization     : " << rep.utilization << "\n";
+    if (rep.testLimit > 0)
+        os << "  Test interval   : " << rep.testLimit << " ticks\n";
+    os << "  dbf evaluations : " << rep.points << "\n"
+       << "  Kernel          : " << demandKernelName(activeDemandKernel()) << "\n"
+       << "  Verdict         : " << (rep.schedulable ? "SCHEDULABLE" : "NOT SCHEDULABLE");
+    if (rep.witness >= 0)
+        os << "  (dbf(" << rep.witness << ") = " << rep.witnessDemand << ")";
+    else if (!rep.schedulable)
+        os << "  (U > 1)";
+    os << "\n";
+}
+
+// ── Admission ─────────────────────────────────────────────────
+bool EdfAdmission::tryAdmit(const Task& task, DemandReport* report) {
+    table_.push_back(task);
+    DemandReport rep = analyzeEDF(table_);
+    if (!rep.schedulable) table_.pop_back();
+    if (report) *report = rep;
+    return rep.schedulable;
+}
@@ -0,0 +1,174 @@
+#include "Histogram.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+constexpr int         kSubBucketBits = LogHistogram::kSubBucketBits;
+constexpr std::size_t kSubBuckets    = LogHistogram::kSubBuckets;
+
+// Bucket b < 2 * kSubBuckets holds the magnitude b.  Above that,
+// magnitudes [2^e, 2^(e+1)) with e >= kSubBucketBits + 1 fill
+// kSubBuckets buckets of width 2^(e - kSubBucketBits).
+std::uint32_t bucketOf(std::uint64_t magnitude) {
+    if (magnitude < 2 * kSubBuckets) return (std::uint32_t)magnitude;
+    const int e     = 63 - __builtin_clzll(magnitude);
+    const int shift = e - kSubBucketBits;
+    return (std::uint32_t)(2 * kSubBuckets + (std::size_t)(shift - 1) * kSubBuckets +
+                           ((magnitude >> shift) - kSubBuckets));
+}
+
+std::uint64_t lowestIn(std::uint32_t bucket) {
+    if (bucket < 2 * kSubBuckets) return bucket;
+    const std::size_t k     = bucket - 2 * kSubBuckets;
+    const int         shift = (int)(k / kSubBuckets) + 1;
+    return (std::uint64_t)(kSubBuckets + k % kSubBuckets) << shift;
+}
+
+std::uint64_t highestIn(std::uint32_t bucket) {
+    if (bucket < 2 * kSubBuckets) return bucket;
+    const int shift = (int)((bucket - 2 * kSubBuckets) / kSubBuckets) + 1;
+    return lowestIn(bucket) + ((std::uint64_t)1 << shift) - 1;
+}
+
+// Histograms with at most this many buckets merge one bucket at a time
+constexpr std::size_t kSmallMerge = 8;
+
+} // namespace
+
+std::uint32_t LogHistogram::keyOf(std::int64_t value) {
+    if (value >= 0) return kZeroKey + bucketOf((std::uint64_t)value);
+    return kZeroKey - bucketOf(0 - (std::uint64_t)value);
+}
+
+std::int64_t LogHistogram::topOf(std::uint32_t key) {
+    if (key >= kZeroKey) return (std::int64_t)highestIn(key - kZeroKey);
+    return -(std::int64_t)lowestIn(kZeroKey - key);
+}
+
+void LogHistogram::add(std::uint32_t key, std::uint64_t n) {
+    // Samples of one task cluster: try the last bucket first
+    if (!buckets_.empty() && buckets_.back().key == key) {
+        buckets_.back().count += n;
+        return;
+    }
+    auto it = std::lower_bound(buckets_.begin(), buckets_.end(), key,
+                               [](const Bucket& b, std::uint32_t k) { return b.key < k; });
+    if (it != buckets_.end() && it->key == key) it->count += n;
+    else                                        buckets_.insert(it, Bucket{key, n});
+}
+
+void LogHistogram::record(std::int64_t value, std::uint64_t count) {
+    if (count == 0) return;
+    add(keyOf(value), count);
+
+    if (count_ == 0) {
+        min_ = max_ = value;
+    } else {
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+    count_ += count;
+    sum_   += (double)value * (double)count;
+}
+
+void LogHistogram::merge(const LogHistogram& other) {
+    if (other.count_ == 0) return;
+    if (other.buckets_.size() <= kSmallMerge) {
+        for (const Bucket& b : other.buckets_) add(b.key, b.count);
+    } else {
+        std::vector<Bucket> merged;
+        merged.reserve(buckets_.size() + other.buckets_.size());
+        auto a = buckets_.begin();
+        auto b = other.buckets_.begin();
+        while (a != buckets_.end() || b != other.buckets_.end()) {
+            if (b == other.buckets_.end() || (a != buckets_.end() && a->key < b->key)) {
+                merged.push_back(*a++);
+            } else if (a == buckets_.end() || b->key < a->key) {
+                merged.push_back(*b++);
+            } else {
+                merged.push_back(Bucket{a->key, a->count + b->count});
+                ++a;
+                ++b;
+            }
+        }
+        buckets_ = std::move(merged);
+    }
+
+    if (count_ == 0) {
+        min_ = other.min_;
+        max_ = other.max_;
+    } else {
+        min_ = std::min(min_, other.min_);
+        max_ = std::max(max_, other.max_);
+    }
+    count_ += other.count_;
+    sum_   += other.sum_;
+}
+
+void LogHistogram::addDifference(const LogHistogram& later, const LogHistogram& earlier,
+                                 std::int64_t times) {
+    if (times <= 0 || later.count_ == earlier.count_) return;
+
+    // `earlier` has a subset of `later`'s buckets, each no fuller
+    auto e = earlier.buckets_.begin();
+    for (const Bucket& b : later.buckets_) {
+        while (e != earlier.buckets_.end() && e->key < b.key) ++e;
+        std::uint64_t before = e != earlier.buckets_.end() && e->key == b.key ? e->count : 0;
+        if (b.count != before) add(b.key, (b.count - before) * (std::uint64_t)times);
+    }
+
+    if (count_ == 0) {
+        min_ = later.min_;
+        max_ = later.max_;
+    } else {
+        min_ = std::min(min_, later.min_);
+        max_ = std::max(max_, later.max_);
+    }
+    count_ += (later.count_ - earlier.count_) * (std::uint64_t)times;
+    sum_   += (later.sum_ - earlier.sum_) * (double)times;
+}
+
+void LogHistogram::clear() {
+    buckets_ = std::vector<Bucket>{};
+    count_ = 0;
+    min_ = max_ = 0;
+    sum_ = 0;
+}
+
+std::int64_t LogHistogram::percentile(double percent) const {
+    if (count_ == 0) return 0;
+    if (percent <= 0) return min_;
+    const double        share = std::min(percent, 100.0) / 100.0;
+    const std::uint64_t rank  = std::max<std::uint64_t>(
+        1, (std::uint64_t)std::ceil(share * (double)count_));
+
+    std::uint64_t seen = 0;
+    for (const Bucket& b : buckets_) {
+        seen += b.count;
+        if (seen >= rank) return std::clamp(topOf(b.key), min_, max_);
+    }
+    return max_;
+}
+
+void JobLatency::merge(const JobLatency& other) {
+    response.merge(other.response);
+    waiting.merge(other.waiting);
+    lateness.merge(other.lateness);
+    jitter.merge(other.jitter);
+}
+
+void JobLatency::addDifference(const JobLatency& later, const JobLatency& earlier,
+                               std::int64_t times) {
+    response.addDifference(later.response, earlier.response, times);
+    waiting.addDifference(later.waiting, earlier.waiting, times);
+    lateness.addDifference(later.lateness, earlier.lateness, times);
+    jitter.addDifference(later.jitter, earlier.jitter, times);
+}
+
+void JobLatency::clear() {
+    response.clear();
+    waiting.clear();
+    lateness.clear();
+    jitter.clear();
+}
@@ -0,0 +1,262 @@
+#include "Incremental.h"
+#include "Algorithms/FCFS.h"
+#include "Trace.h"
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+// Task parameters, as bits of changedFields()
+enum : unsigned {
+    kId               = 1u << 0,
+    kName             = 1u << 1,
+    kArrival          = 1u << 2,
+    kBurst            = 1u << 3,
+    kPriority         = 1u << 4,
+    kPeriod           = 1u << 5,
+    kRelativeDeadline = 1u << 6,
+    kHardDeadline     = 1u << 7,
+};
+
+// Parameters each policy never reads (Task.h); hardDeadline only
+// marks FCFS / RR tasks late and is patched separately.  RR reads
+// what FCFS reads.
+constexpr unsigned kIgnoredByFCFS = kName | kPriority | kPeriod | kRelativeDeadline;
+constexpr unsigned kIgnoredByEDF  = kName | kArrival | kPriority | kHardDeadline;
+
+unsigned changedFields(const Task& a, const Task& b) {
+    unsigned changed = 0;
+    if (a.id != b.id)                             changed |= kId;
+    if (a.name != b.name)                         changed |= kName;
+    if (a.arrivalTime != b.arrivalTime)           changed |= kArrival;
+    if (a.burstTime != b.burstTime)               changed |= kBurst;
+    if (a.priority != b.priority)                 changed |= kPriority;
+    if (a.period != b.period)                     changed |= kPeriod;
+    if (a.relativeDeadline != b.relativeDeadline) changed |= kRelativeDeadline;
+    if (a.hardDeadline != b.hardDeadline)         changed |= kHardDeadline;
+    return changed;
+}
+
+// Copies the parameters, leaving the run-time fields alone.
+void assignParameters(Task& to, const Task& from) {
+    to.id               = from.id;
+    to.name             = from.name;
+    to.arrivalTime      = from.arrivalTime;
+    to.burstTime        = from.burstTime;
+    to.priority         = from.priority;
+    to.period           = from.period;
+    to.relativeDeadline = from.relativeDeadline;
+    to.hardDeadline     = from.hardDeadline;
+}
+
+bool sameConfig(const SchedulerConfig& a, const SchedulerConfig& b) {
+    return a.policy == b.policy && a.quantum == b.quantum && a.csPenalty == b.csPenalty &&
+           a.agingInterval == b.agingInterval && a.feedback == b.feedback &&
+           a.horizon == b.horizon && a.steadyState == b.steadyState;
+}
+
+} // namespace
+
+const ScheduleResult& IncrementalScheduler::run(const SchedulerConfig& config,
+                                                std::vector<Task> tasks) {
+    if (!valid_ || !sameConfig(config, config_) || tasks.size() != input_.size() ||
+        trace::sink().level() != TraceLevel::Off)
+        return fullRun(config, std::move(tasks));
+
+    const std::size_t n = tasks.size();
+    std::size_t k = n;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (changedFields(tasks[i], input_[i]) == 0) continue;
+        if (k != n) return fullRun(config, std::move(tasks));   // A second edit
+        k = i;
+    }
+    resumedAt_ = kNever;
+    if (k == n) return result_;
+
+    // Unnamed tasks have no label (labelTasks), and labels are not removed
+    const unsigned changed = changedFields(tasks[k], input_[k]);
+    if ((changed & kName) && tasks[k].name.empty()) return fullRun(config, std::move(tasks));
+    valid_ = false;
+    bool done = false;
+    switch (config.policy) {
+    case Policy::FCFS:       done = editFCFS(k, tasks[k]); break;
+    case Policy::RoundRobin: done = editRR(k, tasks[k]);   break;
+    case Policy::EDF:
+        done = (changed & ~kIgnoredByEDF) == 0;
+        if (done) patch(k, tasks[k], changed);
+        break;
+    default:
+        break;
+    }
+    if (!done) return fullRun(config, std::move(tasks));
+
+    // One-shot latency is read off the tasks; EDF's comes from job
+    // counters a patch leaves alone
+    if (config.policy != Policy::EDF) recordLatency(result_);
+    input_[k] = std::move(tasks[k]);
+    valid_    = true;
+    return result_;
+}
+
+const ScheduleResult& IncrementalScheduler::fullRun(const SchedulerConfig& config,
+                                                    std::vector<Task> tasks) {
+    valid_     = false;
+    resumedAt_ = 0;
+    checkpoints_.clear();
+    config_ = config;
+    input_  = tasks;
+
+    // FCFS and RR the way runScheduler() runs them, keeping what an
+    // edit resumes from
+    switch (config.policy) {
+    case Policy::FCFS:
+        resetRunState(tasks);
+        result_ = FCFSScheduler(config.csPenalty).run(std::move(tasks));
+        recordLatency(result_);
+        break;
+    case Policy::RoundRobin:
+        resetRunState(tasks);
+        rr_.configure(config.quantum, config.csPenalty);
+        result_ = rr_.run(std::move(tasks), &checkpoints_);
+        recordLatency(result_);
+        break;
+    default:
+        result_ = runScheduler(config, std::move(tasks));
+        break;
+    }
+    valid_ = true;
+    return result_;
+}
+
+// Tasks run in arrival order, so nothing before the edited task's
+// first position (old or new) changes.
+bool IncrementalScheduler::editFCFS(std::size_t k, const Task& edited) {
+    const Task&    old     = input_[k];
+    const unsigned changed = changedFields(edited, old);
+    if (changed & kId) return false;
+
+    const std::size_t from = sortedPosition(k, old.arrivalTime);
+    if ((changed & ~(kIgnoredByFCFS | kHardDeadline)) == 0) {
+        patch(from, edited, changed);
+        return true;
+    }
+
+    const std::size_t to    = sortedPosition(k, edited.arrivalTime);
+    const std::size_t first = std::min(from, to);
+    resumedAt_ = first > 0 ? result_.tasks[first - 1].completionTime : 0;
+
+    assignParameters(result_.tasks[from], edited);
+    moveTask(from, to);
+    if (!edited.name.empty()) result_.gantt.setLabel(edited.id, edited.name);
+    FCFSScheduler(config_.csPenalty).resume(result_, first);
+    return true;
+}
+
+// Before the edited task arrives (in either version) the queue holds
+// the same tasks.  A burst edit changes nothing while every slice of
+// the task is a whole quantum in both versions: a checkpoint still
+// holds if the task is queued with work left under the new burst.
+bool IncrementalScheduler::editRR(std::size_t k, const Task& edited) {
+    const Task&    old     = input_[k];
+    const unsigned changed = changedFields(edited, old);
+    if (changed & kId) return false;
+
+    const std::size_t from = sortedPosition(k, old.arrivalTime);
+    if ((changed & ~(kIgnoredByFCFS | kHardDeadline)) == 0) {
+        patch(from, edited, changed);
+        return true;
+    }
+
+    const std::size_t to        = sortedPosition(k, edited.arrivalTime);
+    const int         first     = (int)std::min(from, to);
+    const bool        burstOnly = (changed & kArrival) == 0;
+    const int         delta     = edited.burstTime - old.burstTime;
+
+    auto unchanged = [&](const RRCheckpoint& cp) {
+        if (cp.nextArrive <= first && cp.clock < edited.arrivalTime) return true;
+        if (!burstOnly) return false;
+        for (const RRCheckpoint::Queued& q : cp.queue)
+            if (q.index == first) return q.remaining + delta > 0;
+        return false;
+    };
+    auto last = std::partition_point(checkpoints_.begin(), checkpoints_.end(), unchanged);
+    if (last == checkpoints_.begin()) return false;
+
+    const std::size_t c  = (std::size_t)(last - checkpoints_.begin()) - 1;
+    RRCheckpoint      cp = std::move(checkpoints_[c]);
+    checkpoints_.resize(c);
+
+    // The checkpoints kept are the new run's too, once the edited
+    // task's queued work follows the new burst
+    if (burstOnly && delta != 0) {
+        for (std::size_t i = c + 1; i-- > 0; ) {
+            RRCheckpoint& saved  = i == c ? cp : checkpoints_[i];
+            bool          queued = false;
+            for (RRCheckpoint::Queued& q : saved.queue) {
+                if (q.index != first) continue;
+                q.remaining += delta;
+                queued = true;
+            }
+            if (!queued) break;   // Not arrived yet, nor earlier
+        }
+    }
+
+    resumedAt_ = cp.clock;
+    assignParameters(result_.tasks[from], edited);
+    moveTask(from, to);
+    for (std::size_t i = (std::size_t)cp.nextArrive; i < result_.tasks.size(); ++i)
+        resetRunState(result_.tasks[i]);
+    if (!edited.name.empty()) result_.gantt.setLabel(edited.id, edited.name);
+    rr_.resume(result_, cp, &checkpoints_);
+    return true;
+}
+
+// Only parameters the schedule does not depend on changed.
+void IncrementalScheduler::patch(std::size_t position, const Task& edited, unsigned changed) {
+    Task& t = result_.tasks[position];
+
+    if (changed & kName) {
+        result_.gantt.setLabel(t.id, edited.name);
+        t.name = edited.name;
+    }
+    if (changed & kArrival)          t.arrivalTime      = edited.arrivalTime;
+    if (changed & kPriority)         t.priority         = edited.priority;
+    if (changed & kPeriod)           t.period           = edited.period;
+    if (changed & kRelativeDeadline) t.relativeDeadline = edited.relativeDeadline;
+    if (changed & kHardDeadline) {
+        t.hardDeadline = edited.hardDeadline;
+
+        // FCFS / RR: late iff some slice ends past the deadline, i.e.
+        // the last one (firstDeadlineViolation)
+        if (config_.policy == Policy::FCFS || config_.policy == Policy::RoundRobin) {
+            bool missed = t.hardDeadline > 0 && t.burstTime > 0 &&
+                          t.completionTime > t.hardDeadline;
+            result_.deadlineMisses += (int)missed - (int)t.deadlineMissed;
+            t.deadlineMissed = missed;
+
+            // RR checkpoints hold the old flag once the task has arrived
+            auto arrived = std::partition_point(
+                checkpoints_.begin(), checkpoints_.end(),
+                [&](const RRCheckpoint& cp) { return cp.nextArrive <= (int)position; });
+            checkpoints_.erase(arrived, checkpoints_.end());
+        }
+    }
+}
+
+// Position of input_[k] in arrival order (stable) if it arrived at
+// `arrival`.
+std::size_t IncrementalScheduler::sortedPosition(std::size_t k, Tick arrival) const {
+    std::size_t position = 0;
+    for (std::size_t j = 0; j < input_.size(); ++j) {
+        if (j == k) continue;
+        Tick a = input_[j].arrivalTime;
+        if (a < arrival || (a == arrival && j < k)) ++position;
+    }
+    return position;
+}
+
+void IncrementalScheduler::moveTask(std::size_t from, std::size_t to) {
+    auto at = [this](std::size_t i) { return result_.tasks.begin() + (std::ptrdiff_t)i; };
+    if (from < to)      std::rotate(at(from), at(from + 1), at(to + 1));
+    else if (to < from) std::rotate(at(to), at(from), at(from + 1));
+}
@@ -0,0 +1,159 @@
+#include "Instrument.h"
+#include <cstring>
+#include <iomanip>
+#include <string>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+constexpr const char* kPhaseNames[kPhaseCount] = {
+    "release", "queue", "deadline", "output",
+};
+
+constexpr const char* kCounterNames[kCounterCount] = {
+    "releases", "dispatches", "preemptions", "queuePushes", "queuePops",
+    "completions", "deadlineMisses",
+};
+
+#ifdef __linux__
+// Same order as HardwareCounters; instructions lead the group
+constexpr std::uint64_t kHardwareConfig[] = {
+    PERF_COUNT_HW_INSTRUCTIONS,
+    PERF_COUNT_HW_CPU_CYCLES,
+    PERF_COUNT_HW_CACHE_MISSES,
+    PERF_COUNT_HW_BRANCH_MISSES,
+};
+
+int openCounter(std::uint64_t config, int group) {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof attr);
+    attr.size           = sizeof attr;
+    attr.type           = PERF_TYPE_HARDWARE;
+    attr.config         = config;
+    attr.disabled       = group < 0;   // The leader starts the group
+    attr.exclude_kernel = 1;           // Allowed at perf_event_paranoid 2
+    attr.exclude_hv     = 1;
+    attr.read_format    = PERF_FORMAT_ID;
+    return (int)syscall(SYS_perf_event_open, &attr, 0, -1, group, 0);
+}
+
+std::int64_t readCounter(int fd) {
+    struct {
+        std::uint64_t value;
+        std::uint64_t id;
+    } data;
+    if (fd < 0 || read(fd, &data, sizeof data) != (ssize_t)sizeof data) return -1;
+    return (std::int64_t)data.value;
+}
+#endif
+
+} // namespace
+
+const char* phaseName(Phase phase) {
+    return kPhaseNames[(int)phase];
+}
+
+const char* counterName(Counter counter) {
+    return kCounterNames[(int)counter];
+}
+
+const char* instrument::clockName() {
+#if defined(__x86_64__) || defined(__i386__)
+    return "tsc";
+#else
+    return "ns";
+#endif
+}
+
+RunProfiler::RunProfiler() : outer_(instrument::current) {
+    fds_.fill(-1);
+#ifdef __linux__
+    // A container or perf_event_paranoid 3 refuses the leader: no
+    // hardware counts, the rest of the profile is unaffected
+    fds_[0] = openCounter(kHardwareConfig[0], -1);
+    if (fds_[0] >= 0) {
+        for (int i = 1; i < kHardwareEvents; ++i)
+            fds_[i] = openCounter(kHardwareConfig[i], fds_[0]);
+        ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+#endif
+    instrument::current = &profile_;
+    startWall_          = std::chrono::steady_clock::now();
+    profile_.totalTicks = instrument::now();
+}
+
+RunProfiler::~RunProfiler() {
+    if (running_) finish();
+#ifdef __linux__
+    for (int fd : fds_)
+        if (fd >= 0) close(fd);
+#endif
+}
+
+const RunProfile& RunProfiler::finish() {
+    if (!running_) return profile_;
+    running_ = false;
+
+    profile_.totalTicks = instrument::now() - profile_.totalTicks;
+    profile_.wallNanos  = (std::uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - startWall_).count();
+    instrument::current = outer_;
+
+#ifdef __linux__
+    if (fds_[0] >= 0) {
+        ioctl(fds_[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+        profile_.hardware.instructions = readCounter(fds_[0]);
+        profile_.hardware.cycles       = readCounter(fds_[1]);
+        profile_.hardware.cacheMisses  = readCounter(fds_[2]);
+        profile_.hardware.branchMisses = readCounter(fds_[3]);
+    }
+#endif
+    return profile_;
+}
+
+void printProfile(const RunProfile& p, const std::string& title, std::ostream& os) {
+    const double total = p.totalTicks ? (double)p.totalTicks : 1.0;
+
+    os << "\n  Run Profile [" << title << "]  (" << p.wallNanos / 1000 << " us, "
+       << p.totalTicks << " " << instrument::clockName() << " ticks)\n";
+    os << "  " << std::string(56, '-') << "\n";
+    os << std::left
+       << "  " << std::setw(12) << "Phase"
+       << std::setw(18) << "Ticks"
+       << std::setw(10) << "Share %"
+       << "Calls\n";
+    os << "  " << std::string(56, '-') << "\n";
+    os << std::fixed << std::setprecision(1);
+    for (int i = 0; i < kPhaseCount; ++i) {
+        os << "  " << std::setw(12) << kPhaseNames[i]
+           << std::setw(18) << p.phaseTicks[i]
+           << std::setw(10) << 100.0 * (double)p.phaseTicks[i] / total
+           << p.phaseCalls[i] << "\n";
+    }
+    os << "  " << std::string(56, '-') << "\n";
+    for (int i = 0; i < kCounterCount; ++i)
+        os << "  " << std::setw(30) << kCounterNames[i] << p.counters[i] << "\n";
+
+    const HardwareCounters& hw = p.hardware;
+    auto row = [&os](const char* name, std::int64_t v) {
+        os << "  " << std::setw(30) << name;
+        if (v < 0) os << "n/a\n";
+        else       os << v << "\n";
+    };
+    os << "  " << std::string(56, '-') << "\n";
+    if (hw.instructions < 0) {
+        os << "  hardware counters unavailable (perf_event_open)\n";
+    } else {
+        row("instructions", hw.instructions);
+        row("cycles",       hw.cycles);
+        row("cacheMisses",  hw.cacheMisses);
+        row("branchMisses", hw.branchMisses);
+    }
+    os << "  " << std::string(56, '-') << "\n";
+}
@@ -0,0 +1,374 @@
+#include "JsonExporter.h"
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+
+// ── BufferedWriter ────────────────────────────────────────────
+BufferedWriter::~BufferedWriter() {
+    try {
+        flush();
+    } catch (...) {
+        // Reported by an explicit flush(); nothing to do here
+    }
+}
+
+void BufferedWriter::write(const char* p, std::size_t n) {
+    while (n > 0) {
+        if (len_ == kCapacity) drain();
+        std::size_t chunk = std::min(n, kCapacity - len_);
+        std::memcpy(buf_ + len_, p, chunk);
+        len_ += chunk;
+        p    += chunk;
+        n    -= chunk;
+    }
+}
+
+void BufferedWriter::writeInt(long long v) {
+    char digits[24];
+    char* end = digits + sizeof digits;
+    char* p   = end;
+    // Work in unsigned so LLONG_MIN negates cleanly
+    unsigned long long u = v < 0 ? 0ull - (unsigned long long)v : (unsigned long long)v;
+    do {
+        *--p = char('0' + u % 10);
+        u /= 10;
+    } while (u);
+    if (v < 0) *--p = '-';
+    write(p, (std::size_t)(end - p));
+}
+
+void BufferedWriter::writeFixed(double v, int decimals) {
+    if (!std::isfinite(v)) { write("null", 4); return; }
+
+    static constexpr long long kPow10[] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+    assert(decimals >= 0 && decimals <= 6);
+    const long long scale = kPow10[decimals];
+
+    // Beyond 2^53 the fraction is noise anyway; let printf handle it
+    if (std::fabs(v) * scale >= 9.0e15) {
+        char tmp[32];
+        int n = std::snprintf(tmp, sizeof tmp, "%.*f", decimals, v);
+        write(tmp, (std::size_t)n);
+        return;
+    }
+
+    long long scaled = std::llround(v * scale);
+    if (scaled < 0) { put('-'); scaled = -scaled; }
+    writeInt(scaled / scale);
+    if (decimals == 0) return;
+
+    put('.');
+    char frac[6];
+    long long f = scaled % scale;
+    for (int i = decimals - 1; i >= 0; --i) {
+        frac[i] = char('0' + f % 10);
+        f /= 10;
+    }
+    write(frac, (std::size_t)decimals);
+}
+
+void BufferedWriter::writeI32LE(std::int32_t v) {
+    writeU32LE((std::uint32_t)v);
+}
+
+void BufferedWriter::writeU32LE(std::uint32_t v) {
+    if (kCapacity - len_ < 4) drain();
+    buf_[len_++] = char(v);
+    buf_[len_++] = char(v >> 8);
+    buf_[len_++] = char(v >> 16);
+    buf_[len_++] = char(v >> 24);
+}
+
+void BufferedWriter::flush() {
+    drain();
+}
+
+void BufferedWriter::drain() {
+    if (len_ == 0) return;
+    if (out_) {
+        out_->append(buf_, len_);
+        len_ = 0;
+        return;
+    }
+
+    const char* p = buf_;
+    std::size_t n = len_;
+    len_ = 0;
+    while (n > 0) {
+        ssize_t w = ::write(fd_, p, n);
+        if (w < 0) {
+            if (errno == EINTR) continue;
+            throw std::runtime_error(std::string("write failed: ") + std::strerror(errno));
+        }
+        p += w;
+        n -= (std::size_t)w;
+    }
+}
+
+// ── JsonWriter ────────────────────────────────────────────────
+void JsonWriter::open(char c) {
+    separator();
+    out_.put(c);
+    ++depth_;
+    assert(depth_ < 64 && "JSON nested too deeply");
+    hasItem_ &= ~(1ull << depth_);
+}
+
+void JsonWriter::close(char c) {
+    assert(depth_ > 0 && "unbalanced JSON");
+    --depth_;
+    out_.put(c);
+}
+
+void JsonWriter::key(std::string_view k) {
+    separator();
+    string(k);
+    out_.put(':');
+    afterKey_ = true;
+}
+
+void JsonWriter::separator() {
+    if (afterKey_) { afterKey_ = false; return; }
+    const std::uint64_t bit = 1ull << depth_;
+    if (hasItem_ & bit) out_.put(',');
+    hasItem_ |= bit;
+}
+
+void JsonWriter::string(std::string_view s) {
+    static constexpr char kHex[] = "0123456789abcdef";
+    out_.put('"');
+    std::size_t run = 0;   // Start of the pending unescaped run
+    for (std::size_t i = 0; i < s.size(); ++i) {
+        unsigned char c = (unsigned char)s[i];
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+        out_.write(s.data() + run, i - run);
+        run = i + 1;
+        out_.put('\\');
+        switch (c) {
+        case '"':  out_.put('"');  break;
+        case '\\': out_.put('\\'); break;
+        case '\n': out_.put('n');  break;
+        case '\r': out_.put('r');  break;
+        case '\t': out_.put('t');  break;
+        default:
+            out_.write("u00", 3);
+            out_.put(kHex[c >> 4]);
+            out_.put(kHex[c & 15]);
+        }
+    }
+    out_.write(s.data() + run, s.size() - run);
+    out_.put('"');
+}
+
+// ── Exporters ─────────────────────────────────────────────────
+namespace {
+
+// Labels come from the task table rather than SegmentTrace::label(),
+// which builds a std::string per call.
+std::string_view taskLabel(const Task& t, char (&scratch)[24]) {
+    if (!t.name.empty()) return t.name;
+    int n = std::snprintf(scratch, sizeof scratch, "%d", t.id);
+    return std::string_view(scratch, (std::size_t)n);
+}
+
+// { "count", "mean", "min", "p50", "p90", "p99", "p999", "max" }
+void writeHistogram(JsonWriter& json, const LogHistogram& h) {
+    json.beginObject();
+    json.key("count"); json.value((long long)h.count());
+    json.key("mean");  json.value(h.mean());
+    json.key("min");   json.value((long long)h.min());
+    json.key("p50");   json.value((long long)h.percentile(50));
+    json.key("p90");   json.value((long long)h.percentile(90));
+    json.key("p99");   json.value((long long)h.percentile(99));
+    json.key("p999");  json.value((long long)h.percentile(99.9));
+    json.key("max");   json.value((long long)h.max());
+    json.endObject();
+}
+
+void writeLatency(JsonWriter& json, const JobLatency& latency) {
+    json.beginObject();
+    json.key("response"); writeHistogram(json, latency.response);
+    json.key("waiting");  writeHistogram(json, latency.waiting);
+    json.key("lateness"); writeHistogram(json, latency.lateness);
+    json.key("jitter");   writeHistogram(json, latency.jitter);
+    json.endObject();
+}
+
+void writeProfile(JsonWriter& json, const RunProfile& p) {
+    json.beginObject();
+    json.key("clock");  json.value(instrument::clockName());
+    json.key("ticks");  json.value((long long)p.totalTicks);
+    json.key("wallNs"); json.value((long long)p.wallNanos);
+
+    json.key("phases");
+    json.beginObject();
+    for (int i = 0; i < kPhaseCount; ++i) {
+        json.key(phaseName(Phase(i)));
+        json.beginObject();
+        json.key("ticks"); json.value((long long)p.phaseTicks[i]);
+        json.key("calls"); json.value((long long)p.phaseCalls[i]);
+        json.endObject();
+    }
+    json.endObject();
+
+    json.key("counters");
+    json.beginObject();
+    for (int i = 0; i < kCounterCount; ++i) {
+        json.key(counterName(Counter(i)));
+        json.value((long long)p.counters[i]);
+    }
+    json.endObject();
+
+    const HardwareCounters& hw = p.hardware;
+    auto counter = [&json](const char* name, std::int64_t v) {
+        json.key(name);
+        if (v < 0) json.null();
+        else       json.value((long long)v);
+    };
+    json.key("hardware");
+    if (hw.instructions < 0) {
+        json.null();
+    } else {
+        json.beginObject();
+        counter("instructions", hw.instructions);
+        counter("cycles",       hw.cycles);
+        counter("cacheMisses",  hw.cacheMisses);
+        counter("branchMisses", hw.branchMisses);
+        json.endObject();
+    }
+    json.endObject();
+}
+
+} // namespace
+
+void exportJson(const ScheduleResult& res, const char* policy, BufferedWriter& out,
+                const RunProfile* profile) {
+    JsonWriter json(out);
+    char idText[24], labelText[24];
+
+    json.beginObject();
+    json.key("policy");
+    json.value(policy);
+
+    json.key("gantt");
+    json.beginObject();
+    json.key("task");
+    json.beginArray();
+    for (const Segment& s : res.gantt) json.value(s.task);
+    json.endArray();
+    json.key("start");
+    json.beginArray();
+    for (const Segment& s : res.gantt) json.value(s.start);
+    json.endArray();
+    json.key("end");
+    json.beginArray();
+    for (const Segment& s : res.gantt) json.value(s.end);
+    json.endArray();
+    json.key("labels");
+    json.beginObject();
+    for (const Task& t : res.tasks) {
+        int n = std::snprintf(idText, sizeof idText, "%d", t.id);
+        json.key(std::string_view(idText, (std::size_t)n));
+        json.value(taskLabel(t, labelText));
+    }
+    json.endObject();
+    json.endObject();
+
+    json.key("tasks");
+    json.beginArray();
+    double totalTAT = 0, totalWT = 0;
+    for (const Task& t : res.tasks) {
+        json.beginObject();
+        json.key("id");               json.value(t.id);
+        json.key("name");             json.value(std::string_view(t.name));
+        json.key("arrivalTime");      json.value(t.arrivalTime);
+        json.key("burstTime");        json.value(t.burstTime);
+        json.key("priority");         json.value(t.priority);
+        json.key("period");           json.value(t.period);
+        json.key("relativeDeadline"); json.value(t.relativeDeadline);
+        json.key("hardDeadline");     json.value(t.hardDeadline);
+        json.key("startTime");        json.value(t.startTime);
+        json.key("completionTime");   json.value(t.completionTime);
+        json.key("turnaroundTime");   json.value(t.turnaroundTime);
+        json.key("waitingTime");      json.value(t.waitingTime);
+        json.key("deadlineMissed");   json.value(t.deadlineMissed);
+        json.key("completed");        json.value(t.completed);
+        json.endObject();
+        totalTAT += t.turnaroundTime;
+        totalWT  += t.waitingTime;
+    }
+    json.endArray();
+
+    int n = (int)res.tasks.size();
+    json.key("summary");
+    json.beginObject();
+    json.key("clock");           json.value(res.totalClockTime);
+    json.key("busy");            json.value(res.totalBusyTime);
+    json.key("contextSwitches"); json.value(res.contextSwitches);
+    json.key("deadlineMisses");  json.value(res.deadlineMisses);
+    json.key("utilization");
+    json.value(res.totalClockTime > 0 ? (double)res.totalBusyTime / res.totalClockTime : 0.0);
+    json.key("avgTurnaround");   json.value(n ? totalTAT / n : 0.0);
+    json.key("avgWaiting");      json.value(n ? totalWT  / n : 0.0);
+    json.key("latency");         writeLatency(json, res.latency);
+    json.endObject();
+
+    if (!res.jobs.empty()) {
+        json.key("jobs");
+        json.beginArray();
+        for (std::size_t i = 0; i < res.jobs.size() && i < res.tasks.size(); ++i) {
+            const JobStats& j = res.jobs[i];
+            json.beginObject();
+            json.key("id");            json.value(res.tasks[i].id);
+            json.key("jobs");          json.value((long long)j.jobs);
+            json.key("misses");        json.value((long long)j.misses);
+            json.key("worstResponse"); json.value(j.worstResponse);
+            json.key("avgResponse");
+            json.value(j.jobs ? (double)j.totalResponse / j.jobs : 0.0);
+            json.key("latency");       writeLatency(json, j.latency);
+            json.endObject();
+        }
+        json.endArray();
+    }
+    if (res.steady.cycleLength > 0) {
+        json.key("steadyState");
+        json.beginObject();
+        json.key("cycleStart");    json.value(res.steady.cycleStart);
+        json.key("cycleLength");   json.value(res.steady.cycleLength);
+        json.key("cyclesSkipped"); json.value((long long)res.steady.cyclesSkipped);
+        json.endObject();
+    }
+    if (profile) {
+        json.key("profile");
+        writeProfile(json, *profile);
+    }
+
+    json.endObject();
+    out.put('\n');
+}
+
+void exportGanttBinary(const ScheduleResult& res, BufferedWriter& out) {
+    out.write("RTGB", 4);
+    out.writeU32LE(1);
+    out.writeU32LE((std::uint32_t)res.gantt.size());
+    out.writeU32LE((std::uint32_t)res.tasks.size());
+
+    for (const Segment& s : res.gantt) out.writeI32LE(s.task);
+    for (const Segment& s : res.gantt) out.writeI32LE(s.start);
+    for (const Segment& s : res.gantt) out.writeI32LE(s.end);
+
+    char labelText[24];
+    for (const Task& t : res.tasks) {
+        std::string_view label = taskLabel(t, labelText);
+        out.writeI32LE(t.id);
+        out.writeU32LE((std::uint32_t)label.size());
+        out.write(label);
+        for (std::size_t pad = (4 - label.size() % 4) % 4; pad > 0; --pad) out.put('\0');
+    }
+}
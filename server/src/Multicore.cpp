@@ -0,0 +1,648 @@
+#include "Multicore.h"
+#include "DemandBound.h"
+#include "ReleaseCalendar.h"
+#include "Scheduler.h"
+#include "Trace.h"
+#include <algorithm>
+#include <deque>
+#include <iomanip>
+#include <numeric>
+#include <ostream>
+#include <stdexcept>
+
+// ── Names ─────────────────────────────────────────────────────
+namespace {
+
+struct MulticorePolicyName {
+    MulticorePolicy policy;
+    const char*     name;
+};
+
+constexpr MulticorePolicyName kMulticorePolicyNames[] = {
+    {MulticorePolicy::GlobalEDF,      "gedf"},
+    {MulticorePolicy::GlobalFP,       "gfp"},
+    {MulticorePolicy::PartitionedEDF, "pedf"},
+    {MulticorePolicy::PartitionedFP,  "prm"},
+};
+
+} // namespace
+
+const char* multicorePolicyName(MulticorePolicy policy) {
+    for (const auto& p : kMulticorePolicyNames)
+        if (p.policy == policy) return p.name;
+    return "unknown";
+}
+
+bool parseMulticorePolicy(const std::string& name, MulticorePolicy& policy) {
+    for (const auto& p : kMulticorePolicyNames) {
+        if (name == p.name) {
+            policy = p.policy;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool parseBinPacking(const std::string& name, BinPacking& packing) {
+    if (name == "ffd") { packing = BinPacking::FirstFitDecreasing; return true; }
+    if (name == "wfd") { packing = BinPacking::WorstFitDecreasing; return true; }
+    return false;
+}
+
+// ── Engine ────────────────────────────────────────────────────
+namespace {
+
+// One released job.  Slots are recycled through a free list; `serial`
+// is unique per job and `stamp` changes on every state change, so a
+// heap entry is live only while both still match.
+struct Job {
+    int           task;        // Index into the task vector
+    Tick          release;
+    Tick          deadline;
+    Tick          remaining;   // Valid while not running
+    Tick          finish;      // Valid while running
+    Tick          runStart;
+    std::int64_t  key;         // Smaller runs first
+    int           core;        // -1 when not running
+    int           lastCore;    // -1 before the first dispatch
+    std::uint64_t serial;
+    std::uint32_t stamp;
+};
+
+struct QueueEntry {
+    std::int64_t  key;
+    Tick          release;
+    int           taskId;
+    int           job;
+    std::uint32_t stamp;
+};
+
+// Same tie-break as EDFScheduler: key, then release, then task id.
+inline bool higherPriority(const QueueEntry& a, const QueueEntry& b) {
+    if (a.key != b.key)         return a.key < b.key;
+    if (a.release != b.release) return a.release < b.release;
+    return a.taskId < b.taskId;
+}
+
+struct BestOnTop {
+    bool operator()(const QueueEntry& a, const QueueEntry& b) const { return higherPriority(b, a); }
+};
+struct WorstOnTop {
+    bool operator()(const QueueEntry& a, const QueueEntry& b) const { return higherPriority(a, b); }
+};
+
+struct TimedEntry {
+    Tick          time;
+    int           job;
+    std::uint64_t tag;   // stamp (completions) or serial (deadlines)
+};
+
+struct EarliestOnTop {
+    bool operator()(const TimedEntry& a, const TimedEntry& b) const { return a.time > b.time; }
+};
+
+template <class T, class Order>
+class Heap {
+public:
+    void push(const T& v) {
+        v_.push_back(v);
+        std::push_heap(v_.begin(), v_.end(), Order{});
+    }
+    void pop() {
+        std::pop_heap(v_.begin(), v_.end(), Order{});
+        v_.pop_back();
+    }
+    const T& top()   const { return v_.front(); }
+    bool     empty() const { return v_.empty(); }
+
+private:
+    std::vector<T> v_;
+};
+
+struct EngineStats {
+    std::vector<SegmentTrace> traces;
+    std::vector<Tick>         busy;
+    int jobsCompleted  = 0;
+    int deadlineMisses = 0;
+    int preemptions    = 0;
+    int migrations     = 0;
+};
+
+// Global scheduling of `members` (indices into `tasks`) on `cores`
+// cores.  `rank` gives fixed priorities (smaller runs first); empty
+// means EDF.  Partitioned runs use one single-core engine per core,
+// numbered from `firstCore` in the trace.
+class Engine {
+public:
+    Engine(const std::vector<Task>& tasks, const std::vector<int>& members, int cores,
+           const std::vector<int>& rank, Tick horizon,
+           std::vector<MulticoreTaskStats>& taskStats, int firstCore = 0)
+        : tasks_(tasks), rank_(rank), horizon_(horizon), taskStats_(taskStats),
+          firstCore_(firstCore),
+          head_(tasks.size(), -1), backlog_(tasks.size()),
+          coreJob_(cores, -1), coreFree_(cores, 1), onStack_(cores, 1), coreIdleFrom_(cores, 0) {
+        stats_.traces.resize(cores);
+        stats_.busy.assign(cores, 0);
+        for (int c = cores - 1; c >= 0; --c) freeStack_.push_back(c);
+        calendar_.reserve(members.size());
+        for (int i : members) calendar_.schedule(std::max<Tick>(tasks[i].arrivalTime, 0), i);
+    }
+
+    EngineStats run() {
+        SimClock clock;
+        while (clock.now() < horizon_) {
+            const Tick now = clock.now();
+            completeDue(now);
+            dropExpired(now);
+            releaseDue(now);
+            dispatch(now);
+
+            EventHorizon next(horizon_);
+            next.offer(calendar_.nextTime());
+            next.offer(nextCompletion());
+            next.offer(nextDeadline());
+            clock.advanceTo(next.next());
+        }
+        completeDue(horizon_);   // Jobs finishing on the last tick, as in EDFScheduler
+        for (int c = 0; c < (int)coreJob_.size(); ++c) {
+            if (coreJob_[c] >= 0) stop(coreJob_[c], horizon_);
+            if (coreIdleFrom_[c] < horizon_)
+                stats_.traces[c].extend(kIdleTask, coreIdleFrom_[c], horizon_);
+        }
+        return std::move(stats_);
+    }
+
+private:
+    // ── Job slots ─────────────────────────────────────────────
+    int newJob() {
+        if (!freeJobs_.empty()) {
+            int id = freeJobs_.back();
+            freeJobs_.pop_back();
+            return id;
+        }
+        jobs_.emplace_back();
+        return (int)jobs_.size() - 1;
+    }
+
+    void retire(int id) {
+        ++jobs_[id].stamp;
+        jobs_[id].serial = 0;
+        freeJobs_.push_back(id);
+    }
+
+    QueueEntry entry(int id) const {
+        const Job& j = jobs_[id];
+        return {j.key, j.release, tasks_[j.task].id, id, j.stamp};
+    }
+
+    bool live(const QueueEntry& e) const { return jobs_[e.job].stamp == e.stamp; }
+
+    // Jobs of one task run in release order and never in parallel:
+    // only the oldest unfinished job (the head) is ready, later ones
+    // wait in the task's backlog.
+    void finishJob(int id) {
+        const int task = jobs_[id].task;
+        if (head_[task] == id) {
+            head_[task] = -1;
+            if (!backlog_[task].empty()) {
+                head_[task] = backlog_[task].front();
+                backlog_[task].pop_front();
+                ready_.push(entry(head_[task]));
+            }
+        } else {
+            auto& waiting = backlog_[task];
+            waiting.erase(std::find(waiting.begin(), waiting.end(), id));
+        }
+        retire(id);
+    }
+
+    // ── Cores ─────────────────────────────────────────────────
+    // Free cores sit on a stack.  Taking a particular core (to keep a
+    // job where it last ran) only clears its flag; the stale stack
+    // entry is skipped when it surfaces, and a core is never on the
+    // stack twice.
+    int takeCore(int preferred) {
+        if (preferred >= 0 && coreFree_[preferred]) {
+            coreFree_[preferred] = 0;
+            return preferred;
+        }
+        while (!freeStack_.empty()) {
+            int c = freeStack_.back();
+            freeStack_.pop_back();
+            onStack_[c] = 0;
+            if (coreFree_[c]) {
+                coreFree_[c] = 0;
+                return c;
+            }
+        }
+        return -1;
+    }
+
+    void freeCore(int c) {
+        coreJob_[c]  = -1;
+        coreFree_[c] = 1;
+        if (!onStack_[c]) {
+            onStack_[c] = 1;
+            freeStack_.push_back(c);
+        }
+    }
+
+    void start(int id, int c, Tick now) {
+        Job& j = jobs_[id];
+        if (j.lastCore >= 0 && j.lastCore != c) ++stats_.migrations;
+        if (j.lastCore < 0) taskStats_[j.task].latency.jitter.record(now - j.release);
+        if (coreIdleFrom_[c] < now)
+            stats_.traces[c].extend(kIdleTask, coreIdleFrom_[c], now);
+
+        j.core     = c;
+        j.lastCore = c;
+        j.runStart = now;
+        j.finish   = (Tick)std::min<std::int64_t>((std::int64_t)now + j.remaining, kNever);
+        ++j.stamp;
+        coreJob_[c] = id;
+        running_.push(entry(id));
+        completions_.push({j.finish, id, j.stamp});
+
+        RTOS_TRACE(TraceLevel::Event, TraceEvent::Dispatch, now, tasks_[j.task].id, firstCore_ + c,
+                   "  [RUN]   " << tasks_[j.task].name << "  core=" << firstCore_ + c
+                   << "  clock=" << now << "  remaining=" << j.remaining
+                   << "  deadline=" << j.deadline << "\n");
+    }
+
+    // Takes the job off its core at `now`; the core becomes free.
+    void stop(int id, Tick now) {
+        Job& j = jobs_[id];
+        const int c = j.core;
+        if (now > j.runStart) {
+            stats_.traces[c].extend(tasks_[j.task].id, j.runStart, now);
+            stats_.busy[c] += now - j.runStart;
+        }
+        coreIdleFrom_[c] = now;
+        j.remaining = j.finish - now;
+        j.core      = -1;
+        ++j.stamp;
+        freeCore(c);
+    }
+
+    // ── Events ────────────────────────────────────────────────
+    void completeDue(Tick now) {
+        while (!completions_.empty() && completions_.top().time <= now) {
+            TimedEntry e = completions_.top();
+            completions_.pop();
+            if (jobs_[e.job].stamp != e.tag) continue;
+            const Job& j = jobs_[e.job];
+            MulticoreTaskStats& ts = taskStats_[j.task];
+            ++ts.jobs;
+            ts.worstResponse = std::max(ts.worstResponse, now - j.release);
+            ts.latency.complete(j.release, tasks_[j.task].burstTime, now, j.deadline);
+            ++stats_.jobsCompleted;
+            RTOS_TRACE(TraceLevel::Event, TraceEvent::Complete, now, tasks_[j.task].id, firstCore_ + j.lastCore,
+                       "  [DONE]  " << tasks_[j.task].name << "  core=" << firstCore_ + j.lastCore
+                       << "  clock=" << now << "\n");
+            stop(e.job, now);
+            finishJob(e.job);
+        }
+    }
+
+    // Jobs still unfinished at their deadline are dropped, as in
+    // EDFScheduler.  Finished jobs leave stale entries behind.
+    void dropExpired(Tick now) {
+        while (!deadlines_.empty() && deadlines_.top().time <= now) {
+            TimedEntry e = deadlines_.top();
+            deadlines_.pop();
+            if (jobs_[e.job].serial != e.tag) continue;
+            const Job& j = jobs_[e.job];
+            MulticoreTaskStats& ts = taskStats_[j.task];
+            ++ts.misses;
+            ++stats_.deadlineMisses;
+            RTOS_TRACE(TraceLevel::Event, TraceEvent::DeadlineMiss, now, tasks_[j.task].id, j.deadline,
+                       "  !! DEADLINE MISS  " << tasks_[j.task].name
+                       << "  clock=" << now << "  deadline=" << j.deadline << "\n");
+            if (j.core >= 0) stop(e.job, now);   // Brings `remaining` up to date
+            ts.latency.drop(j.release, tasks_[j.task].burstTime, j.remaining, now, j.deadline);
+            finishJob(e.job);
+        }
+    }
+
+    void releaseDue(Tick now) {
+        while (calendar_.due(now)) {
+            const int   i = calendar_.pop().task;
+            const Task& t = tasks_[i];
+            const Tick  d = t.relativeDeadline > 0 ? t.relativeDeadline : t.period;
+
+            std::int64_t nextRelease = (std::int64_t)now + t.period;
+            if (nextRelease < horizon_) calendar_.schedule((Tick)nextRelease, i);
+
+            RTOS_TRACE(TraceLevel::Event, TraceEvent::Release, now, t.id, now + d,
+                       "  [REL]   " << t.name << "  clock=" << now
+                       << "  deadline=" << now + d << "\n");
+            if (t.burstTime <= 0) {   // Nothing to run
+                ++taskStats_[i].jobs;
+                taskStats_[i].latency.jitter.record(0);
+                taskStats_[i].latency.complete(now, 0, now, now + d);
+                ++stats_.jobsCompleted;
+                continue;
+            }
+
+            const int id = newJob();
+            Job& j     = jobs_[id];
+            j.task     = i;
+            j.release  = now;
+            j.deadline = (Tick)std::min<std::int64_t>((std::int64_t)now + d, kNever);
+            j.remaining = t.burstTime;
+            j.key      = rank_.empty() ? j.deadline : rank_[i];
+            j.core     = -1;
+            j.lastCore = -1;
+            j.serial   = ++serials_;
+            ++j.stamp;
+            deadlines_.push({j.deadline, id, j.serial});
+            if (head_[i] < 0) {
+                head_[i] = id;
+                ready_.push(entry(id));
+            } else {
+                backlog_[i].push_back(id);
+            }
+        }
+    }
+
+    // Fill free cores from the ready heap, then preempt while the best
+    // ready job beats the worst running one.  Every step is a heap
+    // operation; the cores are never scanned.
+    void dispatch(Tick now) {
+        for (;;) {
+            while (!ready_.empty() && !live(ready_.top())) ready_.pop();
+            if (ready_.empty()) return;
+
+            const QueueEntry best = ready_.top();
+            int c = takeCore(jobs_[best.job].lastCore);
+            if (c < 0) {
+                while (!running_.empty() && !live(running_.top())) running_.pop();
+                if (running_.empty() || !higherPriority(best, running_.top())) return;
+
+                const int victim = running_.top().job;
+                running_.pop();
+                c = jobs_[victim].core;
+                RTOS_TRACE(TraceLevel::Event, TraceEvent::Preempt, now,
+                           tasks_[jobs_[victim].task].id, jobs_[victim].finish - now,
+                           "  [PRE]   " << tasks_[jobs_[victim].task].name << "  core=" << firstCore_ + c
+                           << "  remaining=" << jobs_[victim].finish - now << "\n");
+                stop(victim, now);
+                ready_.push(entry(victim));
+                ++stats_.preemptions;
+                c = takeCore(c);
+            }
+            ready_.pop();
+            start(best.job, c, now);
+        }
+    }
+
+    Tick nextCompletion() {
+        while (!completions_.empty() &&
+               jobs_[completions_.top().job].stamp != completions_.top().tag)
+            completions_.pop();
+        return completions_.empty() ? kNever : completions_.top().time;
+    }
+
+    Tick nextDeadline() {
+        while (!deadlines_.empty() &&
+               jobs_[deadlines_.top().job].serial != deadlines_.top().tag)
+            deadlines_.pop();
+        return deadlines_.empty() ? kNever : deadlines_.top().time;
+    }
+
+    const std::vector<Task>&         tasks_;
+    const std::vector<int>&          rank_;
+    Tick                             horizon_;
+    std::vector<MulticoreTaskStats>& taskStats_;
+    int                              firstCore_;
+
+    std::vector<Job> jobs_;
+    std::vector<int> freeJobs_;
+    std::uint64_t    serials_ = 0;
+
+    std::vector<int>             head_;      // Per task: oldest unfinished job
+    std::vector<std::deque<int>> backlog_;   // Per task: the jobs after it
+
+    ReleaseCalendar                             calendar_;
+    Heap<QueueEntry, BestOnTop>                 ready_;
+    Heap<QueueEntry, WorstOnTop>                running_;
+    Heap<TimedEntry, EarliestOnTop>             completions_;
+    Heap<TimedEntry, EarliestOnTop>             deadlines_;
+
+    std::vector<int>  coreJob_;
+    std::vector<char> coreFree_;
+    std::vector<char> onStack_;
+    std::vector<Tick> coreIdleFrom_;
+    std::vector<int>  freeStack_;
+
+    EngineStats stats_;
+};
+
+// ── Partitioning ──────────────────────────────────────────────
+double utilization(const Task& t) { return (double)t.burstTime / t.period; }
+
+// Per-core admission: QPA for EDF, response-time analysis for fixed
+// priority.  Both keep the tasks admitted so far.  Fixed-priority
+// tasks stay in input order so that equal keys tie the same way as in
+// the simulation.
+class CoreAdmission {
+public:
+    CoreAdmission(bool edf, PriorityOrder order) : edf_(edf), order_(order) {}
+
+    bool tryAdmit(const std::vector<Task>& tasks, int i) {
+        if (edf_) return edfAdmission_.tryAdmit(tasks[i]);
+        auto pos = std::lower_bound(fpIndex_.begin(), fpIndex_.end(), i) - fpIndex_.begin();
+        fpIndex_.insert(fpIndex_.begin() + pos, i);
+        fpTasks_.insert(fpTasks_.begin() + pos, tasks[i]);
+        if (analyzeFixedPriority(fpTasks_, order_, false).schedulable) return true;
+        fpIndex_.erase(fpIndex_.begin() + pos);
+        fpTasks_.erase(fpTasks_.begin() + pos);
+        return false;
+    }
+
+private:
+    bool              edf_;
+    PriorityOrder     order_;
+    EdfAdmission      edfAdmission_;
+    std::vector<int>  fpIndex_;
+    std::vector<Task> fpTasks_;
+};
+
+// Core per task, -1 where nothing admits it.
+std::vector<int> partition(const std::vector<Task>& tasks, int cores, BinPacking packing,
+                           bool edf, PriorityOrder order) {
+    std::vector<int> byUtil(tasks.size());
+    std::iota(byUtil.begin(), byUtil.end(), 0);
+    std::stable_sort(byUtil.begin(), byUtil.end(), [&](int a, int b) {
+        return utilization(tasks[a]) > utilization(tasks[b]);
+    });
+
+    std::vector<CoreAdmission> admission;
+    admission.reserve(cores);
+    for (int c = 0; c < cores; ++c) admission.emplace_back(edf, order);
+    std::vector<double>        load(cores, 0.0);
+    std::vector<int>           assigned(tasks.size(), -1);
+    std::vector<int>           candidates(cores);
+
+    for (int i : byUtil) {
+        std::iota(candidates.begin(), candidates.end(), 0);
+        if (packing == BinPacking::WorstFitDecreasing)
+            std::stable_sort(candidates.begin(), candidates.end(),
+                             [&](int a, int b) { return load[a] < load[b]; });
+        for (int c : candidates) {
+            if (load[c] + utilization(tasks[i]) > 1.0 + 1e-12) continue;
+            if (!admission[c].tryAdmit(tasks, i)) continue;
+            assigned[i] = c;
+            load[c] += utilization(tasks[i]);
+            break;
+        }
+    }
+    return assigned;
+}
+
+} // namespace
+
+// ── Entry point ───────────────────────────────────────────────
+MulticoreResult runMulticore(const MulticoreConfig& config, const std::vector<Task>& tasks) {
+    if (config.cores < 1)
+        throw std::invalid_argument("need at least one core");
+    for (const Task& t : tasks)
+        if (t.period <= 0)
+            throw std::invalid_argument("task " + std::to_string(t.id) +
+                                        " needs a period > 0");
+
+    const bool global = config.policy == MulticorePolicy::GlobalEDF ||
+                        config.policy == MulticorePolicy::GlobalFP;
+    const bool edf    = config.policy == MulticorePolicy::GlobalEDF ||
+                        config.policy == MulticorePolicy::PartitionedEDF;
+
+    std::vector<int> rank;
+    if (!edf) {
+        const std::vector<std::size_t> order = priorityIndex(tasks, config.order);
+        rank.resize(tasks.size());
+        for (std::size_t r = 0; r < order.size(); ++r) rank[order[r]] = (int)r;
+    }
+
+    MulticoreResult res;
+    res.horizon = config.horizon > 0 ? config.horizon : hyperperiodTicks(tasks);
+    res.tasks.assign(tasks.size(), MulticoreTaskStats{});
+
+    auto label = [&](SegmentTrace& trace, const std::vector<int>& members) {
+        std::vector<std::pair<int, std::string>> labels;
+        labels.reserve(members.size());
+        for (int i : members)
+            if (!tasks[i].name.empty()) labels.emplace_back(tasks[i].id, tasks[i].name);
+        trace.setLabels(std::move(labels));
+    };
+    auto accumulate = [&](const EngineStats& s) {
+        res.jobsCompleted  += s.jobsCompleted;
+        res.deadlineMisses += s.deadlineMisses;
+        res.preemptions    += s.preemptions;
+        res.migrations     += s.migrations;
+    };
+    auto mergeLatency = [&]() {
+        for (const MulticoreTaskStats& ts : res.tasks) res.latency.merge(ts.latency);
+    };
+
+    if (global) {
+        std::vector<int> all(tasks.size());
+        std::iota(all.begin(), all.end(), 0);
+        EngineStats s = Engine(tasks, all, config.cores, rank, res.horizon, res.tasks).run();
+        accumulate(s);
+        res.cores = std::move(s.traces);
+        res.busy  = std::move(s.busy);
+        for (auto& trace : res.cores) label(trace, all);
+        mergeLatency();
+        return res;
+    }
+
+    const std::vector<int> assigned = partition(tasks, config.cores, config.packing,
+                                                edf, config.order);
+    std::vector<std::vector<int>> members(config.cores);
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        res.tasks[i].core = assigned[i];
+        if (assigned[i] >= 0) members[assigned[i]].push_back((int)i);
+        else                  ++res.unassigned;
+    }
+
+    res.cores.resize(config.cores);
+    res.busy.assign(config.cores, 0);
+    for (int c = 0; c < config.cores; ++c) {
+        EngineStats s = Engine(tasks, members[c], 1, rank, res.horizon, res.tasks, c).run();
+        accumulate(s);
+        res.cores[c] = std::move(s.traces[0]);
+        res.busy[c]  = s.busy[0];
+        label(res.cores[c], members[c]);
+    }
+    mergeLatency();
+    return res;
+}
+
+// ── Report ────────────────────────────────────────────────────
+void printMulticore(const MulticoreResult& res, const std::vector<Task>& tasks,
+                    const MulticoreConfig& config, bool gantt, std::ostream& os) {
+    const std::string title = std::string(multicorePolicyName(config.policy)) + ", " +
+                              std::to_string(config.cores) + " cores";
+    const bool partitioned = config.policy == MulticorePolicy::PartitionedEDF ||
+                             config.policy == MulticorePolicy::PartitionedFP;
+
+    if (gantt) {
+        for (std::size_t c = 0; c < res.cores.size(); ++c) {
+            ScheduleResult core;
+            core.gantt = res.cores[c];
+            printGantt(core, title + ", core " + std::to_string(c), os);
+        }
+    }
+
+    std::vector<int> tasksOnCore(res.cores.size(), 0);
+    for (const auto& ts : res.tasks)
+        if (ts.core >= 0) ++tasksOnCore[ts.core];
+
+    os << "\n  Per-Core Utilization [" << title << "]\n";
+    os << "  " << std::string(40, '-') << "\n";
+    os << std::left << "  " << std::setw(6) << "Core";
+    if (partitioned) os << std::setw(8) << "Tasks";
+    os << std::setw(12) << "Busy" << "Utilization\n";
+    os << "  " << std::string(40, '-') << "\n";
+
+    Tick totalBusy = 0;
+    os << std::fixed << std::setprecision(2);
+    for (std::size_t c = 0; c < res.busy.size(); ++c) {
+        totalBusy += res.busy[c];
+        os << "  " << std::setw(6) << c;
+        if (partitioned) os << std::setw(8) << tasksOnCore[c];
+        os << std::setw(12) << res.busy[c]
+           << (res.horizon > 0 ? 100.0 * res.busy[c] / res.horizon : 0.0) << "%\n";
+    }
+    os << "  " << std::string(40, '-') << "\n";
+
+    os << "\n  Per-Task Results [" << title << "]\n";
+    os << "  " << std::string(60, '-') << "\n";
+    os << std::left << "  " << std::setw(8) << "Task";
+    if (partitioned) os << std::setw(6) << "Core";
+    os << std::setw(8) << "C" << std::setw(8) << "T"
+       << std::setw(8) << "Jobs" << std::setw(8) << "WCRT" << std::setw(8) << "P99"
+       << "Missed\n";
+    os << "  " << std::string(60, '-') << "\n";
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        const MulticoreTaskStats& ts = res.tasks[i];
+        os << "  " << std::setw(8) << tasks[i].name;
+        if (partitioned) os << std::setw(6) << (ts.core >= 0 ? std::to_string(ts.core) : "-");
+        os << std::setw(8) << tasks[i].burstTime << std::setw(8) << tasks[i].period
+           << std::setw(8) << ts.jobs << std::setw(8) << ts.worstResponse
+           << std::setw(8) << ts.latency.response.percentile(99)
+           << ts.misses << "\n";
+    }
+    os << "  " << std::string(60, '-') << "\n";
+
+    const double capacity = (double)res.horizon * std::max<std::size_t>(res.busy.size(), 1);
+    os << "  Jobs Completed  : " << res.jobsCompleted << "\n"
+       << "  Deadline Misses : " << res.deadlineMisses << "\n"
+       << "  Preemptions     : " << res.preemptions << "\n"
+       << "  Migrations      : " << res.migrations << "\n";
+    if (partitioned)
+        os << "  Unassigned      : " << res.unassigned << " tasks\n";
+    os << "  Platform Util.  : " << (capacity > 0 ? 100.0 * totalBusy / capacity : 0.0) << "%\n"
+       << "  Horizon         : " << res.horizon << " ticks\n";
+    printLatency(res.latency, title, os);
+}
@@ -0,0 +1,99 @@
+#include "Options.h"
+#include <istream>
+#include <sstream>
+#include <stdexcept>
+
+bool parseTraceLevel(const std::string& s, TraceLevel& level) {
+    if (s == "off")     { level = TraceLevel::Off;     return true; }
+    if (s == "summary") { level = TraceLevel::Summary; return true; }
+    if (s == "event")   { level = TraceLevel::Event;   return true; }
+    if (s == "tick")    { level = TraceLevel::Tick;    return true; }
+    return false;
+}
+
+RunOptions parseArgs(const std::vector<std::string>& args) {
+    RunOptions opts;
+    if (args.empty())
+        throw std::invalid_argument("missing policy");
+    if (!parsePolicy(args[0], opts.config.policy))
+        throw std::invalid_argument("unknown policy '" + args[0] + "'");
+
+    for (std::size_t i = 1; i < args.size(); ++i) {
+        const std::string& arg = args[i];
+        auto value = [&]() -> const std::string& {
+            if (i + 1 >= args.size())
+                throw std::invalid_argument(arg + " needs a value");
+            return args[++i];
+        };
+        // A whole decimal integer no smaller than `minimum`
+        auto number = [&](const std::string& text, int minimum) {
+            std::size_t used = 0;
+            int n = 0;
+            try {
+                n = std::stoi(text, &used);
+            } catch (const std::logic_error&) {
+                used = 0;
+            }
+            if (used == 0 || used != text.size())
+                throw std::invalid_argument(arg + " needs an integer, not '" + text + "'");
+            if (n < minimum)
+                throw std::invalid_argument(arg + " needs a value >= " + std::to_string(minimum));
+            return n;
+        };
+        auto count = [&](int minimum) { return number(value(), minimum); };
+        if      (arg == "--quantum")  opts.config.quantum       = count(1);
+        else if (arg == "--cs")       opts.config.csPenalty     = count(0);
+        else if (arg == "--aging")    opts.config.agingInterval = count(0);
+        else if (arg == "--feedback") opts.config.feedback      = true;
+        else if (arg == "--horizon")  opts.config.horizon       = count(0);
+        else if (arg == "--exact")    opts.config.steadyState   = false;
+        else if (arg == "--no-gantt") opts.gantt                = false;
+        else if (arg == "--profile")  opts.profile              = true;
+        else if (arg == "--checkpoint") opts.checkpoint         = count(1);
+        else if (arg == "--window") {
+            const std::string& w = value();
+            auto colon = w.find(':');
+            if (colon == std::string::npos)
+                throw std::invalid_argument("--window needs A:B");
+            opts.windowFrom = number(w.substr(0, colon), 0);
+            opts.windowTo   = number(w.substr(colon + 1), 1);
+            if (opts.windowTo <= opts.windowFrom)
+                throw std::invalid_argument("--window needs 0 <= A < B");
+        }
+        else if (arg == "--format") {
+            const std::string& f = value();
+            if      (f == "text")   opts.format = OutputFormat::Text;
+            else if (f == "json")   opts.format = OutputFormat::Json;
+            else if (f == "binary") opts.format = OutputFormat::Binary;
+            else throw std::invalid_argument("unknown format '" + f + "'");
+        } else if (arg == "--trace") {
+            if (!parseTraceLevel(value(), opts.traceLevel))
+                throw std::invalid_argument("unknown trace level '" + args[i] + "'");
+        } else {
+            throw std::invalid_argument("unknown option '" + arg + "'");
+        }
+    }
+    return opts;
+}
+
+void readTasks(std::istream& in, std::vector<Task>& tasks) {
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(in, line)) {
+        ++lineNo;
+        auto hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+
+        std::istringstream fields(line);
+        Task t;
+        if (!(fields >> t.id)) continue;   // Blank line
+        int deadline = 0;
+        if (!(fields >> t.name >> t.arrivalTime >> t.burstTime))
+            throw std::runtime_error("line " + std::to_string(lineNo) +
+                                     ": expected id name arrival burst");
+        fields >> t.priority >> t.period >> deadline;
+        if (t.period > 0) t.relativeDeadline = deadline;
+        else              t.hardDeadline     = deadline;
+        tasks.push_back(std::move(t));
+    }
+}
@@ -0,0 +1,464 @@
+#include "RealTime.h"
+#include "Multicore.h"
+#include "ResourceManager.h"
+#include "Trace.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <latch>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <thread>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#ifndef SCHED_DEADLINE
+#define SCHED_DEADLINE 6
+#endif
+
+// ── Names ─────────────────────────────────────────────────────
+namespace {
+
+struct RealTimeClassName {
+    RealTimeClass cls;
+    const char*   name;
+};
+
+constexpr RealTimeClassName kRealTimeClassNames[] = {
+    {RealTimeClass::Fifo,     "fifo"},
+    {RealTimeClass::Deadline, "deadline"},
+    {RealTimeClass::Other,    "other"},
+};
+
+} // namespace
+
+const char* realTimeClassName(RealTimeClass cls) {
+    for (const auto& c : kRealTimeClassNames)
+        if (c.cls == cls) return c.name;
+    return "unknown";
+}
+
+bool parseRealTimeClass(const std::string& name, RealTimeClass& cls) {
+    for (const auto& c : kRealTimeClassNames) {
+        if (name == c.name) {
+            cls = c.cls;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ── Clocks and the kernel ─────────────────────────────────────
+namespace {
+
+constexpr std::int64_t kMaxWallNanos   = 10'000'000'000;   // Default horizon cap
+constexpr std::int64_t kStartNanos     = 20'000'000;       // Ready to first release
+constexpr std::int64_t kCalibrateNanos = 20'000'000;
+constexpr std::int64_t kSliceNanos     = 5'000;            // Between clock reads
+
+std::int64_t nanos(clockid_t clock) {
+    timespec ts;
+    clock_gettime(clock, &ts);
+    return (std::int64_t)ts.tv_sec * 1'000'000'000 + ts.tv_nsec;
+}
+
+std::int64_t monotonic() { return nanos(CLOCK_MONOTONIC); }
+
+void sleepUntil(std::int64_t t) {
+    timespec ts;
+    ts.tv_sec  = (time_t)(t / 1'000'000'000);
+    ts.tv_nsec = (long)(t % 1'000'000'000);
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {}
+}
+
+// The workload: n iterations the compiler cannot remove.  Out of
+// line, so calibration and the jobs run the same machine code (a
+// loop this tight changes speed with its alignment).
+__attribute__((noinline)) void spin(std::uint64_t n) {
+    for (std::uint64_t i = 0; i < n; ++i) asm volatile("" : : "r"(i) : "memory");
+}
+
+// Spin iterations per microsecond of CPU time on the calling thread
+double calibrate() {
+    for (std::uint64_t n = 1 << 16;; n *= 2) {
+        const std::int64_t t0 = nanos(CLOCK_THREAD_CPUTIME_ID);
+        spin(n);
+        const std::int64_t dt = nanos(CLOCK_THREAD_CPUTIME_ID) - t0;
+        if (dt >= kCalibrateNanos) return (double)n * 1000.0 / (double)dt;
+    }
+}
+
+// No glibc wrapper for sched_setattr before 2.41
+struct SchedAttr {
+    std::uint32_t size;
+    std::uint32_t policy;
+    std::uint64_t flags;
+    std::int32_t  nice;
+    std::uint32_t priority;
+    std::uint64_t runtime;
+    std::uint64_t deadline;
+    std::uint64_t period;
+};
+
+int setDeadline(std::int64_t runtime, std::int64_t deadline, std::int64_t period) {
+    SchedAttr attr;
+    std::memset(&attr, 0, sizeof attr);
+    attr.size     = sizeof attr;
+    attr.policy   = SCHED_DEADLINE;
+    attr.runtime  = (std::uint64_t)runtime;
+    attr.deadline = (std::uint64_t)deadline;
+    attr.period   = (std::uint64_t)period;
+    return syscall(SYS_sched_setattr, 0, &attr, 0) == 0 ? 0 : errno;
+}
+
+int setOther() {
+    sched_param param{};
+    return pthread_setschedparam(pthread_self(), SCHED_OTHER, &param);
+}
+
+int setFifo(int priority) {
+    sched_param param{};
+    param.sched_priority = priority;
+    return pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+}
+
+bool pinTo(int cpu) {
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof set, &set) == 0;
+}
+
+// ── Workers ───────────────────────────────────────────────────
+struct Span {
+    std::int64_t start;
+    std::int64_t end;
+};
+
+struct JobRecord {
+    std::int64_t release;   // Nanoseconds from the run's start
+    std::int64_t wake;      // Started running
+    std::int64_t finish;
+};
+
+// One per task, filled by its own thread only
+struct Worker {
+    std::int64_t  first    = 0;   // First release, from the start
+    std::int64_t  period   = 0;
+    std::int64_t  deadline = 0;
+    std::int64_t  wcet     = 0;
+    std::uint64_t spins    = 0;   // burstTime worth
+    int           priority = 0;   // fifo
+    int           error    = 0;   // Class refused: errno
+
+    std::vector<JobRecord> jobs;
+    std::vector<Span>      runs;
+};
+
+struct Shared {
+    RealTimeClass             cls;
+    int                       cpu;
+    std::int64_t              end;            // Last release before this
+    std::uint64_t             sliceSpins;
+    std::int64_t              gap;            // A longer one was a preemption
+    std::atomic<std::int64_t> start{0};       // Set once every thread is ready
+    std::atomic<bool>         cancel{false};
+};
+
+void runWorker(Worker& w, Shared& s, std::latch& ready) {
+    if (s.cpu >= 0) pinTo(s.cpu);
+    if (s.cls == RealTimeClass::Fifo)
+        w.error = setFifo(w.priority);
+    else if (s.cls == RealTimeClass::Deadline)
+        w.error = setDeadline(std::min(w.wcet + w.wcet / 4, w.deadline), w.deadline, w.period);
+    if (w.error) setOther();
+
+    ready.count_down();
+    s.start.wait(0);
+    const std::int64_t start = s.start.load();
+    if (s.cancel.load()) return;
+
+    for (std::int64_t release = w.first; release < s.end; release += w.period) {
+        sleepUntil(start + release);
+        const std::int64_t wake = monotonic() - start;
+
+        // Spin in slices; a slice that took much longer than the
+        // others was preempted, and ends what the thread ran so far
+        std::int64_t   runStart = wake, last = wake;
+        std::uint64_t  left     = w.spins;
+        while (left > 0) {
+            const std::uint64_t n = std::min(left, s.sliceSpins);
+            spin(n);
+            left -= n;
+            const std::int64_t t = monotonic() - start;
+            if (t - last > s.gap) {
+                w.runs.push_back({runStart, last});
+                runStart = std::max(last, t - kSliceNanos);
+            }
+            last = t;
+        }
+        w.runs.push_back({runStart, last});
+        w.jobs.push_back({release, wake, last});
+    }
+}
+
+Tick realHorizon(const RealConfig& config, const std::vector<Task>& tasks) {
+    if (config.horizon > 0) return config.horizon;
+    const std::int64_t cap = kMaxWallNanos / ((std::int64_t)config.tickMicros * 1000);
+    std::int64_t h;
+    if (!hyperperiod(tasks, h) || h > cap) h = cap;
+    return (Tick)std::max<std::int64_t>(h, 1);
+}
+
+} // namespace
+
+// ── Run ───────────────────────────────────────────────────────
+RealResult runReal(const RealConfig& config, const std::vector<Task>& tasks) {
+    if (config.tickMicros < 1) throw std::invalid_argument("tick must be at least 1 us");
+    const std::vector<std::size_t> idx = priorityIndex(tasks, config.order);   // Checks periods
+    const std::size_t  n       = tasks.size();
+    const std::int64_t tick    = (std::int64_t)config.tickMicros * 1000;
+
+    RealResult res;
+    res.horizon = realHorizon(config, tasks);
+    res.granted = config.cls;
+
+    // Probe the class and calibrate on a thread of our own, so the
+    // caller's scheduling and affinity are left alone
+    std::thread([&] {
+        int err = 0;
+        if (config.cls == RealTimeClass::Fifo)
+            err = setFifo(sched_get_priority_min(SCHED_FIFO));
+        else if (config.cls == RealTimeClass::Deadline)
+            err = setDeadline(100'000, 1'000'000, 1'000'000);
+        setOther();
+        if (err) {
+            res.granted  = RealTimeClass::Other;
+            res.fallback = std::string(realTimeClassName(config.cls)) + " refused: " +
+                           std::strerror(err);
+        }
+        res.pinned        = config.cpu >= 0 && pinTo(config.cpu);
+        res.spinsPerMicro = calibrate();
+    }).join();
+    if (res.granted == RealTimeClass::Deadline) res.pinned = false;
+
+    Shared shared;
+    shared.cls        = res.granted;
+    shared.cpu        = res.pinned ? config.cpu : -1;
+    shared.end        = (std::int64_t)res.horizon * tick;
+    const std::int64_t slice = std::min(kSliceNanos, std::max<std::int64_t>(tick / 4, 1000));
+    shared.sliceSpins = std::max<std::uint64_t>(
+        1, (std::uint64_t)(res.spinsPerMicro * (double)slice / 1000.0));
+    shared.gap        = 2 * slice + 5'000;
+
+    // Priorities 98 (rank 0) down to 1; 99 is left to the kernel
+    std::vector<Worker> workers(n);
+    const int top = std::max(sched_get_priority_max(SCHED_FIFO) - 1, 1);
+    for (std::size_t r = 0; r < n; ++r)
+        workers[idx[r]].priority = std::max(top - (int)r, 1);
+    for (std::size_t i = 0; i < n; ++i) {
+        const Task& t = tasks[i];
+        Worker&     w = workers[i];
+        w.first    = (std::int64_t)std::max(t.arrivalTime, 0) * tick;
+        w.period   = (std::int64_t)t.period * tick;
+        w.deadline = (std::int64_t)(t.relativeDeadline > 0 ? t.relativeDeadline : t.period) * tick;
+        w.wcet     = (std::int64_t)t.burstTime * tick;
+        w.spins    = (std::uint64_t)(res.spinsPerMicro * (double)t.burstTime * config.tickMicros);
+        const std::int64_t jobs = w.first < shared.end
+                                  ? (shared.end - w.first + w.period - 1) / w.period : 0;
+        w.jobs.reserve((std::size_t)jobs);
+        w.runs.reserve((std::size_t)jobs * 2);
+    }
+
+    std::latch               ready((std::ptrdiff_t)n);
+    std::vector<std::thread> threads;
+    threads.reserve(n);
+    try {
+        for (std::size_t i = 0; i < n; ++i)
+            threads.emplace_back(runWorker, std::ref(workers[i]), std::ref(shared), std::ref(ready));
+    } catch (const std::exception& e) {
+        // Let the threads already started go and wait for them
+        shared.cancel.store(true);
+        shared.start.store(-1);
+        shared.start.notify_all();
+        for (auto& t : threads) t.join();
+        throw std::runtime_error(std::string("cannot start task threads: ") + e.what());
+    }
+    ready.wait();
+    shared.start.store(monotonic() + kStartNanos);
+    shared.start.notify_all();
+    for (auto& t : threads) t.join();
+
+    // ── Back to ticks ─────────────────────────────────────────
+    auto toTick = [tick](std::int64_t ns) {
+        return (Tick)std::min<std::int64_t>((ns + tick / 2) / tick, kNever);
+    };
+
+    ScheduleResult& s = res.schedule;
+    s.tasks = tasks;
+    resetRunState(s.tasks);
+    s.jobs.resize(n);
+    res.tasks.resize(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const Worker&  w  = workers[i];
+        JobStats&      js = s.jobs[i];
+        RealTaskStats& rt = res.tasks[i];
+        if (w.error) ++res.refused;
+        for (std::size_t k = 0; k < w.jobs.size(); ++k) {
+            const JobRecord& j = w.jobs[k];
+            const Tick release  = toTick(j.release);
+            const Tick finish   = toTick(j.finish);
+            const Tick deadline = toTick(j.release + w.deadline);
+            const Tick response = finish - release;
+            ++js.jobs;
+            js.totalResponse += response;
+            js.worstResponse  = std::max(js.worstResponse, response);
+            js.latency.complete(release, tasks[i].burstTime, finish, deadline);
+            js.latency.jitter.record(toTick(j.wake - j.release));
+            if (j.finish > j.release + w.deadline) {
+                ++js.misses;
+                ++s.deadlineMisses;
+            }
+            if (k + 1 < w.jobs.size() && j.finish > w.jobs[k + 1].release) ++rt.overruns;
+            // A job that started late because the previous one ran
+            // over did not wait for the kernel
+            if (k == 0 || w.jobs[k - 1].finish <= j.release) rt.wakeup.record(j.wake - j.release);
+        }
+        res.overruns += rt.overruns;
+        res.wakeup.merge(rt.wakeup);
+        s.latency.merge(js.latency);
+    }
+
+    // One timeline from every thread's runs; rounding to ticks (and
+    // threads that float over several CPUs) can overlap them, and
+    // the later run then starts where the earlier one ended
+    struct Run {
+        std::int64_t start;
+        std::int64_t end;
+        int          task;
+    };
+    std::vector<Run> runs;
+    for (std::size_t i = 0; i < n; ++i)
+        for (const Span& sp : workers[i].runs) runs.push_back({sp.start, sp.end, tasks[i].id});
+    std::sort(runs.begin(), runs.end(),
+              [](const Run& a, const Run& b) { return a.start < b.start; });
+
+    labelTasks(s.gantt, tasks);
+    Tick cursor = 0;
+    int  last   = kIdleTask;
+    for (const Run& r : runs) {
+        const Tick start = std::max(toTick(r.start), cursor);
+        const Tick end   = toTick(r.end);
+        if (end <= start) continue;
+        if (start > cursor) s.gantt.extend(kIdleTask, cursor, start);
+        s.gantt.extend(r.task, start, end);
+        s.totalBusyTime += end - start;
+        if (last != kIdleTask && last != r.task) ++s.contextSwitches;
+        last   = r.task;
+        cursor = end;
+    }
+    if (cursor < res.horizon) s.gantt.extend(kIdleTask, cursor, res.horizon);
+    s.totalClockTime = std::max(cursor, res.horizon);
+    return res;
+}
+
+// ── Prediction ────────────────────────────────────────────────
+std::vector<JobStats> predictReal(const RealConfig& config, const std::vector<Task>& tasks,
+                                  Tick horizon) {
+    NullSink          quiet;
+    trace::ScopedSink scoped(quiet);
+
+    // The EDF scheduler releases every task at t = 0; global EDF on
+    // one core is the same schedule but honours arrival offsets, as
+    // the threads do
+    std::vector<JobStats> out(tasks.size());
+    if (config.cls == RealTimeClass::Deadline) {
+        MulticoreConfig edf;
+        edf.policy  = MulticorePolicy::GlobalEDF;
+        edf.cores   = 1;
+        edf.horizon = horizon;
+        const MulticoreResult sim = runMulticore(edf, tasks);
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            out[i].jobs          = sim.tasks[i].jobs;
+            out[i].misses        = sim.tasks[i].misses;
+            out[i].worstResponse = sim.tasks[i].worstResponse;
+            out[i].latency       = sim.tasks[i].latency;
+        }
+        return out;
+    }
+
+    ResourceConfig fp;
+    fp.protocol = LockProtocol::None;
+    fp.order    = config.order;
+    fp.horizon  = horizon;
+    const ResourceResult sim = simulateResources(fp, tasks, {});
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        out[i].jobs          = sim.tasks[i].jobs;
+        out[i].misses        = sim.tasks[i].misses;
+        out[i].worstResponse = sim.tasks[i].worstResponse;
+    }
+    return out;
+}
+
+// ── Report ────────────────────────────────────────────────────
+void printRealReport(const RealResult& res, const std::vector<JobStats>& predicted,
+                     const RealConfig& config, bool gantt, std::ostream& os) {
+    const std::string title = std::string("real, ") + realTimeClassName(res.granted);
+    if (gantt) printGantt(res.schedule, title, os);
+    printMetrics(res.schedule, title, os);
+
+    os << "\n  Execution [" << title << "]\n";
+    os << "  " << std::string(72, '-') << "\n";
+    os << std::fixed << std::setprecision(1);
+    os << "  Class           : " << realTimeClassName(res.granted);
+    if (!res.fallback.empty()) os << "  (" << res.fallback << ")";
+    os << "\n";
+    if (res.refused > 0)
+        os << "  Refused Threads : " << res.refused << " ran in other\n";
+    os << "  Pinned          : " << (res.pinned ? "cpu " + std::to_string(config.cpu)
+                                                : std::string("no")) << "\n"
+       << "  Tick            : " << config.tickMicros << " us\n"
+       << "  Calibration     : " << res.spinsPerMicro << " spins/us\n"
+       << "  Overruns        : " << res.overruns << "\n";
+    if (!res.wakeup.empty())
+        os << "  Wake-up Latency : p50 " << res.wakeup.percentile(50) / 1000.0
+           << " us, p99 " << res.wakeup.percentile(99) / 1000.0
+           << " us, max " << res.wakeup.max() / 1000.0 << " us\n";
+
+    os << "\n  Predicted vs Observed [" << title << "]\n";
+    os << "  " << std::string(78, '-') << "\n";
+    os << std::left
+       << "  " << std::setw(8) << "Task"
+       << std::setw(8)  << "Jobs"
+       << std::setw(10) << "Sim WCRT"
+       << std::setw(10) << "Sim Miss"
+       << std::setw(8)  << "WCRT"
+       << std::setw(8)  << "P99"
+       << std::setw(8)  << "Missed"
+       << std::setw(9)  << "Overrun"
+       << "Wake P99 us\n";
+    os << "  " << std::string(78, '-') << "\n";
+    for (std::size_t i = 0; i < res.schedule.tasks.size(); ++i) {
+        const JobStats&      j = res.schedule.jobs[i];
+        const RealTaskStats& r = res.tasks[i];
+        os << "  " << std::setw(8) << res.schedule.tasks[i].name
+           << std::setw(8) << j.jobs;
+        if (i < predicted.size())
+            os << std::setw(10) << predicted[i].worstResponse
+               << std::setw(10) << predicted[i].misses;
+        else
+            os << std::setw(10) << "-" << std::setw(10) << "-";
+        os << std::setw(8) << j.worstResponse
+           << std::setw(8) << j.latency.response.percentile(99)
+           << std::setw(8) << j.misses
+           << std::setw(9) << r.overruns
+           << r.wakeup.percentile(99) / 1000.0 << "\n";
+    }
+    os << "  " << std::string(78, '-') << "\n";
+}
@@ -0,0 +1,683 @@
+#include "ResourceManager.h"
+#include "ReleaseCalendar.h"
+#include "Scheduler.h"
+#include "Trace.h"
+#include <algorithm>
+#include <deque>
+#include <iomanip>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_map>
+
+// ── Names ─────────────────────────────────────────────────────
+namespace {
+
+struct LockProtocolName {
+    LockProtocol protocol;
+    const char*  name;
+};
+
+constexpr LockProtocolName kLockProtocolNames[] = {
+    {LockProtocol::None,             "none"},
+    {LockProtocol::Inheritance,      "pip"},
+    {LockProtocol::ImmediateCeiling, "ipcp"},
+};
+
+} // namespace
+
+const char* lockProtocolName(LockProtocol protocol) {
+    for (const auto& p : kLockProtocolNames)
+        if (p.protocol == protocol) return p.name;
+    return "unknown";
+}
+
+bool parseLockProtocol(const std::string& name, LockProtocol& protocol) {
+    for (const auto& p : kLockProtocolNames) {
+        if (name == p.name) {
+            protocol = p.protocol;
+            return true;
+        }
+    }
+    return false;
+}
+
+void readCriticalSections(std::istream& in, std::vector<CriticalSection>& sections) {
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(in, line)) {
+        ++lineNo;
+        auto hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+
+        std::istringstream fields(line);
+        std::string        keyword;
+        if (!(fields >> keyword) || keyword != "cs") continue;
+        CriticalSection cs;
+        if (!(fields >> cs.taskId >> cs.resource >> cs.offset >> cs.length))
+            throw std::runtime_error("line " + std::to_string(lineNo) +
+                                     ": expected cs task resource offset length");
+        sections.push_back(cs);
+    }
+}
+
+// ── Resource manager ──────────────────────────────────────────
+ResourceManager::ResourceManager(LockProtocol protocol, int resources, int jobs)
+    : protocol_(protocol),
+      ceiling_(resources, kNoCeiling), holder_(resources, -1), waiters_(resources),
+      base_(jobs, kNoCeiling), effective_(jobs, kNoCeiling), blockedOn_(jobs, -1),
+      held_(jobs) {}
+
+void ResourceManager::declareUse(int resource, int priority) {
+    ceiling_[resource] = std::min(ceiling_[resource], priority);
+}
+
+void ResourceManager::attach(int job, int priority) {
+    base_[job]      = priority;
+    effective_[job] = priority;
+    blockedOn_[job] = -1;
+    held_[job].clear();
+}
+
+void ResourceManager::detach(int job) {
+    if (!held_[job].empty())
+        throw std::logic_error("job finished holding resource " +
+                               std::to_string(held_[job].back()));
+}
+
+void ResourceManager::setPriority(int job, int priority) {
+    if (effective_[job] == priority) return;
+    effective_[job] = priority;
+    changed_.push_back(job);
+}
+
+// Base priority, raised by the ceilings (ipcp) or the waiters (pip)
+// of what the job holds.  Jobs hold a handful of resources at most.
+void ResourceManager::recompute(int job) {
+    int p = base_[job];
+    for (int r : held_[job]) {
+        if (protocol_ == LockProtocol::ImmediateCeiling)
+            p = std::min(p, ceiling_[r]);
+        else if (protocol_ == LockProtocol::Inheritance)
+            for (int w : waiters_[r]) p = std::min(p, effective_[w]);
+    }
+    setPriority(job, p);
+}
+
+void ResourceManager::grant(int job, int resource) {
+    holder_[resource] = job;
+    held_[job].push_back(resource);
+    const int below = stack_.empty() ? kNoCeiling : stack_.back().ceiling;
+    stack_.push_back({resource, std::min(below, ceiling_[resource])});
+    recompute(job);
+}
+
+bool ResourceManager::acquire(int job, int resource) {
+    const int owner = holder_[resource];
+    if (owner < 0) {
+        grant(job, resource);
+        return true;
+    }
+
+    // Walk the chain of holders: a cycle back to `job` is a deadlock;
+    // under pip every holder on the way inherits our priority.
+    const int p = effective_[job];
+    for (int h = owner; h >= 0; h = blockedOn_[h] >= 0 ? holder_[blockedOn_[h]] : -1) {
+        if (h == job)
+            throw std::runtime_error("deadlock on resource " + std::to_string(resource));
+        if (protocol_ == LockProtocol::Inheritance && p < effective_[h])
+            setPriority(h, p);
+    }
+    blockedOn_[job] = resource;
+    waiters_[resource].push_back(job);
+    return false;
+}
+
+void ResourceManager::release(int job, int resource, std::vector<int>& woken) {
+    if (holder_[resource] != job)
+        throw std::logic_error("release of resource " + std::to_string(resource) +
+                               " by a job that does not hold it");
+
+    auto& held = held_[job];
+    held.erase(std::find(held.begin(), held.end(), resource));
+    holder_[resource] = -1;
+
+    // Usually the top of the stack; under pip a holder can unlock
+    // beneath another job's lock, and the entries above are refolded.
+    auto it = std::find_if(stack_.rbegin(), stack_.rend(),
+                           [&](const CeilingEntry& e) { return e.resource == resource; });
+    std::size_t pos = stack_.size() - 1 - (std::size_t)(it - stack_.rbegin());
+    stack_.erase(stack_.begin() + (std::ptrdiff_t)pos);
+    for (std::size_t i = pos; i < stack_.size(); ++i) {
+        const int below = i ? stack_[i - 1].ceiling : kNoCeiling;
+        stack_[i].ceiling = std::min(below, ceiling_[stack_[i].resource]);
+    }
+
+    for (int w : waiters_[resource]) {
+        blockedOn_[w] = -1;
+        woken.push_back(w);
+    }
+    waiters_[resource].clear();
+    recompute(job);
+}
+
+// ── Sections ──────────────────────────────────────────────────
+namespace {
+
+struct LockPoint {
+    int  at;         // Execution offset within the job
+    int  resource;
+    bool lock;
+};
+
+struct SectionTable {
+    int                                        resources = 0;
+    std::vector<std::vector<CriticalSection>>  byTask;   // Per task index
+    std::vector<std::vector<LockPoint>>        points;   // Per task index, in order
+};
+
+// Validates the sections and turns them into lock / unlock points.
+SectionTable buildSections(const std::vector<Task>& tasks,
+                           const std::vector<CriticalSection>& sections) {
+    std::unordered_map<int, int> index;
+    for (int i = 0; i < (int)tasks.size(); ++i) index.emplace(tasks[i].id, i);
+
+    SectionTable table;
+    table.byTask.resize(tasks.size());
+    table.points.resize(tasks.size());
+    for (const CriticalSection& cs : sections) {
+        auto it = index.find(cs.taskId);
+        if (it == index.end())
+            throw std::invalid_argument("critical section for unknown task " +
+                                        std::to_string(cs.taskId));
+        const Task& t = tasks[it->second];
+        if (cs.resource < 0 || cs.offset < 0 || cs.length < 1 ||
+            (std::int64_t)cs.offset + cs.length > t.burstTime)
+            throw std::invalid_argument("task " + std::to_string(t.id) +
+                                        ": critical section outside its WCET");
+        table.resources = std::max(table.resources, cs.resource + 1);
+        table.byTask[it->second].push_back(cs);
+    }
+
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        auto& list = table.byTask[i];
+        std::stable_sort(list.begin(), list.end(),
+                         [](const CriticalSection& a, const CriticalSection& b) {
+            return a.offset != b.offset ? a.offset < b.offset : a.length > b.length;
+        });
+
+        // Open sections form a stack: each must nest in the one below.
+        auto& points = table.points[i];
+        std::vector<const CriticalSection*> open;
+        auto closeUntil = [&](int at) {
+            while (!open.empty() && open.back()->offset + open.back()->length <= at) {
+                points.push_back({open.back()->offset + open.back()->length,
+                                  open.back()->resource, false});
+                open.pop_back();
+            }
+        };
+        for (const CriticalSection& cs : list) {
+            closeUntil(cs.offset);
+            for (const CriticalSection* o : open) {
+                if (cs.offset + cs.length > o->offset + o->length)
+                    throw std::invalid_argument("task " + std::to_string(tasks[i].id) +
+                                                ": critical sections overlap");
+                if (o->resource == cs.resource)
+                    throw std::invalid_argument("task " + std::to_string(tasks[i].id) +
+                                                ": resource " + std::to_string(cs.resource) +
+                                                " locked twice");
+            }
+            points.push_back({cs.offset, cs.resource, true});
+            open.push_back(&cs);
+        }
+        closeUntil(std::numeric_limits<int>::max());
+    }
+    return table;
+}
+
+// Rank per task index, 0 = highest priority.
+std::vector<int> priorityRanks(const std::vector<Task>& tasks, PriorityOrder order) {
+    const std::vector<std::size_t> idx = priorityIndex(tasks, order);
+    std::vector<int> rank(tasks.size());
+    for (std::size_t r = 0; r < idx.size(); ++r) rank[idx[r]] = (int)r;
+    return rank;
+}
+
+std::vector<int> ceilings(const SectionTable& table, const std::vector<int>& rank) {
+    std::vector<int> ceiling(table.resources, ResourceManager::kNoCeiling);
+    for (std::size_t i = 0; i < table.byTask.size(); ++i)
+        for (const CriticalSection& cs : table.byTask[i])
+            ceiling[cs.resource] = std::min(ceiling[cs.resource], rank[i]);
+    return ceiling;
+}
+
+// Under pip a job waiting for A also waits, transitively, for any B
+// that A's holder locks inside its section on A.  Every resource
+// nested in A therefore blocks whoever A's ceiling covers.
+void raiseNestedCeilings(const SectionTable& table, std::vector<int>& ceiling) {
+    for (bool changed = true; changed; ) {
+        changed = false;
+        for (const auto& list : table.byTask) {
+            for (const CriticalSection& outer : list) {
+                for (const CriticalSection& inner : list) {
+                    if (&inner == &outer || inner.offset < outer.offset ||
+                        inner.offset + inner.length > outer.offset + outer.length)
+                        continue;
+                    if (ceiling[outer.resource] < ceiling[inner.resource]) {
+                        ceiling[inner.resource] = ceiling[outer.resource];
+                        changed = true;
+                    }
+                }
+            }
+        }
+    }
+}
+
+std::vector<std::int64_t> bounds(const std::vector<Task>& tasks, const SectionTable& table,
+                                 const std::vector<int>& rank, LockProtocol protocol) {
+    std::vector<int> ceiling = ceilings(table, rank);
+    if (protocol != LockProtocol::ImmediateCeiling) raiseNestedCeilings(table, ceiling);
+    const std::size_t      n       = tasks.size();
+
+    std::vector<std::int64_t> out(n, 0);
+    std::vector<std::int64_t> perResource(table.resources);
+    for (std::size_t i = 0; i < n; ++i) {
+        std::int64_t byTask = 0, longest = 0;
+        std::fill(perResource.begin(), perResource.end(), 0);
+        for (std::size_t j = 0; j < n; ++j) {
+            if (rank[j] <= rank[i]) continue;
+            std::int64_t taskLongest = 0;
+            for (const CriticalSection& cs : table.byTask[j]) {
+                if (ceiling[cs.resource] > rank[i]) continue;   // Cannot block task i
+                taskLongest = std::max<std::int64_t>(taskLongest, cs.length);
+                perResource[cs.resource] = std::max<std::int64_t>(perResource[cs.resource],
+                                                                  cs.length);
+            }
+            byTask += taskLongest;
+            longest = std::max(longest, taskLongest);
+        }
+        std::int64_t byResource = 0;
+        for (std::int64_t len : perResource) byResource += len;
+
+        const std::int64_t pip = std::min(byTask, byResource);
+        switch (protocol) {
+        case LockProtocol::Inheritance:      out[i] = pip; break;
+        case LockProtocol::ImmediateCeiling: out[i] = longest; break;
+        case LockProtocol::None:             out[i] = pip > 0 ? -1 : 0; break;
+        }
+    }
+    return out;
+}
+
+// Prefix sums over priority ranks.  Execution by rank r is added at
+// r; a pending job of rank k has been blocked for everything added
+// above k since it became pending.
+class Fenwick {
+public:
+    explicit Fenwick(int n) : tree_(n + 1, 0) {}
+
+    void add(int rank, std::int64_t v) {
+        total_ += v;
+        for (int i = rank + 1; i < (int)tree_.size(); i += i & -i) tree_[i] += v;
+    }
+
+    // Sum over ranks > `rank`.
+    std::int64_t above(int rank) const {
+        std::int64_t s = 0;
+        for (int i = rank + 1; i > 0; i -= i & -i) s += tree_[i];
+        return total_ - s;
+    }
+
+private:
+    std::vector<std::int64_t> tree_;
+    std::int64_t              total_ = 0;
+};
+
+// ── Simulator ─────────────────────────────────────────────────
+//
+// One job per task is active (the oldest unfinished release), so the
+// task index doubles as the job slot in the ResourceManager.  Ready
+// jobs sit in a heap keyed on effective priority; re-keyed jobs get a
+// new entry and the old one goes stale.
+class ResourceSimulator {
+public:
+    ResourceSimulator(const ResourceConfig& config, const std::vector<Task>& tasks,
+                      const SectionTable& table, std::vector<int> rank, Tick horizon)
+        : tasks_(tasks), table_(table), rank_(std::move(rank)), horizon_(horizon),
+          rm_(config.protocol, table.resources, (int)tasks.size()),
+          jobs_(tasks.size()), backlog_(tasks.size()), blocking_((int)tasks.size()) {
+        for (std::size_t i = 0; i < tasks.size(); ++i)
+            for (const CriticalSection& cs : table.byTask[i])
+                rm_.declareUse(cs.resource, rank_[i]);
+        calendar_.reserve(tasks.size());
+        for (int i = 0; i < (int)tasks.size(); ++i)
+            calendar_.schedule(std::max(tasks[i].arrivalTime, 0), i);
+        res_.tasks.resize(tasks.size());
+        res_.horizon = horizon;
+        labelTasks(res_.gantt, tasks);
+    }
+
+    ResourceResult run() {
+        SimClock clock;
+        while (clock.now() < horizon_) {
+            const Tick now = clock.now();
+            releaseDue(now);
+            schedule(now);
+
+            EventHorizon next(horizon_);
+            next.offer(calendar_.nextTime());
+            if (running_ >= 0) {
+                const Job& j = jobs_[running_];
+                const auto& points = table_.points[running_];
+                const int   stop   = j.point < points.size() ? points[j.point].at
+                                                             : tasks_[running_].burstTime;
+                next.offer(now + (stop - j.done));
+            }
+            const Tick until = next.next();
+
+            if (running_ >= 0) {
+                jobs_[running_].done += until - now;
+                blocking_.add(rank_[running_], until - now);
+                if (until > now) res_.gantt.extend(tasks_[running_].id, now, until);
+            } else {
+                res_.gantt.extend(kIdleTask, now, until);
+            }
+            clock.advanceTo(until);
+
+            // Lock points take effect as soon as they are reached
+            if (running_ >= 0 && runLockPoints(until) &&
+                jobs_[running_].done == tasks_[running_].burstTime)
+                complete(running_, until);
+        }
+
+        // Whatever is still pending past its deadline has missed it
+        for (std::size_t i = 0; i < tasks_.size(); ++i) {
+            int late = 0;
+            if (jobs_[i].active && jobs_[i].deadline <= horizon_) ++late;
+            for (Tick r : backlog_[i])
+                if ((std::int64_t)r + deadlineOf(i) <= horizon_) ++late;
+            res_.tasks[i].misses += late;
+            res_.deadlineMisses  += late;
+        }
+        return std::move(res_);
+    }
+
+private:
+    struct Job {
+        bool          active   = false;
+        Tick          release  = 0;
+        Tick          deadline = 0;
+        int           done     = 0;   // Executed ticks
+        std::size_t   point    = 0;   // Next lock point
+        std::int64_t  started  = 0;   // Dispatch order, 0 = not yet
+        std::int64_t  mark     = 0;   // Fenwick::above() when it became pending
+        std::uint32_t stamp    = 0;
+        bool          queued   = false;
+    };
+
+    struct ReadyEntry {
+        int           priority;
+        std::int64_t  started;
+        Tick          release;
+        int           taskId;
+        int           job;
+        std::uint32_t stamp;
+    };
+
+    // Equal priorities: a job that already started goes first (under
+    // ipcp that is the holder at its ceiling), then release, then id.
+    struct WorseOnTop {
+        bool operator()(const ReadyEntry& a, const ReadyEntry& b) const {
+            if (a.priority != b.priority) return a.priority > b.priority;
+            const std::int64_t sa = a.started ? a.started : std::numeric_limits<std::int64_t>::max();
+            const std::int64_t sb = b.started ? b.started : std::numeric_limits<std::int64_t>::max();
+            if (sa != sb)               return sa > sb;
+            if (a.release != b.release) return a.release > b.release;
+            return a.taskId > b.taskId;
+        }
+    };
+
+    int deadlineOf(std::size_t i) const {
+        return tasks_[i].relativeDeadline > 0 ? tasks_[i].relativeDeadline : tasks_[i].period;
+    }
+
+    void pushReady(int i) {
+        Job& j = jobs_[i];
+        ++j.stamp;
+        j.queued = true;
+        ready_.push_back({rm_.priority(i), j.started, j.release, tasks_[i].id, i, j.stamp});
+        std::push_heap(ready_.begin(), ready_.end(), WorseOnTop{});
+    }
+
+    int topReady() {
+        while (!ready_.empty()) {
+            const ReadyEntry& e = ready_.front();
+            const Job&        j = jobs_[e.job];
+            if (j.queued && j.stamp == e.stamp) return e.job;
+            std::pop_heap(ready_.begin(), ready_.end(), WorseOnTop{});
+            ready_.pop_back();
+        }
+        return -1;
+    }
+
+    void takeReady(int i) {
+        jobs_[i].queued = false;
+        ++jobs_[i].stamp;
+    }
+
+    void applyChanged() {
+        for (int j : rm_.changed())
+            if (jobs_[j].queued) pushReady(j);
+        rm_.clearChanged();
+    }
+
+    void activate(int i, Tick release) {
+        Job& j     = jobs_[i];
+        j.active   = true;
+        j.release  = release;
+        j.deadline = (Tick)std::min<std::int64_t>((std::int64_t)release + deadlineOf(i), kNever);
+        j.done     = 0;
+        j.point    = 0;
+        j.started  = 0;
+        j.mark     = blocking_.above(rank_[i]);
+        rm_.attach(i, rank_[i]);
+        pushReady(i);
+    }
+
+    void releaseDue(Tick now) {
+        while (calendar_.due(now)) {
+            const int   i = calendar_.pop().task;
+            const Task& t = tasks_[i];
+            std::int64_t next = (std::int64_t)now + t.period;
+            if (next < horizon_) calendar_.schedule((Tick)next, i);
+
+            RTOS_TRACE(TraceLevel::Event, TraceEvent::Release, now, t.id, now + deadlineOf(i),
+                       "  [REL]    " << t.name << "  clock=" << now << "\n");
+            if (jobs_[i].active) backlog_[i].push_back(now);
+            else                 activate(i, now);
+        }
+    }
+
+    // Preempt, dispatch and run lock points due at the current
+    // execution offset until the running job is settled.
+    void schedule(Tick now) {
+        for (;;) {
+            int best = topReady();
+            if (running_ >= 0 && best >= 0 && rm_.priority(best) < rm_.priority(running_)) {
+                RTOS_TRACE(TraceLevel::Event, TraceEvent::Preempt, now, tasks_[running_].id,
+                           tasks_[running_].burstTime - jobs_[running_].done,
+                           "  [PRE]    " << tasks_[running_].name << "  by "
+                           << tasks_[best].name << "\n");
+                pushReady(running_);
+                running_ = -1;
+                ++res_.preemptions;
+            }
+            if (running_ < 0) {
+                if (best < 0) return;
+                takeReady(best);
+                running_ = best;
+                if (!jobs_[best].started) jobs_[best].started = ++dispatches_;
+                RTOS_TRACE(TraceLevel::Event, TraceEvent::Dispatch, now, tasks_[best].id,
+                           rm_.priority(best),
+                           "  [RUN]    " << tasks_[best].name << "  clock=" << now
+                           << "  priority=" << rm_.priority(best) << "\n");
+            }
+            if (!runLockPoints(now)) continue;   // Blocked: pick again
+
+            best = topReady();
+            if (best < 0 || rm_.priority(best) >= rm_.priority(running_)) return;
+        }
+    }
+
+    // false when the running job blocked.  Stops before a lock when a
+    // ready job now outranks the running one.
+    bool runLockPoints(Tick now) {
+        const int   i      = running_;
+        Job&        j      = jobs_[i];
+        const auto& points = table_.points[i];
+        while (j.point < points.size() && points[j.point].at == j.done) {
+            const LockPoint& p = points[j.point];
+            if (p.lock) {
+                // An unlock just before may have let a better job in
+                const int best = topReady();
+                if (best >= 0 && rm_.priority(best) < rm_.priority(i)) return true;
+                if (!rm_.acquire(i, p.resource)) {
+                    RTOS_TRACE(TraceLevel::Event, TraceEvent::Block, now, tasks_[i].id, p.resource,
+                               "  [BLOCK]  " << tasks_[i].name << "  on R" << p.resource
+                               << "  held by " << tasks_[rm_.holder(p.resource)].name << "\n");
+                    ++res_.blocks;
+                    running_ = -1;
+                    applyChanged();
+                    return false;
+                }
+                res_.maxLockDepth = std::max(res_.maxLockDepth, rm_.locked());
+                RTOS_TRACE(TraceLevel::Event, TraceEvent::Lock, now, tasks_[i].id, p.resource,
+                           "  [LOCK]   " << tasks_[i].name << "  R" << p.resource
+                           << "  system ceiling=" << rm_.systemCeiling() << "\n");
+            } else {
+                woken_.clear();
+                rm_.release(i, p.resource, woken_);
+                RTOS_TRACE(TraceLevel::Event, TraceEvent::Unlock, now, tasks_[i].id, p.resource,
+                           "  [UNLOCK] " << tasks_[i].name << "  R" << p.resource << "\n");
+                for (int w : woken_) pushReady(w);   // Retries its lock when dispatched
+            }
+            ++j.point;
+            applyChanged();
+        }
+        return true;
+    }
+
+    void complete(int i, Tick now) {
+        Job& j = jobs_[i];
+        BlockingStats& s = res_.tasks[i];
+        const std::int64_t blocked = blocking_.above(rank_[i]) - j.mark;
+        ++s.jobs;
+        s.worstResponse = std::max(s.worstResponse, now - j.release);
+        s.blocking     += blocked;
+        s.worstBlocking = std::max<Tick>(s.worstBlocking, (Tick)blocked);
+        const bool late = now > j.deadline;
+        if (late) {
+            ++s.misses;
+            ++res_.deadlineMisses;
+        }
+        RTOS_TRACE(TraceLevel::Event, TraceEvent::Complete, now, tasks_[i].id, (int)blocked,
+                   "  [DONE]   " << tasks_[i].name << "  clock=" << now
+                   << "  blocked=" << blocked << (late ? "  !! MISSED" : "") << "\n");
+
+        rm_.detach(i);
+        j.active = false;
+        running_ = -1;
+        if (!backlog_[i].empty()) {
+            Tick release = backlog_[i].front();
+            backlog_[i].pop_front();
+            activate(i, release);
+        }
+    }
+
+    const std::vector<Task>& tasks_;
+    const SectionTable&      table_;
+    std::vector<int>         rank_;
+    Tick                     horizon_;
+
+    ResourceManager               rm_;
+    ReleaseCalendar               calendar_;
+    std::vector<Job>              jobs_;
+    std::vector<std::deque<Tick>> backlog_;
+    std::vector<ReadyEntry>       ready_;
+    std::vector<int>              woken_;
+    Fenwick                       blocking_;
+
+    int          running_    = -1;
+    std::int64_t dispatches_ = 0;
+
+    ResourceResult res_;
+};
+
+} // namespace
+
+// ── Entry points ──────────────────────────────────────────────
+std::vector<std::int64_t> blockingBounds(const std::vector<Task>& tasks,
+                                         const std::vector<CriticalSection>& sections,
+                                         LockProtocol protocol, PriorityOrder order) {
+    const std::vector<int> rank  = priorityRanks(tasks, order);
+    const SectionTable     table = buildSections(tasks, sections);
+    return bounds(tasks, table, rank, protocol);
+}
+
+ResourceResult simulateResources(const ResourceConfig& config, const std::vector<Task>& tasks,
+                                 const std::vector<CriticalSection>& sections) {
+    std::vector<int>   rank  = priorityRanks(tasks, config.order);   // Checks periods
+    const SectionTable table = buildSections(tasks, sections);
+    const std::vector<std::int64_t> bound = bounds(tasks, table, rank, config.protocol);
+
+    const Tick horizon = config.horizon > 0 ? config.horizon : hyperperiodTicks(tasks);
+    ResourceResult res = ResourceSimulator(config, tasks, table, std::move(rank), horizon).run();
+    for (std::size_t i = 0; i < tasks.size(); ++i) res.tasks[i].bound = bound[i];
+    return res;
+}
+
+// ── Report ────────────────────────────────────────────────────
+void printResourceReport(const ResourceResult& res, const std::vector<Task>& tasks,
+                         const ResourceConfig& config, bool gantt, std::ostream& os) {
+    const std::string title = std::string(lockProtocolName(config.protocol)) + ", " +
+                              priorityOrderName(config.order);
+    if (gantt) {
+        ScheduleResult view;
+        view.gantt = res.gantt;
+        printGantt(view, title, os);
+    }
+
+    os << "\n  Blocking [" << title << "]\n";
+    os << "  " << std::string(72, '-') << "\n";
+    os << std::left
+       << "  " << std::setw(8) << "Task"
+       << std::setw(6)  << "C"
+       << std::setw(6)  << "T"
+       << std::setw(7)  << "Jobs"
+       << std::setw(7)  << "WCRT"
+       << std::setw(11) << "Blocked"
+       << std::setw(12) << "Worst job"
+       << std::setw(11) << "Bound"
+       << "Missed\n";
+    os << "  " << std::string(72, '-') << "\n";
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        const BlockingStats& s = res.tasks[i];
+        os << "  " << std::setw(8) << tasks[i].name
+           << std::setw(6)  << tasks[i].burstTime
+           << std::setw(6)  << tasks[i].period
+           << std::setw(7)  << s.jobs
+           << std::setw(7)  << s.worstResponse
+           << std::setw(11) << s.blocking
+           << std::setw(12) << s.worstBlocking
+           << std::setw(11) << (s.bound < 0 ? std::string("unbounded") : std::to_string(s.bound))
+           << s.misses << "\n";
+    }
+    os << "  " << std::string(72, '-') << "\n";
+    os << "  Deadline Misses : " << res.deadlineMisses << "\n"
+       << "  Preemptions     : " << res.preemptions << "\n"
+       << "  Blocked Locks   : " << res.blocks << "\n"
+       << "  Max Lock Depth  : " << res.maxLockDepth << "\n"
+       << "  Horizon         : " << res.horizon << " ticks\n";
+}
@@ -0,0 +1,467 @@
+#include "Scheduler.h"
+#include "Analysis.h"
+#include "Instrument.h"
+#include "Algorithms/FCFS.h"
+#include "Algorithms/RoundRobin.h"
+#include "Algorithms/SJF.h"
+#include "Algorithms/Priority.h"
+#include "Algorithms/RateMonotonic.h"
+#include "Algorithms/EDF.h"
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <unordered_map>
+
+// ── Policy names ──────────────────────────────────────────────
+namespace {
+
+struct PolicyName {
+    Policy      policy;
+    const char* name;
+};
+
+constexpr PolicyName kPolicyNames[] = {
+    {Policy::FCFS,               "fcfs"},
+    {Policy::RoundRobin,         "rr"},
+    {Policy::SJF,                "sjf"},
+    {Policy::SRTF,               "srtf"},
+    {Policy::Priority,           "priority"},
+    {Policy::PreemptivePriority, "priority-preemptive"},
+    {Policy::Multilevel,         "mlq"},
+    {Policy::RateMonotonic,      "rm"},
+    {Policy::EDF,                "edf"},
+};
+
+} // namespace
+
+const char* policyName(Policy policy) {
+    for (const auto& p : kPolicyNames)
+        if (p.policy == policy) return p.name;
+    return "unknown";
+}
+
+bool parsePolicy(const std::string& name, Policy& policy) {
+    for (const auto& p : kPolicyNames) {
+        if (name == p.name) {
+            policy = p.policy;
+            return true;
+        }
+    }
+    return false;
+}
+
+// ── Policy adapters ───────────────────────────────────────────
+namespace {
+
+void labelTasks(ScheduleResult& res) {
+    labelTasks(res.gantt, res.tasks);
+}
+
+// Totals and per-task metrics for algorithms that only record the
+// trace and completion times.
+void summarize(ScheduleResult& res) {
+    for (const Segment& s : res.gantt) {
+        if (s.task == kIdleTask) continue;
+        if (s.task == kContextSwitchTask) { ++res.contextSwitches; continue; }
+        res.totalBusyTime += s.length();
+    }
+    res.totalClockTime = res.gantt.endTime();
+
+    // The deadline checks of these algorithms
+    RTOS_PHASE(Phase::Deadline);
+    for (auto& t : res.tasks) {
+        if (!t.completed) continue;
+        t.remainingTime  = 0;
+        t.turnaroundTime = t.completionTime - t.arrivalTime;
+        t.waitingTime    = t.turnaroundTime - t.burstTime;
+        if (t.hardDeadline > 0 && t.completionTime > t.hardDeadline)
+            t.deadlineMissed = true;
+        if (t.deadlineMissed) {
+            ++res.deadlineMisses;
+            RTOS_COUNT(Counter::DeadlineMisses, 1);
+        }
+    }
+}
+
+class FCFSPolicy : public SchedulerBase<FCFSPolicy> {
+public:
+    explicit FCFSPolicy(const SchedulerConfig& config)
+        : scheduler_(config.csPenalty) {}
+
+    ScheduleResult schedule(std::vector<Task> tasks) {
+        ScheduleResult res = scheduler_.run(std::move(tasks));
+        recordLatency(res);
+        return res;
+    }
+
+private:
+    FCFSScheduler scheduler_;
+};
+
+class RoundRobinPolicy : public SchedulerBase<RoundRobinPolicy> {
+public:
+    explicit RoundRobinPolicy(const SchedulerConfig& config)
+        : scheduler_(config.quantum, config.csPenalty) {}
+
+    ScheduleResult schedule(std::vector<Task> tasks) {
+        ScheduleResult res = scheduler_.run(std::move(tasks));
+        recordLatency(res);
+        return res;
+    }
+
+private:
+    RRScheduler scheduler_;
+};
+
+// SJF / SRTF / Priority: algorithms that update the task vector in
+// place.  The algorithm is a template argument, so it is called
+// directly (and usually inlined).
+template <void (*Algorithm)(std::vector<Task>&, SegmentTrace*)>
+class InPlacePolicy : public SchedulerBase<InPlacePolicy<Algorithm>> {
+public:
+    explicit InPlacePolicy(const SchedulerConfig&) {}
+
+    ScheduleResult schedule(std::vector<Task> tasks) {
+        ScheduleResult res;
+        Algorithm(tasks, &res.gantt);
+        res.tasks = std::move(tasks);
+        labelTasks(res);
+        summarize(res);
+        recordLatency(res);
+        return res;
+    }
+};
+
+using SJFPolicy                = InPlacePolicy<sjfScheduling>;
+using SRTFPolicy               = InPlacePolicy<srtfScheduling>;
+using PriorityPolicy           = InPlacePolicy<priorityScheduling>;
+using PreemptivePriorityPolicy = InPlacePolicy<preemptivePriorityScheduling>;
+
+class MultilevelPolicy : public SchedulerBase<MultilevelPolicy> {
+public:
+    explicit MultilevelPolicy(const SchedulerConfig& config) {
+        config_.quantum       = config.quantum;
+        config_.agingInterval = config.agingInterval;
+        config_.feedback      = config.feedback;
+    }
+
+    ScheduleResult schedule(std::vector<Task> tasks) {
+        ScheduleResult res;
+        multilevelScheduling(tasks, config_, &res.gantt);
+        res.tasks = std::move(tasks);
+        labelTasks(res);
+        summarize(res);
+        recordLatency(res);
+        return res;
+    }
+
+private:
+    MultilevelConfig config_;
+};
+
+class RateMonotonicPolicy : public SchedulerBase<RateMonotonicPolicy> {
+public:
+    explicit RateMonotonicPolicy(const SchedulerConfig&) {}
+
+    ScheduleResult schedule(std::vector<Task> tasks) {
+        ScheduleResult res;
+        res.gantt = RM_ScheduleSegments(tasks, (int)tasks.size());
+
+        // Start / completion times come straight from the trace
+        std::unordered_map<int, int> index;
+        for (int i = 0; i < (int)tasks.size(); ++i) index.emplace(tasks[i].id, i);
+        for (const Segment& s : res.gantt) {
+            auto it = index.find(s.task);
+            if (it == index.end()) continue;
+            Task& t = tasks[it->second];
+            if (t.startTime == -1) t.startTime = s.start;
+            t.remainingTime -= s.length();
+            t.completionTime = s.end;
+        }
+        for (auto& t : tasks)
+            t.completed = t.burstTime > 0 && t.remainingTime == 0;
+
+        res.tasks = std::move(tasks);
+        labelTasks(res);
+        summarize(res);
+        recordLatency(res);
+        return res;
+    }
+};
+
+class EDFPolicy : public SchedulerBase<EDFPolicy> {
+public:
+    explicit EDFPolicy(const SchedulerConfig& config)
+        : horizon_(config.horizon), steadyState_(config.steadyState) {}
+
+    ScheduleResult schedule(std::vector<Task> tasks) {
+        int period  = preparePeriodicTasks(tasks);
+        int horizon = horizon_ > 0 ? horizon_ : period;
+        EDFScheduler edf(std::move(tasks), horizon);
+        if (steadyState_) edf.enableSteadyState(period);
+        edf.run();
+
+        ScheduleResult res;
+        res.gantt = edf.takeTrace();
+        res.tasks = edf.takeTasks();
+        labelTasks(res);
+        summarize(res);
+        res.totalClockTime  = horizon;
+        res.totalBusyTime   = (int)edf.busyTime();   // Includes skipped cycles
+        res.deadlineMisses  = edf.deadlineMisses();
+        res.contextSwitches = edf.contextSwitches();
+        res.jobs            = edf.takeJobStats();
+        res.steady          = edf.steadyState();
+        for (const JobStats& j : res.jobs) res.latency.merge(j.latency);
+        return res;
+    }
+
+private:
+    int  horizon_;
+    bool steadyState_;
+};
+
+} // namespace
+
+void labelTasks(SegmentTrace& trace, const std::vector<Task>& tasks) {
+    // Order (id, position) keys rather than the strings; ties keep
+    // the task order, so the last name of an id wins as in setLabel()
+    std::vector<std::pair<int, int>> order;
+    order.reserve(tasks.size());
+    for (std::size_t i = 0; i < tasks.size(); ++i)
+        if (!tasks[i].name.empty()) order.emplace_back(tasks[i].id, (int)i);
+    std::sort(order.begin(), order.end());
+
+    std::vector<std::pair<int, std::string>> labels;
+    labels.reserve(order.size());
+    for (const auto& [id, i] : order) labels.emplace_back(id, tasks[i].name);
+    trace.setLabels(std::move(labels));
+}
+
+void recordLatency(ScheduleResult& res) {
+    res.latency.clear();
+    for (const Task& t : res.tasks) {
+        if (!t.completed) continue;
+        res.latency.complete(t.arrivalTime, t.burstTime, t.completionTime, t.hardDeadline);
+        res.latency.jitter.record(t.startTime - t.arrivalTime);
+    }
+}
+
+void sortByArrival(std::vector<Task>& tasks) {
+    std::vector<std::pair<Tick, int>> order;
+    order.reserve(tasks.size());
+    for (std::size_t i = 0; i < tasks.size(); ++i)
+        order.emplace_back(tasks[i].arrivalTime, (int)i);
+    if (std::is_sorted(order.begin(), order.end())) return;
+    std::sort(order.begin(), order.end());
+
+    std::vector<Task> sorted;
+    sorted.reserve(tasks.size());
+    for (const auto& [arrival, i] : order) sorted.push_back(std::move(tasks[i]));
+    tasks = std::move(sorted);
+}
+
+Tick hyperperiodTicks(const std::vector<Task>& tasks) {
+    std::int64_t h;
+    if (!hyperperiod(tasks, h) || h > std::numeric_limits<Tick>::max())
+        return std::numeric_limits<Tick>::max();
+    return (Tick)h;
+}
+
+int preparePeriodicTasks(std::vector<Task>& tasks) {
+    for (auto& t : tasks) {
+        if (t.period <= 0)
+            throw std::invalid_argument("EDF task " + std::to_string(t.id) +
+                                        " needs a period > 0");
+        if (t.relativeDeadline <= 0)
+            t.relativeDeadline = t.period;   // Implicit deadline
+    }
+    return hyperperiodTicks(tasks);
+}
+
+ScheduleResult runScheduler(const SchedulerConfig& config, std::vector<Task> tasks) {
+    switch (config.policy) {
+    case Policy::FCFS:               return FCFSPolicy(config).run(std::move(tasks));
+    case Policy::RoundRobin:         return RoundRobinPolicy(config).run(std::move(tasks));
+    case Policy::SJF:                return SJFPolicy(config).run(std::move(tasks));
+    case Policy::SRTF:               return SRTFPolicy(config).run(std::move(tasks));
+    case Policy::Priority:           return PriorityPolicy(config).run(std::move(tasks));
+    case Policy::PreemptivePriority: return PreemptivePriorityPolicy(config).run(std::move(tasks));
+    case Policy::Multilevel:         return MultilevelPolicy(config).run(std::move(tasks));
+    case Policy::RateMonotonic:      return RateMonotonicPolicy(config).run(std::move(tasks));
+    case Policy::EDF:                return EDFPolicy(config).run(std::move(tasks));
+    }
+    throw std::invalid_argument("unknown scheduling policy");
+}
+
+// ── Reports ───────────────────────────────────────────────────
+void printGantt(const ScheduleResult& res, const std::string& title,
+                std::ostream& os) {
+    std::vector<GanttEntry> gantt = res.gantt.toGantt();
+
+    // Four columns per tick, except a skipped stretch of steady-state
+    // cycles, which is one fixed-width box however long it is
+    std::vector<int> cells(gantt.size());
+    for (std::size_t i = 0; i < gantt.size(); ++i) {
+        GanttEntry& e = gantt[i];
+        if (res.gantt[i].task == kSkippedTask) {
+            e.label  = "SKIP x";
+            e.label += std::to_string(res.steady.cyclesSkipped);
+            cells[i] = (int)e.label.size() + 4;
+        } else {
+            cells[i] = (e.end - e.start) * 4;
+        }
+    }
+
+    os << "\n  Gantt Chart [" << title << "]\n  ";
+    for (int w : cells) {
+        for (int i = 0; i < w; ++i) os << '-';
+        os << '+';
+    }
+    os << "\n  |";
+    for (std::size_t k = 0; k < gantt.size(); ++k) {
+        const GanttEntry& e = gantt[k];
+        int w    = cells[k] - 1;
+        int lLen = (int)e.label.size();
+        int padL = (w - lLen) / 2;
+        int padR = w - lLen - padL;
+        for (int i = 0; i < padL; ++i) os << ' ';
+        os << e.label;
+        for (int i = 0; i < padR; ++i) os << ' ';
+        os << '|';
+    }
+    os << "\n  ";
+    for (int w : cells) {
+        for (int i = 0; i < w; ++i) os << '-';
+        os << '+';
+    }
+    os << "\n  ";
+    int prev = -1;
+    for (std::size_t k = 0; k < gantt.size(); ++k) {
+        const GanttEntry& e = gantt[k];
+        std::string ts = std::to_string(e.start);
+        if (e.start != prev) { os << ts; prev = e.start; }
+        int w = cells[k] + 1 - (int)ts.size();
+        for (int i = 0; i < w; ++i) os << ' ';
+    }
+    if (!gantt.empty()) os << gantt.back().end;
+    os << "\n";
+}
+
+void printMetrics(const ScheduleResult& res, const std::string& title,
+                  std::ostream& os) {
+    // Periodic policies release many jobs per task: the one-shot
+    // columns would all be zero, and the Periodic Jobs table below
+    // reports them instead
+    const bool periodic = !res.jobs.empty();
+    double totalTAT = 0, totalWT = 0;
+    if (!periodic) {
+        os << "\n  Per-Task Metrics [" << title << "]\n";
+        os << "  " << std::string(68, '-') << "\n";
+        os << std::left
+           << "  " << std::setw(6)  << "Task"
+           << std::setw(9)  << "Arrival"
+           << std::setw(8)  << "Burst"
+           << std::setw(11) << "Deadline"
+           << std::setw(12) << "Completion"
+           << std::setw(12) << "Turnaround"
+           << std::setw(9)  << "Waiting"
+           << "Missed\n";
+        os << "  " << std::string(68, '-') << "\n";
+
+        for (const auto& t : res.tasks) {
+            os << std::left
+               << "  " << std::setw(6)  << t.name
+               << std::setw(9)  << t.arrivalTime
+               << std::setw(8)  << t.burstTime
+               << std::setw(11) << t.hardDeadline
+               << std::setw(12) << t.completionTime
+               << std::setw(12) << t.turnaroundTime
+               << std::setw(9)  << t.waitingTime
+               << (t.deadlineMissed ? "YES !!" : "No") << "\n";
+            totalTAT += t.turnaroundTime;
+            totalWT  += t.waitingTime;
+        }
+        os << "  " << std::string(68, '-') << "\n";
+    } else {
+        os << "\n  Summary [" << title << "]\n";
+        os << "  " << std::string(68, '-') << "\n";
+    }
+    int n = (int)res.tasks.size();
+    double util = res.totalClockTime > 0
+                  ? 100.0 * res.totalBusyTime / res.totalClockTime : 0.0;
+    os << std::fixed << std::setprecision(2);
+    if (!periodic)
+        os << "  Avg Turnaround  : " << (n ? totalTAT / n : 0.0) << " ticks\n"
+           << "  Avg Waiting     : " << (n ? totalWT  / n : 0.0) << " ticks\n";
+    os << "  Deadline Misses : " << res.deadlineMisses << "\n"
+       << "  Context Switches: " << res.contextSwitches << "\n"
+       << "  CPU Utilization : " << util << "%\n"
+       << "  Total Clock     : " << res.totalClockTime << " ticks\n";
+    if (res.steady.cyclesSkipped > 0)
+        os << "  Steady State    : ticks " << res.steady.cycleStart << "-"
+           << res.steady.cycleStart + res.steady.cycleLength << " repeat, "
+           << res.steady.cyclesSkipped << " cycles extrapolated\n";
+    printLatency(res.latency, title, os);
+    if (res.jobs.empty()) return;
+
+    os << "\n  Periodic Jobs [" << title << "]\n";
+    os << "  " << std::string(72, '-') << "\n";
+    os << std::left
+       << "  " << std::setw(6)  << "Task"
+       << std::setw(10) << "Jobs"
+       << std::setw(10) << "Misses"
+       << std::setw(13) << "Worst Resp"
+       << std::setw(10) << "Avg Resp"
+       << std::setw(10) << "P99 Resp"
+       << "P99 Jitter\n";
+    os << "  " << std::string(72, '-') << "\n";
+    for (std::size_t i = 0; i < res.jobs.size() && i < res.tasks.size(); ++i) {
+        const JobStats& j = res.jobs[i];
+        os << std::left
+           << "  " << std::setw(6)  << res.tasks[i].name
+           << std::setw(10) << j.jobs
+           << std::setw(10) << j.misses
+           << std::setw(13) << j.worstResponse
+           << std::setw(10) << (j.jobs ? (double)j.totalResponse / j.jobs : 0.0)
+           << std::setw(10) << j.latency.response.percentile(99)
+           << j.latency.jitter.percentile(99) << "\n";
+    }
+    os << "  " << std::string(72, '-') << "\n";
+}
+
+void printLatency(const JobLatency& latency, const std::string& title,
+                  std::ostream& os) {
+    if (latency.response.empty() && latency.jitter.empty()) return;
+
+    os << "\n  Latency Percentiles [" << title << "]  (ticks)\n";
+    os << "  " << std::string(72, '-') << "\n";
+    os << std::left
+       << "  " << std::setw(10) << "Metric"
+       << std::setw(12) << "Jobs"
+       << std::setw(10) << "Mean"
+       << std::setw(8)  << "P50"
+       << std::setw(8)  << "P90"
+       << std::setw(8)  << "P99"
+       << std::setw(8)  << "P99.9"
+       << "Max\n";
+    os << "  " << std::string(72, '-') << "\n";
+    auto row = [&](const char* name, const LogHistogram& h) {
+        os << "  " << std::setw(10) << name
+           << std::setw(12) << h.count()
+           << std::setw(10) << h.mean()
+           << std::setw(8)  << h.percentile(50)
+           << std::setw(8)  << h.percentile(90)
+           << std::setw(8)  << h.percentile(99)
+           << std::setw(8)  << h.percentile(99.9)
+           << h.max() << "\n";
+    };
+    os << std::fixed << std::setprecision(2);
+    row("Response", latency.response);
+    row("Waiting",  latency.waiting);
+    if (!latency.lateness.empty()) row("Lateness", latency.lateness);
+    row("Jitter",   latency.jitter);
+    os << "  " << std::string(72, '-') << "\n";
+}
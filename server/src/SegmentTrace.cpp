@@ -0,0 +1,84 @@
+#include "SegmentTrace.h"
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+namespace {
+
+using Label = std::pair<int, std::string>;
+
+bool byTask(const Label& a, const Label& b) { return a.first < b.first; }
+bool before(const Label& a, int task)       { return a.first < task; }
+
+} // namespace
+
+void SegmentTrace::setLabel(int task, std::string label) {
+    auto it = std::lower_bound(labels_.begin(), labels_.end(), task, before);
+    if (it != labels_.end() && it->first == task) it->second = std::move(label);
+    else                                          labels_.emplace(it, task, std::move(label));
+}
+
+void SegmentTrace::setLabels(std::vector<Label> labels) {
+    // Stable, so the last label of a task is the last of its run.
+    // Tasks numbered in input order are usually sorted already.
+    if (!std::is_sorted(labels.begin(), labels.end(), byTask))
+        std::stable_sort(labels.begin(), labels.end(), byTask);
+
+    // Duplicates: the last one wins
+    auto last = labels.begin();
+    for (auto it = labels.begin(); it != labels.end(); ++it) {
+        if (it + 1 != labels.end() && (it + 1)->first == it->first) continue;
+        if (last != it) *last = std::move(*it);
+        ++last;
+    }
+    labels.erase(last, labels.end());
+
+    if (labels_.empty()) {
+        labels_ = std::move(labels);
+        return;
+    }
+    std::vector<Label> merged;
+    merged.reserve(labels_.size() + labels.size());
+    auto old = labels_.begin();
+    for (Label& l : labels) {
+        while (old != labels_.end() && old->first < l.first)
+            merged.push_back(std::move(*old++));
+        if (old != labels_.end() && old->first == l.first) ++old;
+        merged.push_back(std::move(l));
+    }
+    merged.insert(merged.end(), std::make_move_iterator(old),
+                  std::make_move_iterator(labels_.end()));
+    labels_ = std::move(merged);
+}
+
+std::string SegmentTrace::label(int task) const {
+    auto it = std::lower_bound(labels_.begin(), labels_.end(), task, before);
+    if (it != labels_.end() && it->first == task) return it->second;
+    if (task == kIdleTask)          return "IDLE";
+    if (task == kContextSwitchTask) return "CS";
+    if (task == kSkippedTask)       return "SKIP";
+    return std::to_string(task);
+}
+
+int SegmentTrace::taskAt(Tick t) const {
+    auto it = std::upper_bound(segments_.begin(), segments_.end(), t,
+        [](Tick tick, const Segment& s){ return tick < s.end; });
+    if (it == segments_.end() || t < it->start) return kIdleTask;
+    return it->task;
+}
+
+std::vector<int> SegmentTrace::toTickOrder() const {
+    std::vector<int> order;
+    order.reserve(endTime() - startTime());
+    for (const Segment& s : segments_)
+        order.insert(order.end(), s.length(), s.task);
+    return order;
+}
+
+std::vector<GanttEntry> SegmentTrace::toGantt() const {
+    std::vector<GanttEntry> gantt;
+    gantt.reserve(segments_.size());
+    for (const Segment& s : segments_)
+        gantt.push_back({label(s.task), s.start, s.end});
+    return gantt;
+}
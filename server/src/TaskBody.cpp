@@ -0,0 +1,592 @@
+#include "TaskBody.h"
+#include "ReleaseCalendar.h"
+#include "Scheduler.h"
+#include "Trace.h"
+#include <algorithm>
+#include <deque>
+#include <iomanip>
+#include <istream>
+#include <limits>
+#include <new>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+// ── Frame pool ────────────────────────────────────────────────
+FramePool& FramePool::local() {
+    static thread_local FramePool pool;
+    return pool;
+}
+
+void* FramePool::allocate(std::size_t n) {
+    const std::size_t c = (n + kGranule - 1) / kGranule;   // 1-based size class
+    if (c > kClasses) return ::operator new(n);
+    ++live_;
+    if (FreeFrame* f = free_[c - 1]) {
+        free_[c - 1] = f->next;
+        return f;
+    }
+
+    // The tail of a full chunk is left unused
+    const std::size_t size = c * kGranule;
+    if ((std::size_t)(end_ - bump_) < size) {
+        chunks_.emplace_back(new char[kChunk]);
+        reserved_ += kChunk;
+        bump_ = chunks_.back().get();
+        end_  = bump_ + kChunk;
+    }
+    void* p = bump_;
+    bump_ += size;
+    return p;
+}
+
+void FramePool::deallocate(void* p, std::size_t n) noexcept {
+    const std::size_t c = (n + kGranule - 1) / kGranule;
+    if (c > kClasses) {
+        ::operator delete(p);
+        return;
+    }
+    --live_;
+    FreeFrame* f = ::new (p) FreeFrame{free_[c - 1]};
+    free_[c - 1] = f;
+}
+
+// ── Scripts ───────────────────────────────────────────────────
+namespace {
+
+struct BodyOpName {
+    BodyOpKind  kind;
+    const char* name;
+};
+
+constexpr BodyOpName kBodyOpNames[] = {
+    {BodyOpKind::Compute, "compute"},
+    {BodyOpKind::Sleep,   "sleep"},
+    {BodyOpKind::Lock,    "lock"},
+    {BodyOpKind::Unlock,  "unlock"},
+    {BodyOpKind::Wait,    "wait"},
+    {BodyOpKind::Signal,  "signal"},
+};
+
+} // namespace
+
+const char* bodyOpName(BodyOpKind kind) {
+    for (const auto& o : kBodyOpNames)
+        if (o.kind == kind) return o.name;
+    return "unknown";
+}
+
+void readBodyScripts(std::istream& in, std::vector<BodyScript>& scripts) {
+    std::string line;
+    int lineNo = 0;
+    while (std::getline(in, line)) {
+        ++lineNo;
+        auto hash = line.find('#');
+        if (hash != std::string::npos) line.erase(hash);
+
+        std::istringstream fields(line);
+        std::string        keyword;
+        if (!(fields >> keyword) || keyword != "body") continue;
+        BodyScript script;
+        if (!(fields >> script.taskId))
+            throw std::runtime_error("line " + std::to_string(lineNo) +
+                                     ": expected body task op n ...");
+        std::string name;
+        while (fields >> name) {
+            const BodyOpName* op = nullptr;
+            for (const auto& o : kBodyOpNames)
+                if (name == o.name) op = &o;
+            BodyOp b;
+            if (!op || !(fields >> b.arg))
+                throw std::runtime_error("line " + std::to_string(lineNo) +
+                                         ": expected an operation and its argument, got '" +
+                                         name + "'");
+            b.kind = op->kind;
+            script.ops.push_back(b);
+        }
+        scripts.push_back(std::move(script));
+    }
+}
+
+JobBody scriptedBody(const BodyOp* ops, std::size_t n) {
+    for (std::size_t k = 0; k < n; ++k) co_await body::Operation{ops[k]};
+}
+
+// ── Simulator ─────────────────────────────────────────────────
+namespace {
+
+// Same shape as ResourceManager.cpp's simulator: one active job per
+// task, so the task index is the job slot, and a ready heap keyed on
+// effective priority whose re-keyed entries go stale.  What a job
+// runs comes from its body instead of a table of lock points.
+class BodySimulator {
+public:
+    BodySimulator(const BodyConfig& config, const std::vector<Task>& tasks,
+                  const std::vector<std::vector<int>>& locks, const BodyFactory& body,
+                  Tick horizon)
+        : tasks_(tasks), locks_(locks), body_(body), horizon_(horizon),
+          rm_(config.protocol, resourceCount(locks), (int)tasks.size()),
+          rank_(tasks.size()), jobs_(tasks.size()), backlog_(tasks.size()) {
+        const std::vector<std::size_t> idx = priorityIndex(tasks, config.order);
+        for (std::size_t r = 0; r < idx.size(); ++r) rank_[idx[r]] = (int)r;
+        for (std::size_t i = 0; i < locks.size() && i < tasks.size(); ++i)
+            for (int r : locks[i]) rm_.declareUse(r, rank_[i]);
+
+        calendar_.reserve(tasks.size());
+        for (int i = 0; i < (int)tasks.size(); ++i)
+            calendar_.schedule(std::max(tasks[i].arrivalTime, 0), i);
+        res_.tasks.resize(tasks.size());
+        res_.horizon = horizon;
+        labelTasks(res_.gantt, tasks);
+    }
+
+    BodyResult run() {
+        SimClock clock;
+        for (;;) {
+            const Tick now = clock.now();
+            releaseDue(now);
+            wakeDue(now);
+            schedule(now);
+            if (now >= horizon_) break;
+
+            EventHorizon next(horizon_);
+            next.offer(calendar_.nextTime());
+            next.offer(wakeups_.nextTime());
+            if (running_ >= 0) next.offer(now + jobs_[running_].left);
+            const Tick until = next.next();
+
+            if (running_ >= 0) {
+                Job& j = jobs_[running_];
+                j.left     -= until - now;
+                j.executed += until - now;
+                res_.gantt.extend(tasks_[running_].id, now, until);
+            } else {
+                res_.gantt.extend(kIdleTask, now, until);
+            }
+            clock.advanceTo(until);
+
+            // Operations take effect as soon as the compute before
+            // them ends, ahead of what else happens at `until`
+            if (running_ >= 0) settle(until);
+        }
+
+        // Whatever is still pending past its deadline has missed it
+        for (std::size_t i = 0; i < tasks_.size(); ++i) {
+            int late = 0;
+            if (jobs_[i].active && jobs_[i].deadline <= horizon_) ++late;
+            for (Tick r : backlog_[i])
+                if ((std::int64_t)r + deadlineOf(i) <= horizon_) ++late;
+            res_.tasks[i].misses += late;
+            res_.deadlineMisses  += late;
+            res_.latency.merge(res_.tasks[i].latency);
+        }
+        res_.frameBytes = FramePool::local().reserved();
+        return std::move(res_);
+    }
+
+private:
+    struct Job {
+        JobBody       body;
+        bool          active   = false;
+        bool          retry    = false;   // Dispatch retries the lock it blocked on
+        Tick          release  = 0;
+        Tick          deadline = 0;
+        Tick          left     = 0;       // Of the current compute()
+        Tick          executed = 0;
+        std::int64_t  number   = 0;       // Releases activated so far
+        std::int64_t  started  = 0;       // Dispatch order, 0 = not yet
+        std::uint32_t stamp    = 0;
+        bool          queued   = false;
+    };
+
+    struct ReadyEntry {
+        int           priority;
+        std::int64_t  started;
+        Tick          release;
+        int           taskId;
+        int           job;
+        std::uint32_t stamp;
+    };
+
+    // As in ResourceManager.cpp: equal priorities run a started job
+    // first, then by release, then by id.
+    struct WorseOnTop {
+        bool operator()(const ReadyEntry& a, const ReadyEntry& b) const {
+            if (a.priority != b.priority) return a.priority > b.priority;
+            const std::int64_t sa = a.started ? a.started : std::numeric_limits<std::int64_t>::max();
+            const std::int64_t sb = b.started ? b.started : std::numeric_limits<std::int64_t>::max();
+            if (sa != sb)               return sa > sb;
+            if (a.release != b.release) return a.release > b.release;
+            return a.taskId > b.taskId;
+        }
+    };
+
+    struct Event {
+        int             posts = 0;
+        std::deque<int> waiters;
+    };
+
+    static int resourceCount(const std::vector<std::vector<int>>& locks) {
+        int n = 0;
+        for (const auto& list : locks)
+            for (int r : list) {
+                if (r < 0) throw std::invalid_argument("negative resource " + std::to_string(r));
+                n = std::max(n, r + 1);
+            }
+        return n;
+    }
+
+    int deadlineOf(std::size_t i) const {
+        return tasks_[i].relativeDeadline > 0 ? tasks_[i].relativeDeadline : tasks_[i].period;
+    }
+
+    void pushReady(int i) {
+        Job& j = jobs_[i];
+        ++j.stamp;
+        j.queued = true;
+        ready_.push_back({rm_.priority(i), j.started, j.release, tasks_[i].id, i, j.stamp});
+        std::push_heap(ready_.begin(), ready_.end(), WorseOnTop{});
+    }
+
+    int topReady() {
+        while (!ready_.empty()) {
+            const ReadyEntry& e = ready_.front();
+            const Job&        j = jobs_[e.job];
+            if (j.queued && j.stamp == e.stamp) return e.job;
+            std::pop_heap(ready_.begin(), ready_.end(), WorseOnTop{});
+            ready_.pop_back();
+        }
+        return -1;
+    }
+
+    void takeReady(int i) {
+        jobs_[i].queued = false;
+        ++jobs_[i].stamp;
+    }
+
+    void applyChanged() {
+        for (int j : rm_.changed())
+            if (jobs_[j].queued) pushReady(j);
+        rm_.clearChanged();
+    }
+
+    Event& event(int e) {
+        if (e < 0) throw std::runtime_error("negative event " + std::to_string(e));
+        if (e >= (int)events_.size()) events_.resize(e + 1);
+        return events_[e];
+    }
+
+    void activate(int i, Tick release) {
+        Job& j     = jobs_[i];
+        j.body     = body_(i, j.number++);
+        j.active   = true;
+        j.retry    = false;
+        j.release  = release;
+        j.deadline = (Tick)std::min<std::int64_t>((std::int64_t)release + deadlineOf(i), kNever);
+        j.left     = 0;
+        j.executed = 0;
+        j.started  = 0;
+        rm_.attach(i, rank_[i]);
+        pushReady(i);
+        res_.peakFrames = std::max(res_.peakFrames, ++frames_);
+    }
+
+    void releaseDue(Tick now) {
+        while (calendar_.due(now)) {
+            const int   i = calendar_.pop().task;
+            const Task& t = tasks_[i];
+            std::int64_t next = (std::int64_t)now + t.period;
+            if (next < horizon_) calendar_.schedule((Tick)next, i);
+
+            RTOS_TRACE(TraceLevel::Event, TraceEvent::Release, now, t.id, now + deadlineOf(i),
+                       "  [REL]    " << t.name << "  clock=" << now << "\n");
+            if (jobs_[i].active) backlog_[i].push_back(now);
+            else                 activate(i, now);
+        }
+    }
+
+    void wakeDue(Tick now) {
+        while (wakeups_.due(now)) pushReady(wakeups_.pop().task);
+    }
+
+    // Preempt and dispatch until the running job has compute time
+    // left or there is nothing to run.
+    void schedule(Tick now) {
+        for (;;) {
+            if (running_ >= 0) settle(now);
+            const int best = topReady();
+            if (running_ >= 0 && best >= 0 && rm_.priority(best) < rm_.priority(running_)) {
+                RTOS_TRACE(TraceLevel::Event, TraceEvent::Preempt, now, tasks_[running_].id,
+                           jobs_[running_].left,
+                           "  [PRE]    " << tasks_[running_].name << "  by "
+                           << tasks_[best].name << "\n");
+                pushReady(running_);
+                running_ = -1;
+                ++res_.preemptions;
+            }
+            if (running_ >= 0) return;
+            if (best < 0) return;
+
+            takeReady(best);
+            running_ = best;
+            Job& j = jobs_[best];
+            if (!j.started) {
+                j.started = ++dispatches_;
+                res_.tasks[best].latency.jitter.record(now - j.release);
+            }
+            RTOS_TRACE(TraceLevel::Event, TraceEvent::Dispatch, now, tasks_[best].id,
+                       rm_.priority(best),
+                       "  [RUN]    " << tasks_[best].name << "  clock=" << now
+                       << "  priority=" << rm_.priority(best) << "\n");
+        }
+    }
+
+    // Runs the running job's operations that take no time, until it
+    // has compute time left, leaves the CPU or stops before a lock.
+    void settle(Tick now) {
+        while (running_ >= 0 && jobs_[running_].left == 0 && step(now)) {}
+    }
+
+    // One operation of the running job's body.  false when it stopped
+    // before a lock because a ready job now outranks it.
+    bool step(Tick now) {
+        const int   i = running_;
+        Job&        j = jobs_[i];
+        const Task& t = tasks_[i];
+        if (j.retry) {
+            j.retry = false;
+        } else if (!j.body.step()) {
+            complete(i, now);
+            return true;
+        }
+
+        const BodyOp& op = j.body.op();
+        switch (op.kind) {
+        case BodyOpKind::Compute:
+            if (op.arg > 0) j.left = op.arg;
+            break;
+
+        case BodyOpKind::Sleep: {
+            if (op.arg <= 0) break;
+            const Tick wake = (Tick)std::min<std::int64_t>((std::int64_t)now + op.arg, kNever);
+            RTOS_TRACE(TraceLevel::Event, TraceEvent::Sleep, now, t.id, wake,
+                       "  [SLEEP]  " << t.name << "  until " << wake << "\n");
+            wakeups_.schedule(wake, i);
+            suspend(i);
+            break;
+        }
+
+        case BodyOpKind::Lock: {
+            const auto& declared = locks_[i];
+            if (std::find(declared.begin(), declared.end(), op.arg) == declared.end())
+                throw std::runtime_error("task " + std::to_string(t.id) +
+                                         " locks undeclared resource " + std::to_string(op.arg));
+            // An unlock just before may have let a better job in
+            const int best = topReady();
+            if (best >= 0 && rm_.priority(best) < rm_.priority(i)) {
+                j.retry = true;
+                return false;
+            }
+            if (!rm_.acquire(i, op.arg)) {
+                RTOS_TRACE(TraceLevel::Event, TraceEvent::Block, now, t.id, op.arg,
+                           "  [BLOCK]  " << t.name << "  on R" << op.arg
+                           << "  held by " << tasks_[rm_.holder(op.arg)].name << "\n");
+                ++res_.tasks[i].blocks;
+                ++res_.blocks;
+                j.retry  = true;
+                running_ = -1;
+            } else {
+                RTOS_TRACE(TraceLevel::Event, TraceEvent::Lock, now, t.id, op.arg,
+                           "  [LOCK]   " << t.name << "  R" << op.arg
+                           << "  system ceiling=" << rm_.systemCeiling() << "\n");
+            }
+            applyChanged();
+            break;
+        }
+
+        case BodyOpKind::Unlock:
+            woken_.clear();
+            rm_.release(i, op.arg, woken_);
+            RTOS_TRACE(TraceLevel::Event, TraceEvent::Unlock, now, t.id, op.arg,
+                       "  [UNLOCK] " << t.name << "  R" << op.arg << "\n");
+            for (int w : woken_) pushReady(w);   // Retries its lock when dispatched
+            applyChanged();
+            break;
+
+        case BodyOpKind::Wait: {
+            Event& e = event(op.arg);
+            if (e.posts > 0) {
+                --e.posts;
+                break;
+            }
+            RTOS_TRACE(TraceLevel::Event, TraceEvent::Wait, now, t.id, op.arg,
+                       "  [WAIT]   " << t.name << "  E" << op.arg << "\n");
+            e.waiters.push_back(i);
+            suspend(i);
+            break;
+        }
+
+        case BodyOpKind::Signal: {
+            Event& e = event(op.arg);
+            RTOS_TRACE(TraceLevel::Event, TraceEvent::Signal, now, t.id, op.arg,
+                       "  [SIGNAL] " << t.name << "  E" << op.arg << "\n");
+            if (e.waiters.empty()) {
+                ++e.posts;
+            } else {
+                pushReady(e.waiters.front());   // Its wait() returns when dispatched
+                e.waiters.pop_front();
+            }
+            break;
+        }
+        }
+        return true;
+    }
+
+    void suspend(int i) {
+        ++res_.tasks[i].suspensions;
+        ++res_.suspensions;
+        running_ = -1;
+    }
+
+    void complete(int i, Tick now) {
+        Job&           j = jobs_[i];
+        BodyTaskStats& s = res_.tasks[i];
+        ++s.jobs;
+        ++res_.jobsCompleted;
+        s.worstResponse = std::max(s.worstResponse, now - j.release);
+        s.executed     += j.executed;
+        s.latency.complete(j.release, j.executed, now, j.deadline);
+        const bool late = now > j.deadline;
+        if (late) {
+            ++s.misses;
+            ++res_.deadlineMisses;
+        }
+        RTOS_TRACE(TraceLevel::Event, TraceEvent::Complete, now, tasks_[i].id, j.executed,
+                   "  [DONE]   " << tasks_[i].name << "  clock=" << now
+                   << "  executed=" << j.executed << (late ? "  !! MISSED" : "") << "\n");
+
+        rm_.detach(i);
+        j.body   = JobBody();   // The frame goes back to the pool
+        j.active = false;
+        --frames_;
+        running_ = -1;
+        if (!backlog_[i].empty()) {
+            Tick release = backlog_[i].front();
+            backlog_[i].pop_front();
+            activate(i, release);
+        }
+    }
+
+    const std::vector<Task>&             tasks_;
+    const std::vector<std::vector<int>>& locks_;
+    const BodyFactory&                   body_;
+    Tick                                 horizon_;
+
+    ResourceManager               rm_;
+    std::vector<int>              rank_;
+    ReleaseCalendar               calendar_;
+    ReleaseCalendar               wakeups_;   // Sleeping jobs, by wake-up tick
+    std::vector<Job>              jobs_;
+    std::vector<std::deque<Tick>> backlog_;
+    std::vector<ReadyEntry>       ready_;
+    std::vector<Event>            events_;
+    std::vector<int>              woken_;
+
+    int          running_    = -1;
+    std::int64_t dispatches_ = 0;
+    std::size_t  frames_     = 0;
+
+    BodyResult res_;
+};
+
+} // namespace
+
+// ── Entry points ──────────────────────────────────────────────
+BodyResult simulateBodies(const BodyConfig& config, const std::vector<Task>& tasks,
+                          const std::vector<std::vector<int>>& locks,
+                          const BodyFactory& body) {
+    if (locks.size() != tasks.size())
+        throw std::invalid_argument("one lock list per task expected");
+    const Tick horizon = config.horizon > 0 ? config.horizon : hyperperiodTicks(tasks);
+    return BodySimulator(config, tasks, locks, body, horizon).run();
+}
+
+BodyResult simulateScripts(const BodyConfig& config, const std::vector<Task>& tasks,
+                           const std::vector<BodyScript>& scripts) {
+    std::unordered_map<int, int> index;
+    for (int i = 0; i < (int)tasks.size(); ++i) index.emplace(tasks[i].id, i);
+
+    std::vector<std::vector<BodyOp>> ops(tasks.size());
+    std::vector<std::vector<int>>    locks(tasks.size());
+    for (const BodyScript& s : scripts) {
+        auto it = index.find(s.taskId);
+        if (it == index.end())
+            throw std::invalid_argument("body for unknown task " + std::to_string(s.taskId));
+        for (const BodyOp& op : s.ops) {
+            if (op.arg < 0)
+                throw std::invalid_argument("task " + std::to_string(s.taskId) + ": " +
+                                            bodyOpName(op.kind) + " " + std::to_string(op.arg));
+            auto& declared = locks[it->second];
+            if (op.kind == BodyOpKind::Lock &&
+                std::find(declared.begin(), declared.end(), op.arg) == declared.end())
+                declared.push_back(op.arg);
+        }
+        ops[it->second].insert(ops[it->second].end(), s.ops.begin(), s.ops.end());
+    }
+    for (std::size_t i = 0; i < tasks.size(); ++i)
+        if (ops[i].empty()) ops[i].push_back({BodyOpKind::Compute, tasks[i].burstTime});
+
+    return simulateBodies(config, tasks, locks, [&ops](int task, std::int64_t) {
+        return scriptedBody(ops[task].data(), ops[task].size());
+    });
+}
+
+// ── Report ────────────────────────────────────────────────────
+void printBodyReport(const BodyResult& res, const std::vector<Task>& tasks,
+                     const BodyConfig& config, bool gantt, std::ostream& os) {
+    const std::string title = std::string("bodies, ") + lockProtocolName(config.protocol) +
+                              ", " + priorityOrderName(config.order);
+    if (gantt) {
+        ScheduleResult view;
+        view.gantt = res.gantt;
+        printGantt(view, title, os);
+    }
+
+    os << "\n  Per-Task Results [" << title << "]\n";
+    os << "  " << std::string(72, '-') << "\n";
+    os << std::left
+       << "  " << std::setw(8) << "Task"
+       << std::setw(6)  << "T"
+       << std::setw(8)  << "Jobs"
+       << std::setw(10) << "Executed"
+       << std::setw(8)  << "WCRT"
+       << std::setw(8)  << "P99"
+       << std::setw(10) << "Suspends"
+       << std::setw(8)  << "Blocks"
+       << "Missed\n";
+    os << "  " << std::string(72, '-') << "\n";
+    for (std::size_t i = 0; i < tasks.size(); ++i) {
+        const BodyTaskStats& s = res.tasks[i];
+        os << "  " << std::setw(8) << tasks[i].name
+           << std::setw(6)  << tasks[i].period
+           << std::setw(8)  << s.jobs
+           << std::setw(10) << s.executed
+           << std::setw(8)  << s.worstResponse
+           << std::setw(8)  << s.latency.response.percentile(99)
+           << std::setw(10) << s.suspensions
+           << std::setw(8)  << s.blocks
+           << s.misses << "\n";
+    }
+    os << "  " << std::string(72, '-') << "\n";
+    os << "  Jobs Completed  : " << res.jobsCompleted << "\n"
+       << "  Deadline Misses : " << res.deadlineMisses << "\n"
+       << "  Preemptions     : " << res.preemptions << "\n"
+       << "  Suspensions     : " << res.suspensions << "\n"
+       << "  Blocked Locks   : " << res.blocks << "\n"
+       << "  Peak Frames     : " << res.peakFrames << " (" << res.frameBytes / 1024
+       << " KiB pooled)\n"
+       << "  Horizon         : " << res.horizon << " ticks\n";
+    printLatency(res.latency, title, os);
+}
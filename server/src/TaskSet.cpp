@@ -0,0 +1,249 @@
+#include "TaskSet.h"
+#include "Options.h"
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <ostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char          kMagic[8]  = {'R', 'T', 'O', 'S', 'T', 'S', 'K', '1'};
+constexpr std::uint32_t kVersion   = 1;
+constexpr int           kMaxDraws  = 1000;   // UUniFast-Discard attempts
+constexpr double        kTolerance = 0.01;   // Relative; see GeneratorConfig
+
+std::runtime_error fileError(const char* what) {
+    return std::runtime_error(std::string("task-set file: ") + what);
+}
+
+// Closes the descriptor on every exit path of loadTasks().
+struct FdGuard {
+    int fd;
+    ~FdGuard() { if (fd >= 0) ::close(fd); }
+};
+
+} // namespace
+
+Task toTask(const TaskRecord& r) {
+    Task t;
+    t.id               = r.id;
+    t.name             = 'T' + std::to_string(r.id);   // Fits the SSO buffer
+    t.arrivalTime      = r.arrivalTime;
+    t.burstTime        = r.burstTime;
+    t.priority         = r.priority;
+    t.period           = r.period;
+    t.relativeDeadline = r.relativeDeadline;
+    t.hardDeadline     = r.hardDeadline;
+    return t;
+}
+
+// ── MappedTaskSet ─────────────────────────────────────────────
+MappedTaskSet::~MappedTaskSet() {
+    unmap();
+}
+
+MappedTaskSet::MappedTaskSet(MappedTaskSet&& other) noexcept {
+    *this = std::move(other);
+}
+
+MappedTaskSet& MappedTaskSet::operator=(MappedTaskSet&& other) noexcept {
+    if (this != &other) {
+        unmap();
+        base_    = std::exchange(other.base_, nullptr);
+        bytes_   = std::exchange(other.bytes_, 0);
+        header_  = std::exchange(other.header_, nullptr);
+        records_ = std::exchange(other.records_, nullptr);
+        size_    = std::exchange(other.size_, 0);
+    }
+    return *this;
+}
+
+void MappedTaskSet::unmap() {
+    if (base_) ::munmap(base_, bytes_);
+    base_    = nullptr;
+    bytes_   = 0;
+    header_  = nullptr;
+    records_ = nullptr;
+    size_    = 0;
+}
+
+bool MappedTaskSet::map(int fd) {
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) return false;
+    if ((std::size_t)st.st_size < sizeof kMagic) return false;
+
+    // pread() leaves the offset for a text reader if this is not ours
+    char magic[sizeof kMagic];
+    if (::pread(fd, magic, sizeof magic, 0) != (ssize_t)sizeof magic) return false;
+    if (std::memcmp(magic, kMagic, sizeof kMagic) != 0) return false;
+
+    const std::size_t bytes = (std::size_t)st.st_size;
+    if (bytes < sizeof(TaskSetHeader)) throw fileError("truncated header");
+    void* base = ::mmap(nullptr, bytes, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (base == MAP_FAILED) throw fileError(std::strerror(errno));
+    ::madvise(base, bytes, MADV_SEQUENTIAL);
+
+    const auto* header = static_cast<const TaskSetHeader*>(base);
+    const char* error  = nullptr;
+    if (header->version != kVersion)                      error = "unsupported version";
+    else if (header->recordSize != sizeof(TaskRecord))    error = "unexpected record size";
+    else if (header->count > (bytes - sizeof *header) / sizeof(TaskRecord) ||
+             bytes != sizeof *header + header->count * sizeof(TaskRecord))
+        error = "size does not match the record count";
+    if (error) {
+        ::munmap(base, bytes);
+        throw fileError(error);
+    }
+
+    unmap();
+    base_    = base;
+    bytes_   = bytes;
+    header_  = header;
+    records_ = reinterpret_cast<const TaskRecord*>(header + 1);
+    size_    = (std::size_t)header->count;
+    return true;
+}
+
+void MappedTaskSet::appendTo(std::vector<Task>& tasks) const {
+    tasks.reserve(tasks.size() + size_);
+    for (const TaskRecord& r : *this) tasks.push_back(toTask(r));
+}
+
+void loadTasks(const std::string& path, std::vector<Task>& tasks) {
+    FdGuard file{::open(path.c_str(), O_RDONLY | O_CLOEXEC)};
+    if (file.fd < 0) throw std::runtime_error("cannot open '" + path + "'");
+    MappedTaskSet set;
+    if (set.map(file.fd)) {
+        set.appendTo(tasks);
+        return;
+    }
+    std::ifstream text(path);
+    if (!text) throw std::runtime_error("cannot open '" + path + "'");
+    readTasks(text, tasks);
+}
+
+// ── Generator ─────────────────────────────────────────────────
+std::vector<TaskRecord> generateTaskSet(const GeneratorConfig& config,
+                                        TaskSetHeader& header) {
+    const std::size_t n = config.tasks;
+    if (n == 0)
+        throw std::invalid_argument("a task set needs at least one task");
+    if (!(config.utilization > 0))
+        throw std::invalid_argument("utilization must be positive");
+    if (config.periodMin < 1 || config.periodMax < config.periodMin)
+        throw std::invalid_argument("periods must satisfy 1 <= min <= max");
+    if (config.granularity < 1 || config.granularity > config.periodMax)
+        throw std::invalid_argument("granularity must be in 1..max period");
+    if (!(config.deadlineMin > 0) || config.deadlineMax < config.deadlineMin)
+        throw std::invalid_argument("deadline ratios must satisfy 0 < min <= max");
+    if (config.discard && !(config.utilization < n * config.maxTaskUtilization))
+        throw std::invalid_argument("utilization cannot be split below the per-task cap");
+    // Every task runs at least one tick per period
+    if ((double)n / config.periodMax > config.utilization * (1 + kTolerance))
+        throw std::invalid_argument("utilization / tasks is below 1 / max period; "
+                                    "raise --period-max or lower the task count");
+
+    std::mt19937_64 rng(config.seed);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    const double logMax = std::log((double)config.periodMax + 1);
+    std::uniform_real_distribution<double> ratio(config.deadlineMin, config.deadlineMax);
+
+    const double g = (double)config.granularity;
+    std::vector<TaskRecord> records(n);
+    double produced = 0;
+
+    for (int draw = 0; ; ++draw) {
+        if (draw == kMaxDraws)
+            throw std::runtime_error(config.discard
+                ? "UUniFast-Discard found no set within the per-task cap and tolerance"
+                : "no set rounded to within the utilization tolerance");
+
+        // UUniFast: peel u_i off the remaining sum, one task at a time
+        double rest  = config.utilization;
+        double carry = 0;   // Rounding error passed on to the next task
+        bool   valid = true;
+        produced = 0;
+        for (std::size_t i = 0; i < n && valid; ++i) {
+            double u;
+            if (i + 1 < n) {
+                double next = rest * std::pow(unit(rng), 1.0 / (double)(n - i - 1));
+                u    = rest - next;
+                rest = next;
+            } else {
+                u = rest;
+            }
+            if (config.discard && u > config.maxTaskUtilization) valid = false;
+
+            u += carry;
+
+            // No shorter period than fits one tick of u_i; the longest
+            // one when the carried error has used u_i up
+            double lo = u > 0 ? std::max((double)config.periodMin, std::ceil(1.0 / u / g) * g)
+                              : (double)config.periodMax;
+            lo = std::min(lo, (double)config.periodMax);
+            double logLo = std::log(lo);
+            double p = std::floor(std::exp(logLo + unit(rng) * (logMax - logLo)) / g) * g;
+            Tick period = (Tick)std::clamp(p, std::max(g, lo), (double)config.periodMax);
+            Tick wcet   = (Tick)std::clamp(std::llround(u * period), 1LL, (long long)kNever);
+            carry = u - (double)wcet / period;
+            Tick dl     = (Tick)std::clamp(std::llround(ratio(rng) * period),
+                                           (long long)wcet, (long long)kNever);
+
+            TaskRecord& r      = records[i];
+            r                  = TaskRecord{};
+            r.id               = (std::int32_t)(i + 1);
+            r.burstTime        = wcet;
+            r.period           = period;
+            r.relativeDeadline = dl;
+            produced          += (double)wcet / period;
+        }
+        if (valid && std::abs(produced - config.utilization) <=
+                     kTolerance * config.utilization)
+            break;
+    }
+
+    header = TaskSetHeader{};
+    std::memcpy(header.magic, kMagic, sizeof kMagic);
+    header.version           = kVersion;
+    header.recordSize        = sizeof(TaskRecord);
+    header.count             = n;
+    header.seed              = config.seed;
+    header.targetUtilization = config.utilization;
+    header.utilization       = produced;
+    return records;
+}
+
+void writeTaskSet(int fd, const TaskSetHeader& header,
+                  const std::vector<TaskRecord>& records) {
+    auto writeAll = [fd](const void* data, std::size_t n) {
+        const char* p = static_cast<const char*>(data);
+        while (n > 0) {
+            ssize_t w = ::write(fd, p, n);
+            if (w < 0 && errno == EINTR) continue;
+            if (w <= 0) throw std::runtime_error("task-set write failed");
+            p += w;
+            n -= (std::size_t)w;
+        }
+    };
+    writeAll(&header, sizeof header);
+    writeAll(records.data(), records.size() * sizeof(TaskRecord));
+}
+
+void writeTaskLines(std::ostream& os, const std::vector<TaskRecord>& records) {
+    os << "# id name arrival burst priority period deadline\n";
+    for (const TaskRecord& r : records) {
+        int deadline = r.period > 0 ? r.relativeDeadline : r.hardDeadline;
+        os << r.id << " T" << r.id << ' ' << r.arrivalTime << ' ' << r.burstTime << ' '
+           << r.priority << ' ' << r.period << ' ' << deadline << '\n';
+    }
+}
@@ -0,0 +1,93 @@
+#include "TaskTable.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace {
+
+double* allocColumn(std::size_t n) {
+    return static_cast<double*>(::operator new[](n * sizeof(double), std::align_val_t(32)));
+}
+
+} // namespace
+
+TaskTable::TaskTable(const std::vector<Task>& tasks) {
+    reserve(tasks.size());
+    for (const Task& t : tasks) push_back(t);
+}
+
+TaskTable::TaskTable(TaskTable&& other) noexcept {
+    *this = std::move(other);
+}
+
+TaskTable& TaskTable::operator=(TaskTable&& other) noexcept {
+    C_        = std::move(other.C_);
+    T_        = std::move(other.T_);
+    D_        = std::move(other.D_);
+    invT_     = std::move(other.invT_);
+    capacity_ = std::exchange(other.capacity_, 0);
+    ids_      = std::move(other.ids_);
+    other.ids_.clear();
+    return *this;
+}
+
+void TaskTable::reserve(std::size_t n) {
+    n = (n + kLanes - 1) / kLanes * kLanes;
+    if (n > capacity_) grow(n);
+}
+
+void TaskTable::grow(std::size_t capacity) {
+    Column C(allocColumn(capacity)), T(allocColumn(capacity)),
+           D(allocColumn(capacity)), invT(allocColumn(capacity));
+    const std::size_t n = size();
+    std::copy_n(C_.get(), n, C.get());
+    std::copy_n(T_.get(), n, T.get());
+    std::copy_n(D_.get(), n, D.get());
+    std::copy_n(invT_.get(), n, invT.get());
+    C_    = std::move(C);
+    T_    = std::move(T);
+    D_    = std::move(D);
+    invT_ = std::move(invT);
+    capacity_ = capacity;
+    for (std::size_t i = n; i < capacity_; ++i) setPadding(i);
+}
+
+void TaskTable::setPadding(std::size_t i) {
+    C_[i]    = 0;
+    T_[i]    = 1;
+    D_[i]    = 0;
+    invT_[i] = 1;
+}
+
+void TaskTable::push_back(const Task& t) {
+    if (t.period <= 0)
+        throw std::invalid_argument("task " + std::to_string(t.id) + " needs a period > 0");
+    if (size() == capacity_) grow(std::max<std::size_t>(kLanes, capacity_ * 2));
+
+    const std::size_t i = size();
+    C_[i]    = t.burstTime;
+    T_[i]    = t.period;
+    D_[i]    = t.relativeDeadline > 0 ? t.relativeDeadline : t.period;
+    invT_[i] = 1.0 / t.period;
+    ids_.push_back(t.id);
+}
+
+void TaskTable::pop_back() {
+    ids_.pop_back();
+    setPadding(size());
+}
+
+double TaskTable::utilization() const {
+    double u = 0;
+    for (std::size_t i = 0; i < size(); ++i) u += C_[i] * invT_[i];
+    return u;
+}
+
+double TaskTable::minDeadline() const {
+    return empty() ? 0 : *std::min_element(D_.get(), D_.get() + size());
+}
+
+double TaskTable::maxDeadline() const {
+    return empty() ? 0 : *std::max_element(D_.get(), D_.get() + size());
+}
@@ -0,0 +1,112 @@
+#include "ThreadPool.h"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+constexpr std::uint64_t pack(std::uint64_t begin, std::uint64_t end) {
+    return begin | end << 32;
+}
+constexpr std::uint32_t beginOf(std::uint64_t v) { return (std::uint32_t)v; }
+constexpr std::uint32_t endOf(std::uint64_t v)   { return (std::uint32_t)(v >> 32); }
+
+} // namespace
+
+WorkStealingPool::WorkStealingPool(unsigned threads) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    ranges_ = std::make_unique<Range[]>(threads);
+    threads_.reserve(threads);
+    for (unsigned id = 0; id < threads; ++id)
+        threads_.emplace_back([this, id] { workerLoop(id); });
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& t : threads_) t.join();
+}
+
+void WorkStealingPool::parallelFor(std::size_t n, const Body& body) {
+    if (n == 0) return;
+    if (n > std::numeric_limits<std::uint32_t>::max())
+        throw std::invalid_argument("parallelFor: too many indices");
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    const std::uint64_t workers = size();
+    for (std::uint64_t w = 0; w < workers; ++w)
+        ranges_[w].bounds.store(pack(n * w / workers, n * (w + 1) / workers),
+                                std::memory_order_relaxed);
+    body_   = &body;
+    active_ = size();
+    error_  = nullptr;
+    ++generation_;
+    wake_.notify_all();
+
+    done_.wait(lock, [this] { return active_ == 0; });
+    body_ = nullptr;
+    if (error_) std::rethrow_exception(std::exchange(error_, nullptr));
+}
+
+void WorkStealingPool::workerLoop(unsigned id) {
+    std::uint64_t seen = 0;
+    for (;;) {
+        const Body* body;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+            if (stop_) return;
+            seen = generation_;
+            body = body_;
+        }
+
+        std::size_t index;
+        while (next(id, index)) {
+            try {
+                (*body)(index, id);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex_);
+                if (!error_) error_ = std::current_exception();
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (--active_ == 0) done_.notify_one();
+    }
+}
+
+// Own range first, then steal the back half of someone else's.
+bool WorkStealingPool::next(unsigned id, std::size_t& index) {
+    auto& own = ranges_[id].bounds;
+    std::uint64_t v = own.load(std::memory_order_acquire);
+    while (beginOf(v) < endOf(v)) {
+        if (own.compare_exchange_weak(v, pack(beginOf(v) + 1, endOf(v)),
+                                      std::memory_order_acq_rel)) {
+            index = beginOf(v);
+            return true;
+        }
+    }
+
+    const unsigned workers = size();
+    for (unsigned k = 1; k < workers; ++k) {
+        auto& victim = ranges_[(id + k) % workers].bounds;
+        std::uint64_t w = victim.load(std::memory_order_acquire);
+        while (beginOf(w) < endOf(w)) {
+            std::uint32_t b = beginOf(w), e = endOf(w);
+            std::uint32_t mid = b + (e - b) / 2;
+            if (victim.compare_exchange_weak(w, pack(b, mid),
+                                             std::memory_order_acq_rel)) {
+                // [mid, e) is ours now; nobody steals from an empty range,
+                // so a plain store cannot race with a thief's CAS.
+                own.store(pack(mid + 1, e), std::memory_order_release);
+                index = mid;
+                return true;
+            }
+        }
+    }
+    return false;
+}
@@ -0,0 +1,105 @@
+#include "Timeline.h"
+#include "Algorithms/EDF.h"
+#include "Trace.h"
+#include <algorithm>
+#include <utility>
+
+Timeline::Timeline(const SchedulerConfig& config, std::vector<Task> tasks, Tick interval)
+    : config_(config) {
+    if (config.policy != Policy::EDF) {
+        summary_  = runScheduler(config, std::move(tasks));
+        tasks_    = summary_.tasks;
+        horizon_  = summary_.totalClockTime;
+        return;
+    }
+
+    int period = preparePeriodicTasks(tasks);
+    tasks_     = std::move(tasks);
+    horizon_   = config.horizon > 0 ? config.horizon : period;
+    if (interval <= 0) interval = std::max(1, horizon_ / 1024);
+
+    NullSink          quiet;
+    trace::ScopedSink scopedSink(quiet);
+    EDFScheduler edf(tasks_, horizon_);
+    edf.keepTrace(false);
+    edf.recordCheckpoints(interval, &checkpoints_);
+    if (config.steadyState) edf.enableSteadyState(period);
+    edf.run();
+
+    summary_.tasks           = tasks_;
+    summary_.totalClockTime  = horizon_;
+    summary_.totalBusyTime   = (int)edf.busyTime();
+    summary_.deadlineMisses  = edf.deadlineMisses();
+    summary_.contextSwitches = edf.contextSwitches();
+    summary_.jobs            = edf.jobStats();
+    summary_.steady          = edf.steadyState();
+    for (const JobStats& j : summary_.jobs) summary_.latency.merge(j.latency);
+}
+
+ScheduleResult Timeline::window(Tick from, Tick to) const {
+    from = std::clamp(from, 0, horizon_);
+    to   = std::clamp(to, from, horizon_);
+    return config_.policy == Policy::EDF ? edfWindow(from, to) : clippedWindow(from, to);
+}
+
+ScheduleResult Timeline::edfWindow(Tick from, Tick to) const {
+    // Past the first repeat, read the same stretch of the cycle
+    const SteadyState& steady = summary_.steady;
+    Tick shift = 0;
+    if (steady.cyclesSkipped > 0 && from >= steady.cycleStart + steady.cycleLength)
+        shift = (from - steady.cycleStart) / steady.cycleLength * steady.cycleLength;
+    const Tick a = from - shift;
+    const Tick b = to - shift;
+
+    auto after = std::upper_bound(checkpoints_.begin(), checkpoints_.end(), a,
+                                  [](Tick t, const Checkpoint& cp) { return t < cp.time; });
+    EDFScheduler edf(tasks_, b);
+    if (after != checkpoints_.begin()) edf.restore(*(after - 1));
+    {
+        NullSink          quiet;
+        trace::ScopedSink scopedSink(quiet);
+        edf.runUntil(a);
+    }
+    edf.clearCounters();
+    edf.runUntil(b);
+
+    ScheduleResult res;
+    res.tasks = tasks_;
+    labelTasks(res.gantt, res.tasks);
+    for (const Segment& s : edf.executionTrace())
+        res.gantt.append(s.task, s.start + shift, s.end + shift);
+    res.totalClockTime  = to - from;
+    res.totalBusyTime   = (int)edf.busyTime();
+    res.deadlineMisses  = edf.deadlineMisses();
+    res.contextSwitches = edf.contextSwitches();
+    res.jobs            = edf.jobStats();
+    for (const JobStats& j : res.jobs) res.latency.merge(j.latency);
+    return res;
+}
+
+ScheduleResult Timeline::clippedWindow(Tick from, Tick to) const {
+    ScheduleResult res;
+    res.tasks = tasks_;
+    labelTasks(res.gantt, res.tasks);
+
+    // Segments are in time order: find the first that ends after `from`
+    const SegmentTrace& all = summary_.gantt;
+    auto it = std::upper_bound(all.begin(), all.end(), from,
+                               [](Tick t, const Segment& s) { return t < s.end; });
+    for (; it != all.end() && it->start < to; ++it) {
+        Tick start = std::max(it->start, from);
+        Tick end   = std::min(it->end, to);
+        res.gantt.append(it->task, start, end);
+        if (it->task == kContextSwitchTask) ++res.contextSwitches;
+        else if (it->task >= 0)             res.totalBusyTime += end - start;
+    }
+    for (const Task& t : res.tasks) {
+        if (t.completionTime <= from || t.completionTime > to) continue;
+        if (t.deadlineMissed) ++res.deadlineMisses;
+        if (!t.completed) continue;
+        res.latency.complete(t.arrivalTime, t.burstTime, t.completionTime, t.hardDeadline);
+        res.latency.jitter.record(t.startTime - t.arrivalTime);
+    }
+    res.totalClockTime = to - from;
+    return res;
+}
@@ -0,0 +1,32 @@
+#include "Trace.h"
+#include <iostream>
+
+TraceSink& trace::defaultSink() {
+    static TextSink sink(std::cout, TraceLevel::Tick);
+    return sink;
+}
+
+static std::size_t roundUpPow2(std::size_t n) {
+    std::size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+BinaryRingSink::BinaryRingSink(std::size_t capacity, TraceLevel level)
+    : TraceSink(level),
+      ring_(roundUpPow2(capacity ? capacity : 1)),
+      mask_(ring_.size() - 1) {}
+
+std::size_t BinaryRingSink::size() const {
+    return head_ < ring_.size() ? (std::size_t)head_ : ring_.size();
+}
+
+std::uint64_t BinaryRingSink::dropped() const {
+    return head_ - size();
+}
+
+void BinaryRingSink::writeTo(std::ostream& os) const {
+    forEach([&](const TraceRecord& r) {
+        os.write(reinterpret_cast<const char*>(&r), sizeof r);
+    });
+}
@@ -0,0 +1,375 @@
+#include "JsonExporter.h"
+#include "Scheduler.h"
+#include "Trace.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <new>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// ── Scheduler benchmark ───────────────────────────────────────
+//
+//   scheduler_bench [--tasks N,N,...] [--ticks N,N,...]
+//                   [--policies P,P,...|all] [--repeat R] [--seed S]
+//                   [--no-fork] [--full]
+//
+// Times every policy on synthetic workloads for each (tasks, ticks)
+// pair and writes one JSON document to stdout.  The default grid is
+// 10..10^5 tasks by 10^3..10^7 ticks; --full extends it to 10^6 tasks
+// and 10^8 ticks (slow: meant for an idle machine), and --tasks /
+// --ticks replace either axis outright:
+//
+//   { "traceLevel": 3, "repeat": 3, "seed": 1,
+//     "cases": [ { "policy": "edf", "tasks": 1000, "ticks": 100000,
+//                  "events": ..., "dispatches": ..., "traceRecords": ...,
+//                  "nanoseconds": ..., "eventsPerSecond": ...,
+//                  "nsPerDispatch": ..., "peakRssKiB": ...,
+//                  "allocations": ..., "allocationsPerEvent": ... },
+//                ... ] }
+//
+// Workloads are seeded, so a run is comparable across commits:
+//
+//   edf      periodic tasks at 90% utilization with log-uniform
+//            periods, simulated for `ticks`
+//   others   one job per task, arrivals spread over `ticks` and
+//            about 90% of them busy; rr's quantum is a quarter of
+//            the mean burst so the trace stays proportional to work
+//
+// `nanoseconds` is the best of `repeat` timed runs with tracing off.
+// Events are the segments of the schedule (dispatches, idle gaps and
+// context switches), so every policy is measured in the same unit;
+// dispatches are the task segments alone.  traceRecords counts what
+// one extra, untimed run emits at Event level (0 for policies without
+// trace points, or when RTOS_TRACE_LEVEL compiles them out).
+// Allocations count operator new calls in a timed run, input copy
+// excluded.  Every case runs in a forked child so peakRssKiB is that
+// case's own high-water mark; --no-fork runs in-process and reports
+// the process peak so far.
+//
+// `cmake --build <dir> --target bench` writes <dir>/bench.json with
+// the defaults.
+
+// ── Allocation counter ────────────────────────────────────────
+namespace {
+
+std::atomic<std::uint64_t> gAllocations{0};
+
+void* countedAlloc(std::size_t n) {
+    gAllocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+
+void* countedAlignedAlloc(std::size_t n, std::align_val_t align) {
+    gAllocations.fetch_add(1, std::memory_order_relaxed);
+    void* p = nullptr;
+    if (posix_memalign(&p, std::max<std::size_t>((std::size_t)align, sizeof(void*)), n ? n : 1) == 0)
+        return p;
+    throw std::bad_alloc();
+}
+
+} // namespace
+
+void* operator new(std::size_t n)                          { return countedAlloc(n); }
+void* operator new[](std::size_t n)                        { return countedAlloc(n); }
+void* operator new(std::size_t n, std::align_val_t a)      { return countedAlignedAlloc(n, a); }
+void* operator new[](std::size_t n, std::align_val_t a)    { return countedAlignedAlloc(n, a); }
+void  operator delete(void* p) noexcept                    { std::free(p); }
+void  operator delete[](void* p) noexcept                  { std::free(p); }
+void  operator delete(void* p, std::size_t) noexcept       { std::free(p); }
+void  operator delete[](void* p, std::size_t) noexcept     { std::free(p); }
+void  operator delete(void* p, std::align_val_t) noexcept  { std::free(p); }
+void  operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void  operator delete(void* p, std::size_t, std::align_val_t) noexcept   { std::free(p); }
+void  operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+namespace {
+
+const char* kUsage =
+    "usage: scheduler_bench [--tasks N,N,...] [--ticks N,N,...]\n"
+    "                       [--policies P,P,...|all] [--repeat R] [--seed S]\n"
+    "                       [--no-fork] [--full]\n";
+
+// ── Workloads ─────────────────────────────────────────────────
+constexpr double kLoad = 0.9;
+
+std::vector<Task> aperiodicWorkload(int n, int ticks, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    const double mean = std::max(1.0, kLoad * ticks / n);
+    std::uniform_int_distribution<int> arrival(0, std::max(0, ticks - 1));
+    std::uniform_int_distribution<int> burst(1, std::max(1, (int)(2 * mean) - 1));
+    std::uniform_int_distribution<int> priority(0, 255);
+    std::uniform_int_distribution<int> rate(1, 1000000);
+
+    std::vector<Task> tasks(n);
+    for (int i = 0; i < n; ++i) {
+        Task& t        = tasks[i];
+        t.id           = i + 1;
+        t.name         = 'T';
+        t.name        += std::to_string(i + 1);
+        t.arrivalTime  = arrival(rng);
+        t.burstTime    = burst(rng);
+        t.priority     = priority(rng);
+        t.period       = rate(rng);   // RM priority
+        t.hardDeadline = t.arrivalTime + 4 * t.burstTime;
+    }
+    return tasks;
+}
+
+// Equal shares of kLoad; the shortest period keeps every WCET >= 1.
+std::vector<Task> periodicWorkload(int n, int ticks, std::uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    const double share = kLoad / n;
+    const double tMin  = std::max(10.0, std::ceil(1.0 / share));
+    const double tMax  = std::max(tMin * 10, (double)ticks);
+    std::uniform_real_distribution<double> logPeriod(std::log(tMin), std::log(tMax));
+
+    std::vector<Task> tasks(n);
+    for (int i = 0; i < n; ++i) {
+        Task& t   = tasks[i];
+        t.id      = i + 1;
+        t.name    = 'T';
+        t.name   += std::to_string(i + 1);
+        t.period  = (int)std::min(std::exp(logPeriod(rng)), 2e9);
+        t.burstTime        = std::max(1, (int)(share * t.period));
+        t.relativeDeadline = t.period;
+    }
+    return tasks;
+}
+
+// ── Measurement ───────────────────────────────────────────────
+class CountingSink : public TraceSink {
+public:
+    CountingSink() : TraceSink(TraceLevel::Event) {}
+    void record(const TraceRecord&) override { ++count; }
+
+    std::uint64_t count = 0;
+};
+
+struct CaseResult {
+    bool          ok          = false;
+    std::uint64_t events      = 0;
+    std::uint64_t dispatches  = 0;
+    std::uint64_t records     = 0;
+    std::uint64_t allocations = 0;
+    double        seconds     = 0;
+    long          peakRssKiB  = 0;
+    char          error[128]  = {};
+};
+
+struct Case {
+    Policy policy;
+    int    tasks;
+    int    ticks;
+};
+
+CaseResult runCase(const Case& c, int repeat, std::uint64_t seed) {
+    CaseResult out;
+    try {
+        SchedulerConfig config;
+        config.policy = c.policy;
+        std::vector<Task> tasks = c.policy == Policy::EDF
+                                  ? periodicWorkload(c.tasks, c.ticks, seed)
+                                  : aperiodicWorkload(c.tasks, c.ticks, seed);
+        if (c.policy == Policy::EDF) config.horizon = c.ticks;
+        if (c.policy == Policy::RoundRobin || c.policy == Policy::Multilevel)
+            config.quantum = std::max(2, (int)(kLoad * c.ticks / c.tasks / 4));
+
+        {
+            CountingSink      counter;
+            trace::ScopedSink scoped(counter);
+            ScheduleResult    res = runScheduler(config, tasks);
+            out.records = counter.count;
+            out.events  = res.gantt.size();
+            for (const Segment& s : res.gantt)
+                if (s.task != kIdleTask && s.task != kContextSwitchTask) ++out.dispatches;
+        }
+
+        NullSink          quiet;
+        trace::ScopedSink scoped(quiet);
+        out.seconds = 1e300;
+        for (int r = 0; r < repeat; ++r) {
+            std::vector<Task> input = tasks;
+            const std::uint64_t before = gAllocations.load(std::memory_order_relaxed);
+            const auto start = std::chrono::steady_clock::now();
+            ScheduleResult res = runScheduler(config, std::move(input));
+            const auto stop  = std::chrono::steady_clock::now();
+            out.allocations = gAllocations.load(std::memory_order_relaxed) - before;
+            out.seconds = std::min(out.seconds,
+                                   std::chrono::duration<double>(stop - start).count());
+        }
+        out.ok = true;
+    } catch (const std::exception& e) {
+        std::snprintf(out.error, sizeof out.error, "%s", e.what());
+    }
+    struct rusage ru;
+    getrusage(RUSAGE_SELF, &ru);
+    out.peakRssKiB = ru.ru_maxrss;
+    return out;
+}
+
+// The child sends its CaseResult back through a pipe; the parent
+// takes the peak RSS from wait4() so it covers this case alone.
+CaseResult runForked(const Case& c, int repeat, std::uint64_t seed) {
+    int fds[2];
+    if (pipe(fds) != 0) throw std::runtime_error("pipe failed");
+    std::cout.flush();
+    pid_t pid = fork();
+    if (pid < 0) throw std::runtime_error("fork failed");
+    if (pid == 0) {
+        close(fds[0]);
+        CaseResult res = runCase(c, repeat, seed);
+        ssize_t ignored = ::write(fds[1], &res, sizeof res);
+        (void)ignored;
+        _exit(0);
+    }
+    close(fds[1]);
+    CaseResult res;
+    ssize_t got = ::read(fds[0], &res, sizeof res);
+    close(fds[0]);
+
+    int status = 0;
+    struct rusage ru;
+    wait4(pid, &status, 0, &ru);
+    if (got != (ssize_t)sizeof res) {
+        res = CaseResult{};
+        std::snprintf(res.error, sizeof res.error, "benchmark child died (status %d)", status);
+    }
+    res.peakRssKiB = ru.ru_maxrss;
+    return res;
+}
+
+// ── Command line ──────────────────────────────────────────────
+std::vector<long long> parseList(const std::string& s) {
+    std::vector<long long> out;
+    std::stringstream in(s);
+    for (std::string item; std::getline(in, item, ','); ) {
+        std::size_t used = 0;
+        double v = std::stod(item, &used);   // Accepts 1e6
+        if (used != item.size() || v < 1 || v > 2e9)
+            throw std::invalid_argument("bad size '" + item + "'");
+        out.push_back((long long)v);
+    }
+    return out;
+}
+
+std::vector<Policy> parsePolicies(const std::string& s) {
+    std::vector<Policy> out;
+    if (s == "all") {
+        for (Policy p : {Policy::FCFS, Policy::RoundRobin, Policy::SJF, Policy::SRTF,
+                         Policy::Priority, Policy::PreemptivePriority, Policy::Multilevel,
+                         Policy::RateMonotonic, Policy::EDF})
+            out.push_back(p);
+        return out;
+    }
+    std::stringstream in(s);
+    for (std::string name; std::getline(in, name, ','); ) {
+        Policy p;
+        if (!parsePolicy(name, p)) throw std::invalid_argument("unknown policy '" + name + "'");
+        out.push_back(p);
+    }
+    return out;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<long long> taskSizes = {10, 1000, 100000};
+    std::vector<long long> tickSizes = {1000, 100000, 10000000};
+    std::vector<long long> fullTasks = {10, 1000, 100000, 1000000};
+    std::vector<long long> fullTicks = {1000, 100000, 10000000, 100000000};
+    std::vector<Policy>    policies  = {Policy::FCFS, Policy::RoundRobin, Policy::SJF,
+                                        Policy::Priority, Policy::RateMonotonic, Policy::EDF};
+    int           repeat = 3;
+    std::uint64_t seed   = 1;
+    bool          forked = true;
+    bool          full   = false, tasksGiven = false, ticksGiven = false;
+
+    try {
+        std::vector<std::string> args(argv + 1, argv + argc);
+        for (std::size_t i = 0; i < args.size(); ++i) {
+            const bool hasValue = i + 1 < args.size();
+            if (args[i] == "--tasks" && hasValue) {
+                taskSizes  = parseList(args[++i]);
+                tasksGiven = true;
+            } else if (args[i] == "--ticks" && hasValue) {
+                tickSizes  = parseList(args[++i]);
+                ticksGiven = true;
+            }
+            else if (args[i] == "--policies" && hasValue) policies  = parsePolicies(args[++i]);
+            else if (args[i] == "--repeat" && hasValue)   repeat    = std::max(1, std::stoi(args[++i]));
+            else if (args[i] == "--seed" && hasValue)     seed      = std::stoull(args[++i]);
+            else if (args[i] == "--no-fork")              forked    = false;
+            else if (args[i] == "--full")                 full      = true;
+            else throw std::invalid_argument("unknown option '" + args[i] + "'");
+        }
+        if (full && !tasksGiven) taskSizes = fullTasks;
+        if (full && !ticksGiven) tickSizes = fullTicks;
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n" << kUsage;
+        return 2;
+    }
+
+    try {
+        BufferedWriter out(STDOUT_FILENO);
+        JsonWriter     json(out);
+        json.beginObject();
+        json.key("traceLevel"); json.value(RTOS_TRACE_LEVEL);
+        json.key("repeat");     json.value(repeat);
+        json.key("seed");       json.value((long long)seed);
+        json.key("cases");
+        json.beginArray();
+        for (long long n : taskSizes) {
+            for (long long ticks : tickSizes) {
+                for (Policy p : policies) {
+                    const Case c{p, (int)n, (int)ticks};
+                    out.flush();
+                    CaseResult r = forked ? runForked(c, repeat, seed) : runCase(c, repeat, seed);
+
+                    json.beginObject();
+                    json.key("policy"); json.value(policyName(p));
+                    json.key("tasks");  json.value(n);
+                    json.key("ticks");  json.value(ticks);
+                    if (!r.ok) {
+                        json.key("error"); json.value(r.error);
+                        json.endObject();
+                        continue;
+                    }
+                    json.key("events");     json.value((long long)r.events);
+                    json.key("dispatches"); json.value((long long)r.dispatches);
+                    json.key("traceRecords"); json.value((long long)r.records);
+                    json.key("nanoseconds"); json.value((long long)(r.seconds * 1e9));
+                    json.key("eventsPerSecond");
+                    json.value(r.seconds > 0 ? r.events / r.seconds : 0.0);
+                    json.key("nsPerDispatch");
+                    json.value(r.dispatches ? r.seconds * 1e9 / r.dispatches : 0.0);
+                    json.key("peakRssKiB");  json.value((long long)r.peakRssKiB);
+                    json.key("allocations"); json.value((long long)r.allocations);
+                    json.key("allocationsPerEvent");
+                    json.value(r.events ? (double)r.allocations / r.events : 0.0);
+                    json.endObject();
+                }
+            }
+        }
+        json.endArray();
+        json.endObject();
+        out.put('\n');
+        out.flush();
+    } catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,723 @@
+#include "Analysis.h"
+#include "Batch.h"
+#include "DemandBound.h"
+#include "Incremental.h"
+#include "JsonExporter.h"
+#include "Multicore.h"
+#include "Options.h"
+#include "RealTime.h"
+#include "ResourceManager.h"
+#include "Scheduler.h"
+#include "TaskBody.h"
+#include "TaskSet.h"
+#include "Timeline.h"
+#include "Trace.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+// ── Command line ──────────────────────────────────────────────
+//
+//   scheduler <policy> [options] < tasks.txt
+//   scheduler --serve
+//   scheduler --batch FILE [--threads N]
+//   scheduler --analyze rm|dm|fp [--quick] [--simulate] < tasks.txt
+//   scheduler --analyze edf [--exhaustive] [--simulate] < tasks.txt
+//   scheduler --multicore gedf|gfp|pedf|prm [--cores M] [--packing ffd|wfd]
+//             [--order rm|dm|fp] [--horizon N] [--trace LEVEL] [--no-gantt]
+//             < tasks.txt
+//   scheduler --resources none|pip|ipcp [--order rm|dm|fp] [--horizon N]
+//             [--trace LEVEL] [--no-gantt] < tasks.txt
+//   scheduler --bodies none|pip|ipcp [--order rm|dm|fp] [--horizon N]
+//             [--trace LEVEL] [--no-gantt] < tasks.txt
+//   scheduler --real fifo|deadline|other [--order rm|dm|fp] [--horizon N]
+//             [--tick-us N] [--cpu N] [--no-gantt] [--format text|json]
+//             < tasks.txt
+//   scheduler --generate N [--utilization U] [--period-min N] [--period-max N]
+//             [--granularity N] [--deadline-min R] [--deadline-max R]
+//             [--discard] [--cap U] [--seed S] [--text] > tasks.rtts
+//
+//   policy   fcfs | rr | sjf | srtf | priority | priority-preemptive
+//            | mlq | rm | edf
+//
+//   --quantum N     RR / mlq time slice              (default 2)
+//   --cs N          FCFS / RR context-switch penalty (default 1)
+//   --aging N       mlq aging interval, 0 = off
+//   --feedback      mlq multilevel feedback
+//   --horizon N     EDF simulated ticks, 0 = hyperperiod
+//   --exact         EDF: simulate every hyperperiod, even once the
+//                   schedule repeats (see Algorithms/EDF.h)
+//   --trace LEVEL   off | summary | event | tick     (default tick)
+//   --no-gantt      skip the Gantt chart
+//   --format F      text | json | binary             (default text)
+//   --window A:B    report ticks [A, B) only (Timeline.h)
+//   --checkpoint N  checkpoint interval for --window (default horizon/1024)
+//   --profile       report phase times and event / CPU counters for the
+//                   run (Instrument.h)
+//
+// json and binary are described in JsonExporter.h; with either, trace
+// text goes to stderr so stdout stays machine-readable.
+//
+// Task lines are described in Options.h, batch files in Batch.h and
+// the analyses in Analysis.h (fixed priority) and DemandBound.h
+// (EDF).  --quick stops at the first verdict; --exhaustive checks
+// every deadline instead of running QPA; --simulate confirms the
+// verdict with a simulation.  The multicore policies are described
+// in Multicore.h; --order picks the fixed priorities for gfp and prm.
+// The lock protocols and `cs` lines are described in ResourceManager.h,
+// `body` lines (coroutine job bodies) in TaskBody.h.
+//
+// --real runs the task set on Linux threads for --horizon ticks of
+// --tick-us microseconds (default 1000), pinned to --cpu (default 0,
+// -1 = not pinned), and reports what was observed next to what the
+// simulators predict (RealTime.h).  --format json writes the
+// observed run in the JsonExporter.h layout.
+//
+// --generate writes a periodic task set in the binary format of
+// TaskSet.h (or as task lines with --text).  Every mode that reads
+// tasks from stdin maps such a file instead of parsing it:
+//
+//   scheduler --generate 100000 --utilization 0.9 --period-min 1000 --period-max 10000000 > big.rtts
+//   scheduler edf --horizon 100000 --no-gantt < big.rtts
+
+namespace {
+
+const char* kUsage =
+    "usage: scheduler <fcfs|rr|sjf|srtf|priority|priority-preemptive|mlq|rm|edf>\n"
+    "                 [--quantum N] [--cs N] [--aging N] [--feedback]\n"
+    "                 [--horizon N] [--exact] [--trace off|summary|event|tick] [--no-gantt]\n"
+    "                 [--format text|json|binary] [--window A:B [--checkpoint N]]\n"
+    "                 [--profile] < tasks\n"
+    "       scheduler --serve\n"
+    "       scheduler --batch FILE [--threads N]\n"
+    "       scheduler --analyze rm|dm|fp [--quick] [--simulate] < tasks\n"
+    "       scheduler --analyze edf [--exhaustive] [--simulate] < tasks\n"
+    "       scheduler --multicore gedf|gfp|pedf|prm [--cores M] [--packing ffd|wfd]\n"
+    "                 [--order rm|dm|fp] [--horizon N] [--trace LEVEL] [--no-gantt]\n"
+    "                 < tasks\n"
+    "       scheduler --resources none|pip|ipcp [--order rm|dm|fp] [--horizon N]\n"
+    "                 [--trace LEVEL] [--no-gantt] < tasks\n"
+    "       scheduler --bodies none|pip|ipcp [--order rm|dm|fp] [--horizon N]\n"
+    "                 [--trace LEVEL] [--no-gantt] < tasks\n"
+    "       scheduler --real fifo|deadline|other [--order rm|dm|fp] [--horizon N]\n"
+    "                 [--tick-us N] [--cpu N] [--no-gantt] [--format text|json] < tasks\n"
+    "       scheduler --generate N [--utilization U] [--period-min N] [--period-max N]\n"
+    "                 [--granularity N] [--deadline-min R] [--deadline-max R]\n"
+    "                 [--discard] [--cap U] [--seed S] [--text] > tasks\n";
+
+// Tasks on stdin: a task-set file (TaskSet.h) is mapped, anything
+// else is parsed as task lines.
+void readInput(std::vector<Task>& tasks) {
+    MappedTaskSet set;
+    if (set.map(STDIN_FILENO)) set.appendTo(tasks);
+    else                       readTasks(std::cin, tasks);
+}
+
+// What `--serve` keeps from one request to the next: the Timeline
+// of the last --window request and the last run, so that editing
+// one task re-simulates only what the edit changes.
+struct Session {
+    std::unique_ptr<Timeline> timeline;
+    std::string               timelineKey;   // timelineKey() of `timeline`
+    IncrementalScheduler      runs;
+};
+
+// Text reports go to `text`; json / binary go through `data`.  A
+// one-shot run has no `session`.
+void runOnce(const RunOptions& opts, std::vector<Task> tasks,
+             std::ostream& text, BufferedWriter& data, Session* session) {
+    const bool isText = opts.format == OutputFormat::Text;
+    TextSink traceSink(isText ? text : std::cerr, opts.traceLevel);
+    trace::ScopedSink scopedSink(traceSink);
+
+    // Covers the run only, not the report
+    std::optional<RunProfiler> profiler;
+    if (opts.profile) profiler.emplace();
+
+    ScheduleResult        owned;
+    const ScheduleResult* result = &owned;
+    if (opts.windowTo > 0) {
+        std::unique_ptr<Timeline>  local;
+        std::unique_ptr<Timeline>& timeline = session ? session->timeline : local;
+        if (!timeline)
+            timeline = std::make_unique<Timeline>(opts.config, std::move(tasks), opts.checkpoint);
+        owned = timeline->window(opts.windowFrom, opts.windowTo);
+    } else if (session) {
+        result = &session->runs.run(opts.config, std::move(tasks));
+    } else {
+        owned = runScheduler(opts.config, std::move(tasks));
+    }
+    const RunProfile* profile = profiler ? &profiler->finish() : nullptr;
+    const char*    title  = policyName(opts.config.policy);
+    switch (opts.format) {
+    case OutputFormat::Text:
+        if (opts.gantt) printGantt(*result, title, text);
+        printMetrics(*result, title, text);
+        if (profile) printProfile(*profile, title, text);
+        break;
+    case OutputFormat::Json:
+        exportJson(*result, title, data, profile);
+        break;
+    case OutputFormat::Binary:
+        exportGanttBinary(*result, data);
+        break;
+    }
+    data.flush();
+}
+
+// ── Worker mode ───────────────────────────────────────────────
+//
+// `scheduler --serve` stays up and answers requests on stdin/stdout
+// so callers do not pay process start-up per simulation.  Every
+// frame is a little-endian uint32 payload length followed by the
+// payload:
+//
+//   request   "<policy> [options]\n" followed by task lines
+//   response  "ok\n" + report, or "error\n" + message
+//
+// The request and response buffers live for the whole process and
+// are only cleared between requests, so a warm worker does not regrow
+// them.  Each request's task list is handed over to the run, since
+// the Session keeps it to diff against.  The Session lives on too:
+// further windows of the same options and tasks only replay from a
+// checkpoint, and a request that edits one task of the previous one
+// only re-simulates from where that task first matters
+// (Incremental.h).
+
+constexpr std::uint32_t kMaxFrame = 256u << 20;
+
+// std::streambuf that appends to a caller-owned string.
+class AppendBuf : public std::streambuf {
+public:
+    explicit AppendBuf(std::string& s) : s_(s) {}
+
+protected:
+    int_type overflow(int_type c) override {
+        if (!traits_type::eq_int_type(c, traits_type::eof()))
+            s_.push_back(traits_type::to_char_type(c));
+        return c;
+    }
+    std::streamsize xsputn(const char* p, std::streamsize n) override {
+        s_.append(p, (std::size_t)n);
+        return n;
+    }
+
+private:
+    std::string& s_;
+};
+
+bool readExact(void* dst, std::size_t n) {
+    return std::fread(dst, 1, n, stdin) == n;
+}
+
+// false on clean EOF; throws on a truncated or oversized frame.
+bool readFrame(std::string& payload) {
+    unsigned char header[4];
+    if (std::fread(header, 1, 1, stdin) != 1) return false;
+    if (!readExact(header + 1, 3))
+        throw std::runtime_error("truncated frame header");
+
+    std::uint32_t len = (std::uint32_t)header[0]       | (std::uint32_t)header[1] << 8 |
+                        (std::uint32_t)header[2] << 16 | (std::uint32_t)header[3] << 24;
+    if (len > kMaxFrame)
+        throw std::runtime_error("frame too large");
+
+    payload.resize(len);
+    if (len && !readExact(&payload[0], len))
+        throw std::runtime_error("truncated frame");
+    return true;
+}
+
+// Everything a Timeline depends on: the simulation options and the
+// task lines that follow the header.
+std::string timelineKey(const RunOptions& opts, const std::string& request, std::size_t body) {
+    const SchedulerConfig& c = opts.config;
+    std::string key = std::string(policyName(c.policy)) + ' ' + std::to_string(c.quantum) +
+                      ' ' + std::to_string(c.csPenalty) + ' ' + std::to_string(c.agingInterval) +
+                      ' ' + std::to_string(c.feedback) + ' ' + std::to_string(c.horizon) +
+                      ' ' + std::to_string(c.steadyState) + ' ' + std::to_string(opts.checkpoint) +
+                      '\n';
+    key.append(request, std::min(body, request.size()), std::string::npos);
+    return key;
+}
+
+void writeFrame(const std::string& payload) {
+    std::uint32_t len = (std::uint32_t)payload.size();
+    unsigned char header[4] = {
+        (unsigned char)len,         (unsigned char)(len >> 8),
+        (unsigned char)(len >> 16), (unsigned char)(len >> 24),
+    };
+    std::fwrite(header, 1, 4, stdout);
+    std::fwrite(payload.data(), 1, payload.size(), stdout);
+    std::fflush(stdout);
+}
+
+int serve() {
+    std::string       request;
+    std::string       response;
+    std::vector<std::string> args;
+    Session           session;
+
+    try {
+        while (readFrame(request)) {
+            response.clear();
+            args.clear();
+            try {
+                std::istringstream in(request);
+                std::string header;
+                std::getline(in, header);
+                std::istringstream words(header);
+                for (std::string w; words >> w; ) args.push_back(w);
+
+                RunOptions opts = parseArgs(args);
+                std::vector<Task> tasks;
+                if (opts.windowTo > 0) {
+                    std::string key = timelineKey(opts, request, header.size() + 1);
+                    if (key != session.timelineKey) {
+                        session.timeline.reset();
+                        session.timelineKey = std::move(key);
+                    }
+                }
+                if (!(opts.windowTo > 0 && session.timeline)) readTasks(in, tasks);
+
+                response += "ok\n";
+                AppendBuf      buf(response);
+                std::ostream   out(&buf);
+                BufferedWriter data(response);
+                runOnce(opts, std::move(tasks), out, data, &session);
+            } catch (const std::exception& e) {
+                response = "error\n";
+                response += e.what();
+            }
+            writeFrame(response);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "scheduler --serve: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+// ── Batch mode ────────────────────────────────────────────────
+int batch(const std::vector<std::string>& args) {
+    std::string path;
+    unsigned    threads = 0;
+    try {
+        for (std::size_t i = 1; i < args.size(); ++i) {
+            if (args[i] == "--threads" && i + 1 < args.size())
+                threads = (unsigned)std::stoul(args[++i]);
+            else if (path.empty() && args[i].compare(0, 2, "--") != 0)
+                path = args[i];
+            else
+                throw std::invalid_argument("unexpected argument '" + args[i] + "'");
+        }
+        if (path.empty()) throw std::invalid_argument("--batch needs a file");
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n" << kUsage;
+        return 2;
+    }
+
+    try {
+        std::ifstream file(path);
+        if (!file) throw std::runtime_error("cannot open '" + path + "'");
+        auto slash = path.find_last_of('/');
+        BatchPlan   plan   = parseBatch(file, slash == std::string::npos
+                                                  ? "" : path.substr(0, slash));
+        BatchReport report = runBatch(plan, threads);
+        printBatchReport(plan, report, std::cout);
+    } catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+// ── Analysis mode ─────────────────────────────────────────────
+int analyzeEDFMode(bool exhaustive, bool simulate) {
+    std::vector<Task> tasks;
+    readInput(tasks);
+    TaskTable    table(tasks);
+    DemandReport report = exhaustive ? analyzeEDFExhaustive(table) : analyzeEDF(table);
+    printDemandReport(report, std::cout);
+    if (!simulate) return 0;
+
+    // With U > 1 the backlog grows every hyperperiod, and EDF may not
+    // miss until long after any horizon we could simulate
+    if (report.utilization > 1.0 + 1e-12) {
+        std::cout << "  Simulation      : skipped (U > 1; a finite run is not conclusive)\n";
+        return 0;
+    }
+
+    // Synchronous release is the worst case for EDF too, so with
+    // U <= 1 one hyperperiod (plus the longest deadline) shows any miss.
+    std::int64_t h;
+    Tick dmax = (Tick)table.maxDeadline();
+    if (!hyperperiod(tasks, h) || h > kNever - dmax)
+        throw std::runtime_error("hyperperiod too long to simulate");
+
+    SchedulerConfig config;
+    config.policy  = Policy::EDF;
+    config.horizon = (int)h + dmax;
+    NullSink          quiet;
+    trace::ScopedSink scopedSink(quiet);
+    ScheduleResult    result = runScheduler(config, std::move(tasks));
+    std::cout << "  Simulation      : " << result.deadlineMisses << " deadline misses in "
+              << config.horizon << " ticks\n";
+    return 0;
+}
+
+int analyze(const std::vector<std::string>& args) {
+    PriorityOrder order = PriorityOrder::RateMonotonic;
+    const bool edf = args.size() >= 2 && args[1] == "edf";
+    bool quick = false, exhaustive = false, simulate = false;
+    if (args.size() < 2 || (!edf && !parsePriorityOrder(args[1], order))) {
+        std::cerr << "--analyze needs rm, dm, fp or edf\n" << kUsage;
+        return 2;
+    }
+    for (std::size_t i = 2; i < args.size(); ++i) {
+        if      (args[i] == "--quick" && !edf)     quick      = true;
+        else if (args[i] == "--exhaustive" && edf) exhaustive = true;
+        else if (args[i] == "--simulate")          simulate   = true;
+        else {
+            std::cerr << "unknown option '" << args[i] << "'\n" << kUsage;
+            return 2;
+        }
+    }
+
+    try {
+        if (edf) return analyzeEDFMode(exhaustive, simulate);
+
+        std::vector<Task> tasks;
+        readInput(tasks);
+        SchedulabilityReport report = analyzeFixedPriority(tasks, order, !quick);
+        if (!simulate) {
+            printAnalysis(report, std::cout);
+            return 0;
+        }
+        // Every response falls inside the first busy period, which is
+        // never longer than the hyperperiod when U <= 1.
+        std::int64_t limit = report.hyperperiodFits ? report.hyperperiod
+                                                    : std::int64_t(1) << 40;
+        std::vector<std::int64_t> observed = simulateFixedPriority(tasks, order, limit);
+        printAnalysis(report, std::cout, &observed);
+    } catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+// ── Multicore mode ────────────────────────────────────────────
+int multicore(const std::vector<std::string>& args) {
+    MulticoreConfig config;
+    TraceLevel      level = TraceLevel::Summary;
+    bool            gantt = true;
+    try {
+        if (args.size() < 2 || !parseMulticorePolicy(args[1], config.policy))
+            throw std::invalid_argument("--multicore needs gedf, gfp, pedf or prm");
+        for (std::size_t i = 2; i < args.size(); ++i) {
+            const std::string& a = args[i];
+            const bool hasValue  = i + 1 < args.size();
+            if (a == "--cores" && hasValue)
+                config.cores = std::stoi(args[++i]);
+            else if (a == "--horizon" && hasValue)
+                config.horizon = std::stoi(args[++i]);
+            else if (a == "--packing" && hasValue) {
+                if (!parseBinPacking(args[++i], config.packing))
+                    throw std::invalid_argument("unknown packing '" + args[i] + "'");
+            } else if (a == "--order" && hasValue) {
+                if (!parsePriorityOrder(args[++i], config.order))
+                    throw std::invalid_argument("unknown priority order '" + args[i] + "'");
+            } else if (a == "--trace" && hasValue) {
+                if (!parseTraceLevel(args[++i], level))
+                    throw std::invalid_argument("unknown trace level '" + args[i] + "'");
+            } else if (a == "--no-gantt")
+                gantt = false;
+            else
+                throw std::invalid_argument("unknown option '" + a + "'");
+        }
+        if (config.cores < 1) throw std::invalid_argument("--cores must be at least 1");
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n" << kUsage;
+        return 2;
+    }
+
+    try {
+        std::vector<Task> tasks;
+        readInput(tasks);
+        TextSink          traceSink(std::cout, level);
+        trace::ScopedSink scopedSink(traceSink);
+        MulticoreResult   result = runMulticore(config, tasks);
+        printMulticore(result, tasks, config, gantt, std::cout);
+    } catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+// ── Resource mode ─────────────────────────────────────────────
+int resources(const std::vector<std::string>& args) {
+    ResourceConfig config;
+    TraceLevel     level = TraceLevel::Summary;
+    bool           gantt = true;
+    try {
+        if (args.size() < 2 || !parseLockProtocol(args[1], config.protocol))
+            throw std::invalid_argument("--resources needs none, pip or ipcp");
+        for (std::size_t i = 2; i < args.size(); ++i) {
+            const std::string& a = args[i];
+            const bool hasValue  = i + 1 < args.size();
+            if (a == "--horizon" && hasValue)
+                config.horizon = std::stoi(args[++i]);
+            else if (a == "--order" && hasValue) {
+                if (!parsePriorityOrder(args[++i], config.order))
+                    throw std::invalid_argument("unknown priority order '" + args[i] + "'");
+            } else if (a == "--trace" && hasValue) {
+                if (!parseTraceLevel(args[++i], level))
+                    throw std::invalid_argument("unknown trace level '" + args[i] + "'");
+            } else if (a == "--no-gantt")
+                gantt = false;
+            else
+                throw std::invalid_argument("unknown option '" + a + "'");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n" << kUsage;
+        return 2;
+    }
+
+    try {
+        // Task and `cs` lines share the input, so read it once; a
+        // task-set file has no `cs` lines
+        std::vector<Task>            tasks;
+        std::vector<CriticalSection> sections;
+        MappedTaskSet                set;
+        if (set.map(STDIN_FILENO)) {
+            set.appendTo(tasks);
+        } else {
+            std::stringstream input;
+            input << std::cin.rdbuf();
+            readTasks(input, tasks);
+            input.clear();
+            input.seekg(0);
+            readCriticalSections(input, sections);
+        }
+
+        TextSink          traceSink(std::cout, level);
+        trace::ScopedSink scopedSink(traceSink);
+        ResourceResult    result = simulateResources(config, tasks, sections);
+        printResourceReport(result, tasks, config, gantt, std::cout);
+    } catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+// ── Job body mode ─────────────────────────────────────────────
+int bodies(const std::vector<std::string>& args) {
+    BodyConfig config;
+    TraceLevel level = TraceLevel::Summary;
+    bool       gantt = true;
+    try {
+        if (args.size() < 2 || !parseLockProtocol(args[1], config.protocol))
+            throw std::invalid_argument("--bodies needs none, pip or ipcp");
+        for (std::size_t i = 2; i < args.size(); ++i) {
+            const std::string& a = args[i];
+            const bool hasValue  = i + 1 < args.size();
+            if (a == "--horizon" && hasValue)
+                config.horizon = std::stoi(args[++i]);
+            else if (a == "--order" && hasValue) {
+                if (!parsePriorityOrder(args[++i], config.order))
+                    throw std::invalid_argument("unknown priority order '" + args[i] + "'");
+            } else if (a == "--trace" && hasValue) {
+                if (!parseTraceLevel(args[++i], level))
+                    throw std::invalid_argument("unknown trace level '" + args[i] + "'");
+            } else if (a == "--no-gantt")
+                gantt = false;
+            else
+                throw std::invalid_argument("unknown option '" + a + "'");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n" << kUsage;
+        return 2;
+    }
+
+    try {
+        // As in resource mode; a task-set file has no `body` lines,
+        // so every job computes its WCET
+        std::vector<Task>       tasks;
+        std::vector<BodyScript> scripts;
+        MappedTaskSet           set;
+        if (set.map(STDIN_FILENO)) {
+            set.appendTo(tasks);
+        } else {
+            std::stringstream input;
+            input << std::cin.rdbuf();
+            readTasks(input, tasks);
+            input.clear();
+            input.seekg(0);
+            readBodyScripts(input, scripts);
+        }
+
+        TextSink          traceSink(std::cout, level);
+        trace::ScopedSink scopedSink(traceSink);
+        BodyResult        result = simulateScripts(config, tasks, scripts);
+        printBodyReport(result, tasks, config, gantt, std::cout);
+    } catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+// ── Real execution mode ───────────────────────────────────────
+int real(const std::vector<std::string>& args) {
+    RealConfig config;
+    bool       gantt = true;
+    bool       json  = false;
+    try {
+        if (args.size() < 2 || !parseRealTimeClass(args[1], config.cls))
+            throw std::invalid_argument("--real needs fifo, deadline or other");
+        for (std::size_t i = 2; i < args.size(); ++i) {
+            const std::string& a = args[i];
+            const bool hasValue  = i + 1 < args.size();
+            if (a == "--horizon" && hasValue)
+                config.horizon = std::stoi(args[++i]);
+            else if (a == "--tick-us" && hasValue)
+                config.tickMicros = std::stoi(args[++i]);
+            else if (a == "--cpu" && hasValue)
+                config.cpu = std::stoi(args[++i]);
+            else if (a == "--order" && hasValue) {
+                if (!parsePriorityOrder(args[++i], config.order))
+                    throw std::invalid_argument("unknown priority order '" + args[i] + "'");
+            } else if (a == "--format" && hasValue) {
+                const std::string& f = args[++i];
+                if (f != "text" && f != "json")
+                    throw std::invalid_argument("--real writes text or json");
+                json = f == "json";
+            } else if (a == "--no-gantt")
+                gantt = false;
+            else
+                throw std::invalid_argument("unknown option '" + a + "'");
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n" << kUsage;
+        return 2;
+    }
+
+    try {
+        std::vector<Task> tasks;
+        readInput(tasks);
+        RealResult result = runReal(config, tasks);
+        if (json) {
+            const std::string policy = std::string("real-") + realTimeClassName(result.granted);
+            BufferedWriter    data(STDOUT_FILENO);
+            exportJson(result.schedule, policy.c_str(), data);
+            data.flush();
+            if (!result.fallback.empty()) std::cerr << result.fallback << "\n";
+        } else {
+            const std::vector<JobStats> predicted = predictReal(config, tasks, result.horizon);
+            printRealReport(result, predicted, config, gantt, std::cout);
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+// ── Generator mode ────────────────────────────────────────────
+int generate(const std::vector<std::string>& args) {
+    GeneratorConfig config;
+    bool            text = false;
+    try {
+        if (args.size() < 2) throw std::invalid_argument("--generate needs a task count");
+        config.tasks = std::stoul(args[1]);
+        for (std::size_t i = 2; i < args.size(); ++i) {
+            const std::string& a = args[i];
+            const bool hasValue  = i + 1 < args.size();
+            if      (a == "--utilization" && hasValue)  config.utilization        = std::stod(args[++i]);
+            else if (a == "--period-min" && hasValue)   config.periodMin          = std::stoi(args[++i]);
+            else if (a == "--period-max" && hasValue)   config.periodMax          = std::stoi(args[++i]);
+            else if (a == "--granularity" && hasValue)  config.granularity        = std::stoi(args[++i]);
+            else if (a == "--deadline-min" && hasValue) config.deadlineMin        = std::stod(args[++i]);
+            else if (a == "--deadline-max" && hasValue) config.deadlineMax        = std::stod(args[++i]);
+            else if (a == "--cap" && hasValue)          config.maxTaskUtilization = std::stod(args[++i]);
+            else if (a == "--seed" && hasValue)         config.seed               = std::stoull(args[++i]);
+            else if (a == "--discard")                  config.discard            = true;
+            else if (a == "--text")                     text                      = true;
+            else throw std::invalid_argument("unknown option '" + a + "'");
+        }
+        if (!text && isatty(STDOUT_FILENO))
+            throw std::invalid_argument("refusing to write a binary task set to a terminal");
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n" << kUsage;
+        return 2;
+    }
+
+    try {
+        TaskSetHeader           header;
+        std::vector<TaskRecord> records = generateTaskSet(config, header);
+        if (text) writeTaskLines(std::cout, records);
+        else      writeTaskSet(STDOUT_FILENO, header, records);
+        std::cerr << records.size() << " tasks, U = " << header.utilization
+                  << " (target " << header.targetUtilization << ")\n";
+    } catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    if (args.size() == 1 && args[0] == "--serve")
+        return serve();
+    if (!args.empty() && args[0] == "--batch")
+        return batch(args);
+    if (!args.empty() && args[0] == "--analyze")
+        return analyze(args);
+    if (!args.empty() && args[0] == "--multicore")
+        return multicore(args);
+    if (!args.empty() && args[0] == "--resources")
+        return resources(args);
+    if (!args.empty() && args[0] == "--bodies")
+        return bodies(args);
+    if (!args.empty() && args[0] == "--real")
+        return real(args);
+    if (!args.empty() && args[0] == "--generate")
+        return generate(args);
+
+    RunOptions opts;
+    try {
+        opts = parseArgs(args);
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << "\n" << kUsage;
+        return 2;
+    }
+
+    try {
+        std::vector<Task> tasks;
+        readInput(tasks);
+        std::cout.flush();
+        BufferedWriter data(STDOUT_FILENO);
+        runOnce(opts, std::move(tasks), std::cout, data, nullptr);
+    } catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,641 @@
+// Randomized cross-checks between the analyses and the simulators.
+//
+// Each check draws many small task sets from a fixed seed and
+// compares two independent ways of computing the same answer; the
+// first disagreement is printed with its task set.  Run one check by
+// name (`crosscheck rta`) or all of them with no argument; CTest
+// registers one test per check.
+#include "Analysis.h"
+#include "DemandBound.h"
+#include "Incremental.h"
+#include "Multicore.h"
+#include "ResourceManager.h"
+#include "Scheduler.h"
+#include "TaskBody.h"
+#include "TaskSet.h"
+#include "TaskTable.h"
+#include "Timeline.h"
+#include "Trace.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Rng = std::mt19937_64;
+
+int failures = 0;
+
+std::string describe(const std::vector<Task>& tasks) {
+    std::ostringstream os;
+    for (const Task& t : tasks)
+        os << "    " << t.id << " arrival=" << t.arrivalTime << " C=" << t.burstTime
+           << " T=" << t.period << " D=" << t.relativeDeadline << " hard=" << t.hardDeadline
+           << " prio=" << t.priority << "\n";
+    return os.str();
+}
+
+// Records a mismatch; returns false so a check can stop at the first.
+bool expect(bool ok, const std::string& what, const std::vector<Task>& tasks) {
+    if (ok) return true;
+    ++failures;
+    std::cerr << "  FAIL: " << what << "\n" << describe(tasks);
+    return false;
+}
+
+template <class A, class B>
+bool expectEq(const A& a, const B& b, const std::string& what, const std::vector<Task>& tasks) {
+    if (a == b) return true;
+    std::ostringstream os;
+    os << what << ": " << a << " != " << b;
+    return expect(false, os.str(), tasks);
+}
+
+int pick(Rng& rng, int lo, int hi) {
+    return std::uniform_int_distribution<int>(lo, hi)(rng);
+}
+
+// Periods from a harmonic-ish menu keep hyperperiods short.
+constexpr int kPeriods[] = {4, 5, 6, 8, 10, 12, 15, 20, 24, 30};
+
+// Synchronous periodic tasks with total utilization near `load`;
+// deadlines are implicit unless `constrained`.
+std::vector<Task> periodicSet(Rng& rng, double load, bool constrained) {
+    const int n = pick(rng, 1, 6);
+    std::vector<Task> tasks(n);
+    std::uniform_real_distribution<double> share(0.2, 1.0);
+    std::vector<double> w(n);
+    double sum = 0;
+    for (double& x : w) sum += (x = share(rng));
+    for (int i = 0; i < n; ++i) {
+        Task& t            = tasks[i];
+        t.id               = i + 1;
+        t.name             = 'T';
+        t.name            += std::to_string(i + 1);
+        t.period           = kPeriods[pick(rng, 0, (int)std::size(kPeriods) - 1)];
+        t.burstTime        = std::max(1, (int)(load * w[i] / sum * t.period + 0.5));
+        t.burstTime        = std::min(t.burstTime, t.period);
+        t.relativeDeadline = constrained ? pick(rng, t.burstTime, t.period) : t.period;
+        t.priority         = pick(rng, 0, 9);
+    }
+    return tasks;
+}
+
+std::int64_t hyperperiodOf(const std::vector<Task>& tasks) {
+    std::int64_t h = 1;
+    hyperperiod(tasks, h);
+    return h;
+}
+
+// ── Response-time analysis vs simulation ──────────────────────
+// From the critical instant, the longest response in the level-i
+// busy period is exactly the WCRT the analysis computes.  A task the
+// analysis rejects must miss in the simulation too when U <= 1 (with
+// U > 1 its job may never finish within the run).
+void checkResponseTimes() {
+    Rng rng(12);
+    int compared = 0;
+    for (int round = 0; round < 4000; ++round) {
+        std::vector<Task> tasks = periodicSet(rng, std::uniform_real_distribution<double>(0.3, 1.0)(rng),
+                                              round % 2 == 1);
+        for (PriorityOrder order : {PriorityOrder::RateMonotonic, PriorityOrder::DeadlineMonotonic,
+                                    PriorityOrder::Explicit}) {
+            SchedulabilityReport report = analyzeFixedPriority(tasks, order);
+            if (!report.exact) continue;
+            std::vector<std::int64_t> observed =
+                simulateFixedPriority(tasks, order, hyperperiodOf(tasks));
+            for (std::size_t i = 0; i < report.responses.size(); ++i) {
+                const ResponseTime& r = report.responses[i];
+                if (!r.analysed || r.upperBound) continue;
+                if (r.schedulable) {
+                    if (!expectEq(observed[i], r.wcrt, std::string(priorityOrderName(order)) +
+                                  " task " + std::to_string(r.taskId) + " observed vs WCRT", tasks))
+                        return;
+                    ++compared;
+                } else if (report.utilization <= 1) {
+                    if (!expect(observed[i] > r.deadline, "task " + std::to_string(r.taskId) +
+                                " unschedulable but the simulation met its deadline", tasks))
+                        return;
+                }
+            }
+        }
+    }
+    expect(compared > 10000, "too few response times compared", {});
+}
+
+// ── QPA vs the exhaustive demand test ─────────────────────────
+void checkDemandBound() {
+    Rng rng(13);
+    for (int round = 0; round < 20000; ++round) {
+        std::vector<Task> tasks = periodicSet(rng, std::uniform_real_distribution<double>(0.5, 1.05)(rng),
+                                              true);
+        TaskTable table(tasks);
+        DemandReport qpa        = analyzeEDF(table);
+        DemandReport exhaustive = analyzeEDFExhaustive(table);
+        if (!expectEq(qpa.schedulable, exhaustive.schedulable, "QPA vs exhaustive verdict", tasks))
+            return;
+
+        // Both kernels give the same (exact) demand
+        DemandKernel active = activeDemandKernel();
+        for (double t : {1.0, 7.0, 29.0, 120.0, 997.0}) {
+            setDemandKernel(DemandKernel::Scalar);
+            double scalar = demandBound(table, t);
+            setDemandKernel(DemandKernel::AVX2);
+            double simd = demandBound(table, t);
+            setDemandKernel(active);
+            if (!expectEq(scalar, simd, "dbf(" + std::to_string((int)t) + ") scalar vs AVX2", tasks))
+                return;
+        }
+    }
+}
+
+// ── EDF steady-state extrapolation vs --exact ─────────────────
+bool sameLatency(const LogHistogram& a, const LogHistogram& b) {
+    return a.count() == b.count() && a.min() == b.min() && a.max() == b.max() &&
+           a.percentile(50) == b.percentile(50) && a.percentile(99) == b.percentile(99);
+}
+
+void checkSteadyState() {
+    NullSink          quiet;
+    trace::ScopedSink scoped(quiet);
+    Rng rng(14);
+    int skipped = 0;
+    for (int round = 0; round < 3000; ++round) {
+        std::vector<Task> tasks = periodicSet(rng, std::uniform_real_distribution<double>(0.5, 1.3)(rng),
+                                              round % 2 == 1);
+        SchedulerConfig config;
+        config.policy  = Policy::EDF;
+        config.horizon = (int)hyperperiodOf(tasks) * pick(rng, 2, 12) + pick(rng, 0, 7);
+
+        config.steadyState = true;
+        ScheduleResult fast = runScheduler(config, tasks);
+        config.steadyState = false;
+        ScheduleResult exact = runScheduler(config, tasks);
+        if (fast.steady.cyclesSkipped > 0) ++skipped;
+
+        if (!expectEq(fast.deadlineMisses, exact.deadlineMisses, "misses", tasks) ||
+            !expectEq(fast.totalBusyTime, exact.totalBusyTime, "busy time", tasks) ||
+            !expectEq(fast.contextSwitches, exact.contextSwitches, "context switches", tasks))
+            return;
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            const JobStats& a = fast.jobs[i];
+            const JobStats& b = exact.jobs[i];
+            if (!expectEq(a.jobs, b.jobs, "jobs of task " + std::to_string(i + 1), tasks) ||
+                !expectEq(a.misses, b.misses, "misses of task " + std::to_string(i + 1), tasks) ||
+                !expectEq(a.totalResponse, b.totalResponse, "total response", tasks) ||
+                !expect(sameLatency(a.latency.response, b.latency.response) &&
+                        sameLatency(a.latency.lateness, b.latency.lateness),
+                        "latency histograms of task " + std::to_string(i + 1), tasks))
+                return;
+        }
+    }
+    expect(skipped > 1000, "steady state was hardly detected", {});
+}
+
+// ── Global EDF on one core vs the EDF scheduler ───────────────
+void checkGlobalEDF() {
+    NullSink          quiet;
+    trace::ScopedSink scoped(quiet);
+    Rng rng(15);
+    for (int round = 0; round < 3000; ++round) {
+        std::vector<Task> tasks = periodicSet(rng, std::uniform_real_distribution<double>(0.5, 1.3)(rng),
+                                              round % 2 == 1);
+        const Tick horizon = (Tick)hyperperiodOf(tasks) * 2;
+
+        SchedulerConfig edf;
+        edf.policy      = Policy::EDF;
+        edf.horizon     = horizon;
+        edf.steadyState = false;
+        ScheduleResult single = runScheduler(edf, tasks);
+
+        MulticoreConfig gedf;
+        gedf.policy  = MulticorePolicy::GlobalEDF;
+        gedf.cores   = 1;
+        gedf.horizon = horizon;
+        MulticoreResult global = runMulticore(gedf, tasks);
+
+        if (!expectEq(global.deadlineMisses, single.deadlineMisses, "misses", tasks) ||
+            !expectEq((long long)global.busy[0], (long long)single.totalBusyTime, "busy time", tasks))
+            return;
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            const std::string task = " of task " + std::to_string(i + 1);
+            if (!expectEq((long long)global.tasks[i].jobs, (long long)single.jobs[i].jobs,
+                          "jobs" + task, tasks) ||
+                !expectEq((long long)global.tasks[i].worstResponse,
+                          (long long)single.jobs[i].worstResponse, "worst response" + task, tasks) ||
+                !expect(sameLatency(global.tasks[i].latency.response, single.jobs[i].latency.response),
+                        "response histogram" + task, tasks))
+                return;
+        }
+    }
+}
+
+// ── Measured blocking vs the analytical bound ─────────────────
+void checkBlocking() {
+    NullSink          quiet;
+    trace::ScopedSink scoped(quiet);
+    Rng rng(16);
+    int checked = 0;
+    int blocked = 0;   // Sets where some job did wait
+    for (int round = 0; round < 4000; ++round) {
+        std::vector<Task> tasks = periodicSet(rng, std::uniform_real_distribution<double>(0.3, 0.8)(rng),
+                                              false);
+        for (Task& t : tasks) t.burstTime = std::max(t.burstTime, std::min(t.period, 3));
+
+        // Per task: no section, one, two in a row, or one nested in
+        // another, on three resources
+        std::vector<CriticalSection> sections;
+        for (const Task& t : tasks) {
+            const int C = t.burstTime;
+            auto add = [&](int resource, int offset, int length) {
+                sections.push_back(CriticalSection{t.id, resource, offset, length});
+            };
+            const int r = pick(rng, 0, 2);
+            switch (pick(rng, 0, 3)) {
+            case 0: break;
+            case 1: {
+                int offset = pick(rng, 0, C - 1);
+                add(r, offset, pick(rng, 1, C - offset));
+                break;
+            }
+            case 2: {   // [0, split) and [split, C) at most
+                int split = pick(rng, 1, C - 1);
+                add(r, pick(rng, 0, split - 1), 1);
+                add((r + 1) % 3, split, pick(rng, 1, C - split));
+                break;
+            }
+            case 3: {   // Outer [offset, C), inner strictly inside it;
+                        // nesting follows resource order, so PIP cannot deadlock
+                int outer  = std::min(r, 1);
+                int offset = pick(rng, 0, C - 2);
+                add(outer, offset, C - offset);
+                int inner = pick(rng, offset + 1, C - 1);
+                add(pick(rng, outer + 1, 2), inner, pick(rng, 1, C - inner));
+                break;
+            }
+            }
+        }
+
+        for (LockProtocol protocol : {LockProtocol::Inheritance, LockProtocol::ImmediateCeiling}) {
+            ResourceConfig config;
+            config.protocol = protocol;
+            config.horizon  = (Tick)hyperperiodOf(tasks);
+            ResourceResult res = simulateResources(config, tasks, sections);
+            if (res.deadlineMisses > 0) continue;   // The bounds assume no backlog
+            std::vector<std::int64_t> bound =
+                blockingBounds(tasks, sections, protocol, config.order);
+            ++checked;
+            if (res.blocks > 0) ++blocked;
+            for (std::size_t i = 0; i < tasks.size(); ++i) {
+                if (!expect(res.tasks[i].worstBlocking <= bound[i],
+                            std::string(lockProtocolName(protocol)) + " task " +
+                            std::to_string(i + 1) + " blocked " +
+                            std::to_string(res.tasks[i].worstBlocking) + " > bound " +
+                            std::to_string(bound[i]), tasks))
+                    return;
+            }
+        }
+    }
+    expect(checked > 1000 && blocked > 100, "too few sets with blocking to check", {});
+}
+
+// ── Incremental edit vs a full run ────────────────────────────
+std::vector<Task> aperiodicSet(Rng& rng) {
+    const int n = pick(rng, 1, 8);
+    std::vector<Task> tasks(n);
+    for (int i = 0; i < n; ++i) {
+        Task& t        = tasks[i];
+        t.id           = i + 1;
+        t.name         = 'T';
+        t.name        += std::to_string(i + 1);
+        t.arrivalTime  = pick(rng, 0, 20);
+        t.burstTime    = pick(rng, 1, 9);
+        t.priority     = pick(rng, 0, 5);
+        t.hardDeadline = pick(rng, 0, 1) ? t.arrivalTime + pick(rng, t.burstTime, 30) : 0;
+    }
+    return tasks;
+}
+
+bool sameSchedule(const ScheduleResult& a, const ScheduleResult& b) {
+    if (a.gantt.size() != b.gantt.size()) return false;
+    for (std::size_t i = 0; i < a.gantt.size(); ++i)
+        if (a.gantt[i].task != b.gantt[i].task || a.gantt[i].start != b.gantt[i].start ||
+            a.gantt[i].end != b.gantt[i].end)
+            return false;
+    if (a.tasks.size() != b.tasks.size()) return false;
+    for (std::size_t i = 0; i < a.tasks.size(); ++i) {
+        const Task& x = a.tasks[i];
+        const Task& y = b.tasks[i];
+        if (x.id != y.id || x.name != y.name || x.completionTime != y.completionTime ||
+            x.startTime != y.startTime || x.waitingTime != y.waitingTime ||
+            x.deadlineMissed != y.deadlineMissed)
+            return false;
+    }
+    return a.totalClockTime == b.totalClockTime && a.totalBusyTime == b.totalBusyTime &&
+           a.contextSwitches == b.contextSwitches && a.deadlineMisses == b.deadlineMisses &&
+           sameLatency(a.latency.response, b.latency.response);
+}
+
+void checkIncremental() {
+    NullSink          quiet;
+    trace::ScopedSink scoped(quiet);
+    Rng rng(17);
+    int partial = 0;
+    for (int round = 0; round < 6000; ++round) {
+        SchedulerConfig config;
+        config.policy    = round % 2 ? Policy::RoundRobin : Policy::FCFS;
+        config.quantum   = pick(rng, 1, 4);
+        config.csPenalty = pick(rng, 0, 2);
+
+        std::vector<Task> tasks = aperiodicSet(rng);
+        IncrementalScheduler incremental;
+        incremental.run(config, tasks);
+
+        // One edit: arrival, burst, priority, name or deadline
+        Task& t = tasks[pick(rng, 0, (int)tasks.size() - 1)];
+        switch (pick(rng, 0, 4)) {
+        case 0: t.arrivalTime  = pick(rng, 0, 20);           break;
+        case 1: t.burstTime    = pick(rng, 1, 9);            break;
+        case 2: t.priority     = pick(rng, 0, 5);            break;
+        case 3: t.name        += 'x';                        break;
+        case 4: t.hardDeadline = t.arrivalTime + pick(rng, 1, 30); break;
+        }
+        const ScheduleResult& edited = incremental.run(config, tasks);
+        if (incremental.resumedAt() != 0) ++partial;
+        if (!expect(sameSchedule(edited, runScheduler(config, tasks)),
+                    std::string(policyName(config.policy)) + " incremental run (resumed at " +
+                    std::to_string(incremental.resumedAt()) + ") differs from a full run",
+                    tasks))
+            return;
+    }
+    expect(partial > 1000, "the incremental path was hardly taken", {});
+}
+
+// ── Timeline windows vs the clipped full run ──────────────────
+// Segments of [from, to), cut at the bounds, with abutting pieces of
+// one task joined: a window and the full run may split a slice at
+// different ticks.
+std::vector<Segment> clip(const SegmentTrace& trace, Tick from, Tick to) {
+    std::vector<Segment> out;
+    for (const Segment& s : trace) {
+        const Tick start = std::max(s.start, from);
+        const Tick end   = std::min(s.end, to);
+        if (start >= end) continue;
+        if (!out.empty() && out.back().task == s.task && out.back().end == start)
+            out.back().end = end;
+        else
+            out.push_back({s.task, start, end});
+    }
+    return out;
+}
+
+bool sameSegments(const std::vector<Segment>& a, const std::vector<Segment>& b) {
+    return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const Segment& x, const Segment& y) {
+        return x.task == y.task && x.start == y.start && x.end == y.end;
+    });
+}
+
+int busyIn(const std::vector<Segment>& segments) {
+    int busy = 0;
+    for (const Segment& s : segments)
+        if (s.task >= 0) busy += s.length();
+    return busy;
+}
+
+void checkWindows() {
+    NullSink          quiet;
+    trace::ScopedSink scoped(quiet);
+    Rng rng(18);
+    for (int round = 0; round < 1500; ++round) {
+        std::vector<Task> tasks = periodicSet(rng, std::uniform_real_distribution<double>(0.5, 1.3)(rng),
+                                              round % 2 == 1);
+        SchedulerConfig config;
+        config.policy      = Policy::EDF;
+        config.horizon     = (int)hyperperiodOf(tasks) * pick(rng, 1, 8) + pick(rng, 0, 7);
+        config.steadyState = false;
+        const ScheduleResult full = runScheduler(config, tasks);
+
+        for (bool exact : {true, false}) {
+            config.steadyState = !exact;
+            const std::string mode = exact ? " (--exact)" : "";
+            Timeline timeline(config, tasks, pick(rng, 1, config.horizon));
+
+            ScheduleResult all = timeline.window(0, config.horizon);
+            if (!expectEq(all.deadlineMisses, full.deadlineMisses, "whole-run misses" + mode, tasks) ||
+                !expectEq(all.latency.response.count(), full.latency.response.count(),
+                          "whole-run jobs" + mode, tasks))
+                return;
+
+            for (int w = 0; w < 8; ++w) {
+                const Tick from = pick(rng, 0, config.horizon - 1);
+                const Tick to   = pick(rng, from + 1, config.horizon);
+                const std::string range = " of [" + std::to_string(from) + ", " +
+                                          std::to_string(to) + ")" + mode;
+                ScheduleResult       part     = timeline.window(from, to);
+                std::vector<Segment> expected = clip(full.gantt, from, to);
+                if (!expect(sameSegments(clip(part.gantt, from, to), expected),
+                            "segments" + range, tasks) ||
+                    !expectEq(part.totalBusyTime, busyIn(expected), "busy time" + range, tasks) ||
+                    !expectEq(part.totalClockTime, to - from, "window length" + range, tasks))
+                    return;
+            }
+        }
+    }
+}
+
+// ── Generator and task-set file round trip ────────────────────
+struct FileCloser {
+    void operator()(std::FILE* f) const { std::fclose(f); }
+};
+
+void checkGenerator() {
+    Rng rng(19);
+    std::uniform_real_distribution<double> real(0.0, 1.0);
+    int generated = 0;
+    for (int round = 0; round < 400; ++round) {
+        GeneratorConfig config;
+        config.tasks       = (std::size_t)pick(rng, 1, 300);
+        config.utilization = 0.05 + 1.95 * real(rng);
+        config.granularity = pick(rng, 0, 1) ? 1 : pick(rng, 2, 10);
+        config.periodMin   = config.granularity * pick(rng, 1, 20);
+        config.periodMax   = config.periodMin * pick(rng, 1, 1000);
+        config.deadlineMin = 0.3 + 0.7 * real(rng);
+        config.deadlineMax = config.deadlineMin + 0.5 * real(rng);
+        config.seed        = rng();
+
+        TaskSetHeader           header;
+        std::vector<TaskRecord> records;
+        try {
+            records = generateTaskSet(config, header);
+        } catch (const std::exception&) {
+            continue;   // No set fits these parameters
+        }
+        ++generated;
+        std::vector<Task> tasks;
+        for (const TaskRecord& r : records) tasks.push_back(toTask(r));
+
+        double u = 0;
+        for (std::size_t i = 0; i < records.size(); ++i) {
+            const TaskRecord& r = records[i];
+            if (!expectEq(r.id, (std::int32_t)(i + 1), "record id", tasks) ||
+                !expect(r.burstTime >= 1 && r.relativeDeadline >= r.burstTime,
+                        "task " + std::to_string(r.id) + " WCET or deadline out of range", tasks) ||
+                !expect(r.period >= config.periodMin && r.period <= config.periodMax &&
+                        r.period % config.granularity == 0,
+                        "task " + std::to_string(r.id) + " period off the grid", tasks))
+                return;
+            u += (double)r.burstTime / r.period;
+        }
+        if (!expect(std::abs(u - header.utilization) < 1e-9, "header utilization", tasks) ||
+            !expect(std::abs(u - config.utilization) <= 0.01 * config.utilization,
+                    "utilization " + std::to_string(u) + " vs target " +
+                    std::to_string(config.utilization), tasks))
+            return;
+
+        // Write, map back and compare field by field
+        std::unique_ptr<std::FILE, FileCloser> file(std::tmpfile());
+        if (!expect(file != nullptr, "no temporary file", {})) return;
+        writeTaskSet(fileno(file.get()), header, records);
+        MappedTaskSet mapped;
+        if (!expect(mapped.map(fileno(file.get())), "written set does not map", tasks) ||
+            !expect(std::memcmp(&mapped.header(), &header, sizeof header) == 0,
+                    "header differs after the round trip", tasks) ||
+            !expectEq(mapped.size(), records.size(), "record count", tasks))
+            return;
+        std::vector<Task> loaded;
+        mapped.appendTo(loaded);
+        for (std::size_t i = 0; i < records.size(); ++i) {
+            const TaskRecord& a = records[i];
+            const TaskRecord& b = mapped[i];
+            const Task&       t = loaded[i];
+            const std::string task = " of task " + std::to_string(a.id);
+            if (!expectEq(b.id, a.id, "id" + task, tasks) ||
+                !expectEq(b.arrivalTime, a.arrivalTime, "arrival" + task, tasks) ||
+                !expectEq(b.burstTime, a.burstTime, "WCET" + task, tasks) ||
+                !expectEq(b.priority, a.priority, "priority" + task, tasks) ||
+                !expectEq(b.period, a.period, "period" + task, tasks) ||
+                !expectEq(b.relativeDeadline, a.relativeDeadline, "deadline" + task, tasks) ||
+                !expectEq(b.hardDeadline, a.hardDeadline, "hard deadline" + task, tasks) ||
+                !expectEq(t.id, a.id, "loaded id" + task, tasks) ||
+                !expectEq(t.name, "T" + std::to_string(a.id), "loaded name" + task, tasks) ||
+                !expectEq(t.burstTime, a.burstTime, "loaded WCET" + task, tasks) ||
+                !expectEq(t.period, a.period, "loaded period" + task, tasks) ||
+                !expectEq(t.relativeDeadline, a.relativeDeadline, "loaded deadline" + task, tasks))
+                return;
+        }
+    }
+    expect(generated > 300, "too few parameter sets generated", {});
+}
+
+// ── Trivial job bodies vs the plain fixed-priority simulator ───
+// simulateBodies() is fixed-priority like simulateResources(), so a
+// body that only computes its WCET, in pieces, must reproduce a run
+// with no critical sections.
+JobBody splitCompute(Tick first, Tick second) {
+    co_await body::compute(first);
+    co_await body::compute(0);
+    co_await body::compute(second);
+}
+
+void checkBodies() {
+    NullSink          quiet;
+    trace::ScopedSink scoped(quiet);
+    Rng rng(20);
+    FramePool&  pool     = FramePool::local();
+    std::size_t peak     = 0;   // Most frames any run so far held
+    std::size_t reserved = 0;   // pool.reserved() after that run
+    for (int round = 0; round < 3000; ++round) {
+        std::vector<Task> tasks = periodicSet(rng, std::uniform_real_distribution<double>(0.3, 1.2)(rng),
+                                              round % 2 == 1);
+        constexpr PriorityOrder kOrders[] = {PriorityOrder::RateMonotonic,
+                                             PriorityOrder::DeadlineMonotonic,
+                                             PriorityOrder::Explicit};
+        const PriorityOrder order   = kOrders[pick(rng, 0, 2)];
+        const Tick          horizon = (Tick)hyperperiodOf(tasks) * pick(rng, 1, 3);
+
+        ResourceConfig plain;
+        plain.order   = order;
+        plain.horizon = horizon;
+        ResourceResult expected = simulateResources(plain, tasks, {});
+
+        std::vector<Tick> split(tasks.size());
+        for (std::size_t i = 0; i < tasks.size(); ++i) split[i] = pick(rng, 0, tasks[i].burstTime);
+        BodyConfig config;
+        config.order   = order;
+        config.horizon = horizon;
+        BodyResult res = simulateBodies(config, tasks, std::vector<std::vector<int>>(tasks.size()),
+                                        [&](int task, std::int64_t) {
+                                            return splitCompute(split[task],
+                                                                tasks[task].burstTime - split[task]);
+                                        });
+
+        if (!expect(sameSegments(clip(res.gantt, 0, horizon), clip(expected.gantt, 0, horizon)),
+                    std::string(priorityOrderName(order)) + " schedule differs", tasks) ||
+            !expectEq(res.deadlineMisses, expected.deadlineMisses, "misses", tasks))
+            return;
+        for (std::size_t i = 0; i < tasks.size(); ++i) {
+            const std::string task = " of task " + std::to_string(i + 1);
+            if (!expectEq(res.tasks[i].jobs, expected.tasks[i].jobs, "jobs" + task, tasks) ||
+                !expectEq(res.tasks[i].worstResponse, expected.tasks[i].worstResponse,
+                          "worst response" + task, tasks))
+                return;
+        }
+
+        // Every frame went back, and a run no bigger than an earlier
+        // one took no new memory from the system
+        if (!expectEq(pool.live(), (std::size_t)0, "frames still live", tasks) ||
+            !expectEq(res.frameBytes, pool.reserved(), "reported frame bytes", tasks))
+            return;
+        if (res.peakFrames <= peak) {
+            if (!expectEq(pool.reserved(), reserved, "pool grew for a smaller run", tasks))
+                return;
+        } else {
+            peak     = res.peakFrames;
+            reserved = pool.reserved();
+        }
+    }
+}
+
+struct Check {
+    const char*           name;
+    std::function<void()> run;
+};
+
+const Check kChecks[] = {
+    {"rta",         checkResponseTimes},
+    {"qpa",         checkDemandBound},
+    {"steady",      checkSteadyState},
+    {"gedf",        checkGlobalEDF},
+    {"blocking",    checkBlocking},
+    {"incremental", checkIncremental},
+    {"window",      checkWindows},
+    {"generator",   checkGenerator},
+    {"bodies",      checkBodies},
+};
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool found = false;
+    for (const Check& c : kChecks) {
+        if (argc > 1 && std::strcmp(argv[1], c.name) != 0) continue;
+        found = true;
+        const int before = failures;
+        c.run();
+        std::cout << (failures == before ? "ok    " : "FAIL  ") << c.name << "\n";
+    }
+    if (!found) {
+        std::cerr << "unknown check '" << argv[1] << "'\n";
+        return 2;
+    }
+    return failures == 0 ? 0 : 1;
+}